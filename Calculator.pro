@@ -1,7 +1,7 @@
 # Qt项目配置
 QT += core gui widgets
 
-CONFIG += c++11
+CONFIG += c++14
 CONFIG += warn_on
 CONFIG += debug_and_release
 
@@ -10,27 +10,33 @@ TARGET = Calculator
 TEMPLATE = app
 VERSION = 1.0.0
 
+# 计算核心与工具模块
+include(core.pri)
+
+# 编译期生成的界面主题
+include(themes.pri)
+
 # 源代码路径
 SOURCES += \
     src/main.cpp \
-    src/core/CalculatorEngine.cpp \
     src/ui/MainWindow.cpp \
     src/ui/NumPadButton.cpp \
     src/ui/DisplayPanel.cpp \
-    src/utils/SettingsManager.cpp
+    src/ui/DisplayUpdateCoalescer.cpp \
+    src/ui/HistoryListModel.cpp \
+    src/ui/KeyDispatchTable.cpp \
+    src/utils/StartupProfiler.cpp
 
 # 头文件路径
 HEADERS += \
-    inc/core/CalculatorEngine.h \
-    inc/core/CalculationTypes.h \
     inc/ui/MainWindow.h \
     inc/ui/NumPadButton.h \
     inc/ui/DisplayPanel.h \
-    inc/utils/Constants.h \
-    inc/utils/SettingsManager.h
-
-# 资源文件
-RESOURCES += calculator.qrc
+    inc/ui/DisplayUpdateCoalescer.h \
+    inc/ui/HistoryListModel.h \
+    inc/ui/KeyDispatchTable.h \
+    inc/ui/ButtonTable.h \
+    inc/utils/StartupProfiler.h
 
 # 编译目录设置
 win32:CONFIG(release, debug|release) {
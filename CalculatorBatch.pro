@@ -0,0 +1,61 @@
+# 无界面批处理项目配置（不链接 Qt GUI/Widgets）
+QT = core
+
+CONFIG += c++14
+CONFIG += console
+CONFIG += thread
+CONFIG -= app_bundle
+CONFIG += warn_on
+
+# 项目信息
+TARGET = CalculatorBatch
+TEMPLATE = app
+VERSION = 1.0.0
+
+# 计算核心与工具模块
+include(core.pri)
+
+# 源代码路径
+SOURCES += \
+    src/batch/main.cpp \
+    src/batch/BatchRunner.cpp \
+    src/batch/ParallelBatchEvaluator.cpp
+
+# 头文件路径
+HEADERS += \
+    inc/batch/BatchRunner.h \
+    inc/batch/ParallelBatchEvaluator.h
+
+# 多会话引擎服务（epoll 与 eventfd 仅 Linux 提供）
+linux {
+    DEFINES += CALCULATOR_HAS_SERVER
+
+    SOURCES += \
+        src/server/EngineServer.cpp
+
+    HEADERS += \
+        inc/server/EngineServer.h \
+        inc/server/ServerProtocol.h
+}
+
+# 编译目录设置
+win32:CONFIG(release, debug|release) {
+    DESTDIR = build/release
+    OBJECTS_DIR = build/release/batch/obj
+    MOC_DIR = build/release/batch/moc
+} else:win32:CONFIG(debug, debug|release) {
+    DESTDIR = build/debug
+    OBJECTS_DIR = build/debug/batch/obj
+    MOC_DIR = build/debug/batch/moc
+}
+
+unix {
+    DESTDIR = build
+    OBJECTS_DIR = build/batch/obj
+    MOC_DIR = build/batch/moc
+}
+
+# 编译选项
+QMAKE_CXXFLAGS += -Wall -Wextra -Wpedantic
+QMAKE_CXXFLAGS_RELEASE -= -O2
+QMAKE_CXXFLAGS_RELEASE += -O3
@@ -0,0 +1,22 @@
+# 基准测试公共配置
+QT = core testlib
+
+CONFIG += c++14
+CONFIG += console
+CONFIG -= app_bundle
+CONFIG += warn_on
+
+# 计算核心与工具模块
+include($$PWD/../core.pri)
+
+# 吞吐率输出（各基准共用）
+HEADERS += $$PWD/common/BenchmarkReport.h
+SOURCES += $$PWD/common/BenchmarkReport.cpp
+
+DESTDIR = $$OUT_PWD
+OBJECTS_DIR = $$OUT_PWD/obj
+MOC_DIR = $$OUT_PWD/moc
+
+QMAKE_CXXFLAGS += -Wall -Wextra -Wpedantic
+QMAKE_CXXFLAGS_RELEASE -= -O2
+QMAKE_CXXFLAGS_RELEASE += -O3
@@ -0,0 +1,13 @@
+# 性能基准测试（与主程序分开构建）
+TEMPLATE = subdirs
+
+SUBDIRS += \
+    decimal \
+    engine \
+    expression \
+    history \
+    keydispatch \
+    theme
+
+# 引擎服务依赖 epoll
+linux: SUBDIRS += server
@@ -0,0 +1,98 @@
+/**
+ * @file AllocationCounter.cpp
+ * @brief 基准测试用的堆分配计数实现
+ */
+
+#include "AllocationCounter.h"
+#include <QtGlobal>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+// 常量初始化，保证在任何静态构造函数分配内存之前可用
+std::atomic<std::uint64_t> g_allocations(0);
+
+inline void countAllocation() {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace
+
+#if defined(__GLIBC__)
+
+// 转发到 glibc 内部实现，operator new 与 Qt 的分配都会经过这里
+extern "C" {
+
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *pointer, size_t size);
+void __libc_free(void *pointer);
+
+void *malloc(size_t size) noexcept {
+    countAllocation();
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size) noexcept {
+    countAllocation();
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *pointer, size_t size) noexcept {
+    countAllocation();
+    return __libc_realloc(pointer, size);
+}
+
+void free(void *pointer) noexcept {
+    __libc_free(pointer);
+}
+
+} // extern "C"
+
+#else
+
+void *operator new(std::size_t size) {
+    countAllocation();
+    if (void *pointer = std::malloc(size ? size : 1)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+
+void operator delete(void *pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer) noexcept {
+    std::free(pointer);
+}
+
+#endif
+
+namespace AllocationCounter {
+
+std::uint64_t allocations() {
+    return g_allocations.load(std::memory_order_relaxed);
+}
+
+bool coversMalloc() {
+#if defined(__GLIBC__)
+    return true;
+#else
+    return false;
+#endif
+}
+
+void reportCoverage() {
+    if (!coversMalloc()) {
+        qDebug("allocation counts cover operator new only on this platform");
+    }
+}
+
+} // namespace AllocationCounter
@@ -0,0 +1,32 @@
+/**
+ * @file AllocationCounter.h
+ * @brief 基准测试用的堆分配计数
+ * @author Jisq
+ * @version 1.0
+ * @date 2025
+ */
+
+#ifndef ALLOCATIONCOUNTER_H
+#define ALLOCATIONCOUNTER_H
+
+#include <cstdint>
+
+namespace AllocationCounter {
+
+/**
+ * 进程启动以来的堆分配次数。
+ * glibc 下替换 malloc/calloc/realloc，可以统计到 Qt 容器（QString、QByteArray
+ * 直接调用 malloc）的分配；其他平台只替换全局 operator new。
+ * 链接本模块的可执行文件中所有分配都会计数，请在被测循环前后各取一次做差。
+ */
+std::uint64_t allocations();
+
+// 计数是否覆盖 malloc（为 false 时只统计 operator new）
+bool coversMalloc();
+
+// 计数不覆盖 malloc 时输出提示，在 initTestCase() 中调用
+void reportCoverage();
+
+} // namespace AllocationCounter
+
+#endif // ALLOCATIONCOUNTER_H
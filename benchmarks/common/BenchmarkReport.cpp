@@ -0,0 +1,22 @@
+/**
+ * @file BenchmarkReport.cpp
+ * @brief 基准测试的吞吐率输出实现
+ */
+
+#include "BenchmarkReport.h"
+
+namespace BenchmarkReport {
+
+void reportRate(const char *name, const char *unit, qint64 count, qint64 elapsedNs,
+                qint64 allocations) {
+    const double seconds = elapsedNs / 1e9;
+    const double nsPerUnit = static_cast<double>(elapsedNs) / count;
+    if (allocations < 0) {
+        qDebug("%s: %.0f %ss/s, %.1f ns/%s", name, count / seconds, unit, nsPerUnit, unit);
+    } else {
+        qDebug("%s: %.0f %ss/s, %.1f ns/%s, %.3f allocations/%s", name, count / seconds, unit,
+               nsPerUnit, unit, static_cast<double>(allocations) / count, unit);
+    }
+}
+
+} // namespace BenchmarkReport
@@ -0,0 +1,27 @@
+/**
+ * @file BenchmarkReport.h
+ * @brief 基准测试的吞吐率输出
+ * @author Jisq
+ * @version 1.0
+ * @date 2025
+ */
+
+#ifndef BENCHMARKREPORT_H
+#define BENCHMARKREPORT_H
+
+#include <QtGlobal>
+
+namespace BenchmarkReport {
+
+/**
+ * 输出每秒次数与每次耗时，便于与 QBENCHMARK 的每迭代耗时对照，例如
+ * "table: 1234567 events/s, 810.0 ns/event, 0.000 allocations/event"。
+ * unit 为单数的计数单位（"op"、"event" 等）；allocations 为负时不输出分配次数，
+ * 否则为被测循环前后 AllocationCounter::allocations() 之差。
+ */
+void reportRate(const char *name, const char *unit, qint64 count, qint64 elapsedNs,
+                qint64 allocations = -1);
+
+} // namespace BenchmarkReport
+
+#endif // BENCHMARKREPORT_H
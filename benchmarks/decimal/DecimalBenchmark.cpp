@@ -0,0 +1,193 @@
+/**
+ * @file DecimalBenchmark.cpp
+ * @brief 十进制定点数基准测试
+ *
+ * 对同一组操作数做 CHAIN_LENGTH 步的加 / 乘 / 除链式运算，比较：
+ *   - 双精度：applyOperator（与引擎双精度路径相同的溢出与除零检查）
+ *   - 十进制：Decimal128（scale = 10，四舍六入五成双）
+ * 另外用按键引擎分别在两种后端上重放 "12.5*1.07+0.1=" 测量端到端开销。
+ */
+
+#include "core/Arithmetic.h"
+#include "core/CalculatorEngine.h"
+#include "core/Decimal128.h"
+#include "core/KeystrokeReplay.h"
+#include "../common/BenchmarkReport.h"
+#include <QElapsedTimer>
+#include <QtTest>
+#include <cstring>
+#include <vector>
+
+using namespace Calculator;
+
+namespace {
+
+const int CHAIN_LENGTH = 100000;
+const int KEYSTROKE_REPEATS = 10000;
+const char KEYSTROKES[] = "12.5*1.07+0.1=";
+
+// 链式运算的操作数（乘除时两两互为倒数，累积值保持在 1 附近）
+const char *const ADD_OPERANDS[] = { "0.1", "0.2", "1.25", "3.75" };
+const char *const SCALE_OPERANDS[] = { "1.25", "0.8", "1.6", "0.625" };
+const int OPERAND_COUNT = 4;
+
+const char *operatorName(Operator op) {
+    switch (op) {
+    case Operator::Add:
+        return "add";
+    case Operator::Multiply:
+        return "multiply";
+    default:
+        return "divide";
+    }
+}
+
+} // namespace
+
+class DecimalBenchmark : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void doubleChain_data();
+    void doubleChain();
+    void decimalChain_data();
+    void decimalChain();
+    void engineKeystrokes_data();
+    void engineKeystrokes();
+
+private:
+    void addOperatorRows();
+    const char *const *operandsFor(Operator op) const;
+
+private:
+    DecimalContext m_context;
+};
+
+void DecimalBenchmark::initTestCase() {
+    // 十进制后端没有二进制浮点的表示误差
+    Decimal128 a, b, sum;
+    QVERIFY(Decimal128::parse("0.1", 3, m_context, a));
+    QVERIFY(Decimal128::parse("0.2", 3, m_context, b));
+    QCOMPARE(Decimal128::add(a, b, sum), ErrorType::NoError);
+    QCOMPARE(QString::fromStdString(sum.toString(m_context.scale)), QString("0.3"));
+
+    CalculatorEngine engine;
+    engine.blockSignals(true);
+    engine.setNumericBackend(NumericBackendType::Decimal);
+    replayKeystrokes(engine, "0.1+0.2=", 8);
+    QCOMPARE(engine.getDisplayText(), QString("0.3"));
+}
+
+void DecimalBenchmark::addOperatorRows() {
+    QTest::addColumn<Operator>("op");
+    QTest::newRow("add") << Operator::Add;
+    QTest::newRow("multiply") << Operator::Multiply;
+    QTest::newRow("divide") << Operator::Divide;
+}
+
+const char *const *DecimalBenchmark::operandsFor(Operator op) const {
+    return op == Operator::Add ? ADD_OPERANDS : SCALE_OPERANDS;
+}
+
+void DecimalBenchmark::doubleChain_data() {
+    addOperatorRows();
+}
+
+void DecimalBenchmark::doubleChain() {
+    QFETCH(Operator, op);
+    const char *const *texts = operandsFor(op);
+    double operands[OPERAND_COUNT];
+    for (int i = 0; i < OPERAND_COUNT; ++i) {
+        operands[i] = QByteArray(texts[i]).toDouble();
+    }
+
+    QElapsedTimer timer;
+    qint64 operations = 0;
+    double accumulator = 1.0;
+    timer.start();
+    QBENCHMARK {
+        accumulator = 1.0;
+        for (int i = 0; i < CHAIN_LENGTH; ++i) {
+            ErrorType error = ErrorType::NoError;
+            accumulator = applyOperator(op, accumulator, operands[i % OPERAND_COUNT], error);
+        }
+        operations += CHAIN_LENGTH;
+    }
+    BenchmarkReport::reportRate(QByteArray("double ").append(operatorName(op)).constData(),
+                                "operation", operations, timer.nsecsElapsed());
+    QVERIFY(accumulator > 0.0);
+}
+
+void DecimalBenchmark::decimalChain_data() {
+    addOperatorRows();
+}
+
+void DecimalBenchmark::decimalChain() {
+    QFETCH(Operator, op);
+    const char *const *texts = operandsFor(op);
+    Decimal128 operands[OPERAND_COUNT];
+    for (int i = 0; i < OPERAND_COUNT; ++i) {
+        QVERIFY(Decimal128::parse(texts[i], static_cast<int>(std::strlen(texts[i])),
+                                  m_context, operands[i]));
+    }
+    const Decimal128 one = Decimal128::fromInteger(1, m_context);
+
+    QElapsedTimer timer;
+    qint64 operations = 0;
+    Decimal128 accumulator = one;
+    timer.start();
+    QBENCHMARK {
+        accumulator = one;
+        for (int i = 0; i < CHAIN_LENGTH; ++i) {
+            const Decimal128 &operand = operands[i % OPERAND_COUNT];
+            switch (op) {
+            case Operator::Add:
+                Decimal128::add(accumulator, operand, accumulator);
+                break;
+            case Operator::Multiply:
+                Decimal128::multiply(accumulator, operand, m_context, accumulator);
+                break;
+            default:
+                Decimal128::divide(accumulator, operand, m_context, accumulator);
+                break;
+            }
+        }
+        operations += CHAIN_LENGTH;
+    }
+    BenchmarkReport::reportRate(QByteArray("decimal ").append(operatorName(op)).constData(),
+                                "operation", operations, timer.nsecsElapsed());
+    QVERIFY(!accumulator.isNegative() && !accumulator.isZero());
+}
+
+void DecimalBenchmark::engineKeystrokes_data() {
+    QTest::addColumn<int>("backend");
+    QTest::newRow("double") << static_cast<int>(NumericBackendType::Double);
+    QTest::newRow("decimal") << static_cast<int>(NumericBackendType::Decimal);
+}
+
+void DecimalBenchmark::engineKeystrokes() {
+    QFETCH(int, backend);
+    CalculatorEngine engine;
+    engine.blockSignals(true);
+    engine.setNumericBackend(static_cast<NumericBackendType>(backend));
+    const int length = static_cast<int>(std::strlen(KEYSTROKES));
+
+    QElapsedTimer timer;
+    qint64 evaluations = 0;
+    timer.start();
+    QBENCHMARK {
+        for (int i = 0; i < KEYSTROKE_REPEATS; ++i) {
+            engine.clearAll();
+            replayKeystrokes(engine, KEYSTROKES, length);
+        }
+        evaluations += KEYSTROKE_REPEATS;
+    }
+    BenchmarkReport::reportRate(backend == static_cast<int>(NumericBackendType::Double) ? "engine double" : "engine decimal",
+                                "operation", evaluations, timer.nsecsElapsed());
+    QCOMPARE(engine.getDisplayText(), QString("13.475"));
+}
+
+QTEST_MAIN(DecimalBenchmark)
+
+#include "DecimalBenchmark.moc"
@@ -0,0 +1,7 @@
+# 十进制定点数基准：Decimal128 与双精度的加/乘/除链
+include(../benchmarks.pri)
+
+TARGET = bench_decimal
+
+SOURCES += \
+    DecimalBenchmark.cpp
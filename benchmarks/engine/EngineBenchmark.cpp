@@ -0,0 +1,265 @@
+/**
+ * @file EngineBenchmark.cpp
+ * @brief 按键引擎吞吐基准测试
+ *
+ * 在对任何引擎或显示路径的优化下结论之前，先建立基线：
+ *   - keystrokes：按单一操作为主的按键模式（inputDigit、inputOperator、
+ *     inputEquals、backspace、changeSign）逐键重放
+ *   - traces：典型手工会话与固定种子的随机按键序列，分别在信号屏蔽
+ *     （无界面批处理）与连接显示接收者（界面路径）两种情况下重放
+ *   - formatNumber：结果格式化，比较 QString 接口与 NumberFormatter 缓冲区接口
+ * 每项输出 ops/s、ns/op 以及每次操作的堆分配次数。
+ */
+
+#include "core/CalculatorEngine.h"
+#include "core/KeystrokeReplay.h"
+#include "utils/NumberFormatter.h"
+#include "../common/AllocationCounter.h"
+#include "../common/BenchmarkReport.h"
+#include <QElapsedTimer>
+#include <QtTest>
+#include <random>
+
+using namespace Calculator;
+
+namespace {
+
+const int PATTERN_REPEATS = 20000;
+const int RANDOM_TRACE_LENGTH = 200000;
+const quint32 RANDOM_TRACE_SEED = 20250101u;
+const int FORMAT_REPEATS = 100000;
+
+// 典型手工会话：连续运算、修改输入、切换符号与除零恢复
+const char RECORDED_SESSION[] =
+    "C12.5*1.07+0.1="
+    "C1234+5678-90*2="
+    "C0.1+0.2="
+    "C99BB7*1.5N="
+    "C3.14159*2*2="
+    "C100/8=E25+"
+    "C7/0=5+5="
+    "C250*12BB/4="
+    "C1.000001-1="
+    "C9999999*9999999=";
+
+// 固定种子的随机按键序列，按键频率大致模拟手工输入（数字为主）
+QByteArray randomTrace(int length, quint32 seed) {
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<int> pick(0, 99);
+    QByteArray keys;
+    keys.reserve(length);
+    for (int i = 0; i < length; ++i) {
+        int roll = pick(generator);
+        char key;
+        if (roll < 60) {
+            key = static_cast<char>('0' + roll % 10);
+        } else if (roll < 66) {
+            key = '.';
+        } else if (roll < 82) {
+            key = "+-*/"[roll % 4];
+        } else if (roll < 90) {
+            key = '=';
+        } else if (roll < 95) {
+            key = 'B';
+        } else if (roll < 98) {
+            key = 'N';
+        } else if (roll < 99) {
+            key = 'E';
+        } else {
+            key = 'C';
+        }
+        keys.append(key);
+    }
+    return keys;
+}
+
+} // namespace
+
+// 模拟界面：接收显示文本并读取长度
+class DisplaySink : public QObject {
+    Q_OBJECT
+
+public:
+    DisplaySink() : m_characters(0) {}
+    qint64 characters() const { return m_characters; }
+
+public slots:
+    void onDisplayChanged(const QString &text) { m_characters += text.size(); }
+
+private:
+    qint64 m_characters;
+};
+
+class EngineBenchmark : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void keystrokes_data();
+    void keystrokes();
+    void traces_data();
+    void traces();
+    void formatNumber_data();
+    void formatNumber();
+
+private:
+    QByteArray m_recordedTrace;
+    QByteArray m_randomTrace;
+};
+
+void EngineBenchmark::initTestCase() {
+    AllocationCounter::reportCoverage();
+
+    m_recordedTrace = QByteArray(RECORDED_SESSION);
+    m_randomTrace = randomTrace(RANDOM_TRACE_LENGTH, RANDOM_TRACE_SEED);
+
+    // 会话内容可被完整识别，且结果符合预期
+    CalculatorEngine engine;
+    engine.blockSignals(true);
+    QCOMPARE(replayKeystrokes(engine, m_recordedTrace.constData(), m_recordedTrace.size()), 0);
+    QCOMPARE(engine.getDisplayText(), QString("99999980000001"));
+    engine.clearAll();
+    QCOMPARE(replayKeystrokes(engine, "12.5*1.07+0.1=", 14), 0);
+    QCOMPARE(engine.getDisplayText(), QString("13.475"));
+    engine.clearAll();
+    QCOMPARE(replayKeystrokes(engine, m_randomTrace.constData(), m_randomTrace.size()), 0);
+}
+
+void EngineBenchmark::keystrokes_data() {
+    QTest::addColumn<QByteArray>("pattern");
+
+    // 每个模式以被测操作为主，并以清除键结束，保证重复时状态一致
+    QTest::newRow("inputDigit") << QByteArray("123456789012345E");
+    QTest::newRow("inputOperator") << QByteArray("1+2-3*4/5+6-7*8/9+C");
+    QTest::newRow("inputEquals") << QByteArray("12*3=45+6=78/9=1-2=C");
+    QTest::newRow("backspace") << QByteArray("123456789.12BBBBBBBBBBBB");
+    QTest::newRow("changeSign") << QByteArray("123.5NNNNNNNN+NNNNNNNNC");
+    QTest::newRow("inputDecimal") << QByteArray("1.5+.25-0.125*.5=C");
+}
+
+void EngineBenchmark::keystrokes() {
+    QFETCH(QByteArray, pattern);
+
+    QByteArray keys;
+    keys.reserve(pattern.size() * PATTERN_REPEATS);
+    for (int i = 0; i < PATTERN_REPEATS; ++i) {
+        keys.append(pattern);
+    }
+
+    CalculatorEngine engine;
+    engine.blockSignals(true);
+    QElapsedTimer timer;
+    qint64 operations = 0;
+    quint64 allocationsBefore = AllocationCounter::allocations();
+    timer.start();
+    QBENCHMARK {
+        replayKeystrokes(engine, keys.constData(), keys.size());
+        operations += keys.size();
+    }
+    qint64 elapsed = timer.nsecsElapsed();
+    BenchmarkReport::reportRate(QTest::currentDataTag(), "op", operations, elapsed,
+                                AllocationCounter::allocations() - allocationsBefore);
+}
+
+void EngineBenchmark::traces_data() {
+    QTest::addColumn<bool>("random");
+    QTest::addColumn<bool>("display");
+
+    QTest::newRow("recorded") << false << false;
+    QTest::newRow("recorded+display") << false << true;
+    QTest::newRow("random") << true << false;
+    QTest::newRow("random+display") << true << true;
+}
+
+void EngineBenchmark::traces() {
+    QFETCH(bool, random);
+    QFETCH(bool, display);
+
+    QByteArray keys;
+    if (random) {
+        keys = m_randomTrace;
+    } else {
+        keys.reserve(m_recordedTrace.size() * PATTERN_REPEATS / 10);
+        for (int i = 0; i < PATTERN_REPEATS / 10; ++i) {
+            keys.append(m_recordedTrace);
+        }
+    }
+
+    CalculatorEngine engine;
+    DisplaySink sink;
+    if (display) {
+        connect(&engine, &CalculatorEngine::displayChanged,
+                &sink, &DisplaySink::onDisplayChanged);
+    } else {
+        engine.blockSignals(true);
+    }
+
+    QElapsedTimer timer;
+    qint64 operations = 0;
+    quint64 allocationsBefore = AllocationCounter::allocations();
+    timer.start();
+    QBENCHMARK {
+        engine.clearAll();
+        replayKeystrokes(engine, keys.constData(), keys.size());
+        operations += keys.size();
+    }
+    qint64 elapsed = timer.nsecsElapsed();
+    BenchmarkReport::reportRate(QTest::currentDataTag(), "op", operations, elapsed,
+                                AllocationCounter::allocations() - allocationsBefore);
+    QVERIFY(!display || sink.characters() > 0);
+}
+
+void EngineBenchmark::formatNumber_data() {
+    QTest::addColumn<bool>("buffer");
+    QTest::addColumn<double>("scale");
+
+    // scale 决定取值范围：整数、短小数、长小数与科学计数法
+    const struct {
+        const char *name;
+        double scale;
+    } ranges[] = {
+        { "integers", 1.0 },
+        { "short decimals", 0.25 },
+        { "long fractions", 1.0 / 3.0 },
+        { "exponent", 1.7e18 },
+    };
+    for (const auto &range : ranges) {
+        QTest::newRow(QByteArray("QString ").append(range.name).constData()) << false << range.scale;
+        QTest::newRow(QByteArray("buffer ").append(range.name).constData()) << true << range.scale;
+    }
+}
+
+void EngineBenchmark::formatNumber() {
+    QFETCH(bool, buffer);
+    QFETCH(double, scale);
+
+    QElapsedTimer timer;
+    qint64 operations = 0;
+    qint64 characters = 0;
+    quint64 allocationsBefore = AllocationCounter::allocations();
+    timer.start();
+    if (buffer) {
+        char text[NumberFormatter::BUFFER_SIZE];
+        QBENCHMARK {
+            for (int i = 0; i < FORMAT_REPEATS; ++i) {
+                characters += NumberFormatter::format(i * scale, text);
+            }
+            operations += FORMAT_REPEATS;
+        }
+    } else {
+        QBENCHMARK {
+            for (int i = 0; i < FORMAT_REPEATS; ++i) {
+                characters += CalculatorEngine::formatNumber(i * scale).size();
+            }
+            operations += FORMAT_REPEATS;
+        }
+    }
+    qint64 elapsed = timer.nsecsElapsed();
+    BenchmarkReport::reportRate(QTest::currentDataTag(), "op", operations, elapsed,
+                                AllocationCounter::allocations() - allocationsBefore);
+    QVERIFY(characters > 0);
+}
+
+QTEST_MAIN(EngineBenchmark)
+
+#include "EngineBenchmark.moc"
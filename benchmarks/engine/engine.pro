@@ -0,0 +1,11 @@
+# 按键引擎基准：按键模式、会话重放与结果格式化的吞吐和分配次数
+include(../benchmarks.pri)
+
+TARGET = bench_engine
+
+HEADERS += \
+    ../common/AllocationCounter.h
+
+SOURCES += \
+    ../common/AllocationCounter.cpp \
+    EngineBenchmark.cpp
@@ -0,0 +1,260 @@
+/**
+ * @file ExpressionBenchmark.cpp
+ * @brief 表达式求值基准测试
+ *
+ * 对同一个公式 ((x + 1.5) * 3 - 2) / 4 在参数扫描上求值，比较三条路径：
+ *   - 按键引擎：CalculatorEngine 逐键重放 "x+1.5*3-2/4="（立即执行即从左到右）
+ *   - 语法树：Expression::evaluate
+ *   - 带缓存的语法树：二元运算经由 ResultCache（参数取值重复 / 不重复两种情况）
+ *   - 虚拟机：ExpressionProgram::evaluate
+ *   - 按列：ColumnEvaluator::evaluate（SIMD 内核）
+ * 每次 QBENCHMARK 迭代求值 SWEEP_SIZE 次，结果同时以 evaluations/s 输出。
+ */
+
+#include "core/CalculatorEngine.h"
+#include "core/ColumnEvaluator.h"
+#include "core/ExpressionParser.h"
+#include "core/ExpressionProgram.h"
+#include "core/KeystrokeReplay.h"
+#include "core/ResultCache.h"
+#include "../common/BenchmarkReport.h"
+#include <QElapsedTimer>
+#include <QtTest>
+#include <cstring>
+#include <vector>
+
+using namespace Calculator;
+
+namespace {
+
+const int SWEEP_SIZE = 100000;
+const char FORMULA[] = "((x + 1.5) * 3 - 2) / 4";
+const char KEYSTROKE_SUFFIX[] = "+1.5*3-2/4=";
+
+} // namespace
+
+class ExpressionBenchmark : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void outOfRangeResults_data();
+    void outOfRangeResults();
+    void engineKeystrokes();
+    void expressionTree();
+    void cachedExpressionTree_data();
+    void cachedExpressionTree();
+    void registerProgram();
+    void columnKernels();
+    void columnInputs();
+
+private:
+    Expression m_expression;
+    ExpressionProgram m_program;
+    std::vector<QByteArray> m_keystrokes;
+};
+
+void ExpressionBenchmark::initTestCase() {
+    ExpressionParser parser;
+    QVERIFY(parser.parse(FORMULA, static_cast<int>(std::strlen(FORMULA)), m_expression));
+    QVERIFY(m_program.compile(m_expression));
+
+    m_keystrokes.reserve(SWEEP_SIZE);
+    for (int i = 0; i < SWEEP_SIZE; ++i) {
+        m_keystrokes.push_back(QByteArray::number(i) + KEYSTROKE_SUFFIX);
+    }
+
+    // 三条路径结果一致
+    CalculatorEngine engine;
+    engine.blockSignals(true);
+    for (int i = 0; i < 100; ++i) {
+        double x = i;
+        ErrorType error;
+        double expected = m_expression.evaluate(&x, error);
+        QCOMPARE(m_program.evaluate(&x, error), expected);
+        engine.clearAll();
+        replayKeystrokes(engine, m_keystrokes[i].constData(), m_keystrokes[i].size());
+        QCOMPARE(engine.getState().currentValue, expected);
+    }
+}
+
+void ExpressionBenchmark::outOfRangeResults_data() {
+    QTest::addColumn<QByteArray>("formula");
+
+    // 结果不经过二元运算的表达式同样受 MAX_CALCULATION_VALUE 限制
+    QTest::newRow("literal") << QByteArray("1e400");
+    QTest::newRow("literal above limit") << QByteArray("2e15");
+    QTest::newRow("negated literal") << QByteArray("-2e15");
+    QTest::newRow("binary") << QByteArray("1e15*10");
+}
+
+void ExpressionBenchmark::outOfRangeResults() {
+    QFETCH(QByteArray, formula);
+
+    Expression expression;
+    ExpressionParser parser;
+    QVERIFY(parser.parse(formula.constData(), formula.size(), expression));
+    ErrorType error;
+    expression.evaluate(error);
+    QCOMPARE(error, ErrorType::Overflow);
+
+    ExpressionProgram program;
+    QVERIFY(program.compile(expression));
+    program.evaluate(error);
+    QCOMPARE(error, ErrorType::Overflow);
+
+    CalculatorEngine engine;
+    engine.blockSignals(true);
+    engine.evaluateExpression(QString::fromLatin1(formula));
+    QCOMPARE(engine.getState().error, ErrorType::Overflow);
+}
+
+void ExpressionBenchmark::engineKeystrokes() {
+    CalculatorEngine engine;
+    engine.blockSignals(true);
+    QElapsedTimer timer;
+    qint64 evaluations = 0;
+    timer.start();
+    QBENCHMARK {
+        for (int i = 0; i < SWEEP_SIZE; ++i) {
+            const QByteArray &keys = m_keystrokes[i];
+            engine.clearAll();
+            replayKeystrokes(engine, keys.constData(), keys.size());
+        }
+        evaluations += SWEEP_SIZE;
+    }
+    BenchmarkReport::reportRate("engine keystrokes", "evaluation", evaluations, timer.nsecsElapsed());
+}
+
+void ExpressionBenchmark::expressionTree() {
+    QElapsedTimer timer;
+    qint64 evaluations = 0;
+    double sum = 0.0;
+    timer.start();
+    QBENCHMARK {
+        for (int i = 0; i < SWEEP_SIZE; ++i) {
+            double x = i;
+            ErrorType error;
+            sum += m_expression.evaluate(&x, error);
+        }
+        evaluations += SWEEP_SIZE;
+    }
+    BenchmarkReport::reportRate("expression tree", "evaluation", evaluations, timer.nsecsElapsed());
+    QVERIFY(sum != 0.0);
+}
+
+void ExpressionBenchmark::cachedExpressionTree_data() {
+    QTest::addColumn<int>("distinct");
+
+    // 参数只有 256 种取值（如固定汇率换算）与每次都不同
+    QTest::newRow("recurring") << 256;
+    QTest::newRow("unique") << SWEEP_SIZE;
+}
+
+void ExpressionBenchmark::cachedExpressionTree() {
+    QFETCH(int, distinct);
+
+    ResultCache cache;
+    QElapsedTimer timer;
+    qint64 evaluations = 0;
+    double sum = 0.0;
+    timer.start();
+    QBENCHMARK {
+        for (int i = 0; i < SWEEP_SIZE; ++i) {
+            double x = i % distinct;
+            ErrorType error;
+            sum += m_expression.evaluate(&x, error, &cache);
+        }
+        evaluations += SWEEP_SIZE;
+    }
+    BenchmarkReport::reportRate(QTest::currentDataTag(), "evaluation", evaluations,
+                                timer.nsecsElapsed());
+    const ResultCache::Stats stats = cache.stats();
+    qDebug("hit rate %.1f%%", 100.0 * stats.hits / (stats.hits + stats.misses));
+    QVERIFY(sum != 0.0);
+
+    // 与不带缓存的求值一致
+    for (int i = 0; i < 100; ++i) {
+        double x = i;
+        ErrorType error;
+        ErrorType cachedError;
+        QCOMPARE(m_expression.evaluate(&x, cachedError, &cache), m_expression.evaluate(&x, error));
+        QCOMPARE(cachedError, error);
+    }
+}
+
+void ExpressionBenchmark::registerProgram() {
+    QElapsedTimer timer;
+    qint64 evaluations = 0;
+    double sum = 0.0;
+    timer.start();
+    QBENCHMARK {
+        for (int i = 0; i < SWEEP_SIZE; ++i) {
+            double x = i;
+            ErrorType error;
+            sum += m_program.evaluate(&x, error);
+        }
+        evaluations += SWEEP_SIZE;
+    }
+    BenchmarkReport::reportRate("register program", "evaluation", evaluations, timer.nsecsElapsed());
+    QVERIFY(sum != 0.0);
+}
+
+void ExpressionBenchmark::columnKernels() {
+    ColumnEvaluator evaluator;
+    QVERIFY(evaluator.compile(FORMULA, static_cast<int>(std::strlen(FORMULA))));
+
+    std::vector<double> x(SWEEP_SIZE);
+    for (int i = 0; i < SWEEP_SIZE; ++i) {
+        x[i] = i;
+    }
+    const double *columns[] = { x.data() };
+    std::vector<double> results(SWEEP_SIZE);
+    std::vector<ErrorType> errors(SWEEP_SIZE);
+
+    QElapsedTimer timer;
+    qint64 evaluations = 0;
+    timer.start();
+    QBENCHMARK {
+        evaluator.evaluate(columns, SWEEP_SIZE, results.data(), errors.data());
+        evaluations += SWEEP_SIZE;
+    }
+    BenchmarkReport::reportRate(ColumnEvaluator::kernelName(), "evaluation", evaluations,
+                                timer.nsecsElapsed());
+
+    ErrorType error;
+    double last = SWEEP_SIZE - 1;
+    QCOMPARE(results.back(), m_program.evaluate(&last, error));
+}
+
+void ExpressionBenchmark::columnInputs() {
+    ColumnEvaluator evaluator;
+    QVERIFY(evaluator.compile("x", 1));
+
+    // 结果直接取自输入列时同样检查范围
+    std::vector<std::vector<double> > columns(1);
+    columns[0].push_back(1.0);
+    columns[0].push_back(2e15);
+    columns[0].push_back(-1e15);
+    std::vector<double> results;
+    std::vector<ErrorType> errors;
+    QVERIFY(evaluator.evaluate(columns, results, errors));
+    QCOMPARE(errors[0], ErrorType::NoError);
+    QCOMPARE(errors[1], ErrorType::Overflow);
+    QCOMPARE(results[1], 0.0);
+    QCOMPARE(errors[2], ErrorType::NoError);
+
+    // 列数不足或长度不一致时拒绝求值
+    QVERIFY(evaluator.compile("x + y", 5));
+    QVERIFY(!evaluator.evaluate(columns, results, errors));
+    QVERIFY(results.empty() && errors.empty());
+    columns.push_back(std::vector<double>(2, 1.0));
+    QVERIFY(!evaluator.evaluate(columns, results, errors));
+    columns[1].push_back(1.0);
+    QVERIFY(evaluator.evaluate(columns, results, errors));
+    QCOMPARE(results[0], 2.0);
+}
+
+QTEST_MAIN(ExpressionBenchmark)
+
+#include "ExpressionBenchmark.moc"
@@ -0,0 +1,7 @@
+# 表达式求值基准：按键引擎 / 语法树（含结果缓存） / 寄存器虚拟机
+include(../benchmarks.pri)
+
+TARGET = bench_expression
+
+SOURCES += \
+    ExpressionBenchmark.cpp
@@ -0,0 +1,248 @@
+/**
+ * @file HistoryBenchmark.cpp
+ * @brief 计算历史基准测试
+ *
+ *   - append：向内存映射日志追加记录的吞吐与堆分配次数
+ *   - randomAccess：按随机下标读取记录
+ *   - scroll：百万条记录下，历史列表在顶部、中部与跳到末端（触发 fetchMore）时每帧的重绘耗时
+ *   - formatRecord：单条记录的显示文本格式化
+ *   - search：百万条记录下建立检索索引的耗时，以及各类搜索语法的单次查询耗时
+ * 无显示环境时可用 QT_QPA_PLATFORM=offscreen 运行。
+ */
+
+#include "core/HistoryIndex.h"
+#include "core/HistoryLog.h"
+#include "ui/HistoryListModel.h"
+#include "../common/AllocationCounter.h"
+#include "../common/BenchmarkReport.h"
+#include <QElapsedTimer>
+#include <QListView>
+#include <QScrollBar>
+#include <QTemporaryDir>
+#include <QtTest>
+#include <random>
+
+using namespace Calculator;
+
+namespace {
+
+const int RECORD_COUNT = 1000000;
+const int ACCESS_COUNT = 1000000;
+const quint32 SEED = 20250101u;
+
+// 以固定种子生成的运算填充日志
+bool fillLog(HistoryLog &log, int count) {
+    std::mt19937 generator(SEED);
+    std::uniform_real_distribution<double> value(-10000.0, 10000.0);
+    for (int i = 0; i < count; ++i) {
+        const double left = value(generator);
+        const double right = value(generator);
+        if (!log.append(left, Operator::Multiply, right, left * right, ErrorType::NoError)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+class HistoryBenchmark : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void append();
+    void randomAccess();
+    void scroll_data();
+    void scroll();
+    void formatRecord();
+    void search_data();
+    void search();
+    void smallResultPrefix();
+
+private:
+    QTemporaryDir m_directory;
+    HistoryLog m_log;
+};
+
+void HistoryBenchmark::initTestCase() {
+    AllocationCounter::reportCoverage();
+    QVERIFY(m_directory.isValid());
+    QVERIFY2(m_log.open(m_directory.filePath("history.dat")), qPrintable(m_log.errorString()));
+    QVERIFY(fillLog(m_log, RECORD_COUNT));
+    QCOMPARE(m_log.count(), quint64(RECORD_COUNT));
+
+    // 关闭后重新打开，记录保持不变
+    const HistoryRecord last = m_log.at(RECORD_COUNT - 1);
+    m_log.close();
+    QVERIFY(m_log.open(m_directory.filePath("history.dat")));
+    QCOMPARE(m_log.count(), quint64(RECORD_COUNT));
+    QCOMPARE(m_log.at(RECORD_COUNT - 1).result, last.result);
+}
+
+void HistoryBenchmark::append() {
+    HistoryLog log;
+    QVERIFY(log.open(m_directory.filePath("append.dat")));
+
+    QElapsedTimer timer;
+    qint64 operations = 0;
+    quint64 allocationsBefore = AllocationCounter::allocations();
+    timer.start();
+    QBENCHMARK {
+        QVERIFY(log.clear());
+        QVERIFY(fillLog(log, RECORD_COUNT));
+        operations += RECORD_COUNT;
+    }
+    BenchmarkReport::reportRate("append", "op", operations, timer.nsecsElapsed(),
+                                AllocationCounter::allocations() - allocationsBefore);
+}
+
+void HistoryBenchmark::randomAccess() {
+    std::mt19937 generator(SEED);
+    std::uniform_int_distribution<quint64> pick(0, m_log.count() - 1);
+    QVector<quint64> indices(ACCESS_COUNT);
+    for (quint64 &index : indices) {
+        index = pick(generator);
+    }
+
+    double sum = 0.0;
+    QElapsedTimer timer;
+    qint64 operations = 0;
+    quint64 allocationsBefore = AllocationCounter::allocations();
+    timer.start();
+    QBENCHMARK {
+        for (quint64 index : indices) {
+            sum += m_log.at(index).result;
+        }
+        operations += ACCESS_COUNT;
+    }
+    BenchmarkReport::reportRate("randomAccess", "op", operations, timer.nsecsElapsed(),
+                                AllocationCounter::allocations() - allocationsBefore);
+    QVERIFY(sum != 0.0);
+}
+
+void HistoryBenchmark::scroll_data() {
+    QTest::addColumn<int>("position");
+
+    // 0 顶部、1 中部、2 跳到末端（每帧都会触发 fetchMore）
+    QTest::newRow("top") << 0;
+    QTest::newRow("middle") << 1;
+    QTest::newRow("end") << 2;
+}
+
+void HistoryBenchmark::scroll() {
+    QFETCH(int, position);
+
+    HistoryListModel model(&m_log);
+    QListView view;
+    view.setUniformItemSizes(true);
+    view.resize(180, 400);
+    view.setModel(&model);
+    while (position > 0 && model.canFetchMore(QModelIndex())
+           && static_cast<quint64>(model.rowCount()) < m_log.count() / 2) {
+        model.fetchMore(QModelIndex());
+    }
+    view.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&view));
+
+    QScrollBar *bar = view.verticalScrollBar();
+    if (position == 1) {
+        bar->setValue(bar->maximum() / 2);
+    }
+
+    QElapsedTimer timer;
+    qint64 frames = 0;
+    quint64 allocationsBefore = AllocationCounter::allocations();
+    timer.start();
+    QBENCHMARK {
+        if (position == 2) {
+            bar->setValue(bar->maximum());
+        } else {
+            // 在当前位置附近来回滚动一屏
+            bar->setValue(bar->value() + ((frames & 1) ? -bar->pageStep() : bar->pageStep()));
+        }
+        view.viewport()->repaint();
+        ++frames;
+    }
+    qint64 elapsed = timer.nsecsElapsed();
+    qDebug("%s: %.3f ms/frame, %.1f allocations/frame, %d rows exposed", QTest::currentDataTag(),
+           elapsed / 1e6 / frames,
+           static_cast<double>(AllocationCounter::allocations() - allocationsBefore) / frames,
+           model.rowCount());
+}
+
+void HistoryBenchmark::formatRecord() {
+    qint64 characters = 0;
+    QElapsedTimer timer;
+    qint64 operations = 0;
+    quint64 allocationsBefore = AllocationCounter::allocations();
+    timer.start();
+    QBENCHMARK {
+        for (int i = 0; i < ACCESS_COUNT / 10; ++i) {
+            characters += HistoryListModel::formatRecord(m_log.at(i)).size();
+        }
+        operations += ACCESS_COUNT / 10;
+    }
+    BenchmarkReport::reportRate("formatRecord", "op", operations, timer.nsecsElapsed(),
+                                AllocationCounter::allocations() - allocationsBefore);
+    QVERIFY(characters > 0);
+}
+
+void HistoryBenchmark::search_data() {
+    QTest::addColumn<QString>("text");
+
+    QTest::newRow("prefix") << "4200";
+    QTest::newRow("approximate") << "~4200";
+    QTest::newRow("range") << "100..200";
+    QTest::newRow("operand") << "x~500";
+    QTest::newRow("combined") << "-1000..0 x~50";
+}
+
+void HistoryBenchmark::search() {
+    QFETCH(QString, text);
+
+    HistoryQuery query;
+    QVERIFY(HistoryQuery::parse(text, QDateTime::currentDateTime(), &query));
+
+    HistoryIndex index(&m_log);
+    QElapsedTimer buildTimer;
+    buildTimer.start();
+    index.update();
+    const qint64 buildNs = buildTimer.nsecsElapsed();
+    QCOMPARE(index.indexedCount(), m_log.count());
+
+    QVector<quint64> results;
+    QElapsedTimer timer;
+    qint64 operations = 0;
+    timer.start();
+    QBENCHMARK {
+        results = index.search(query);
+        ++operations;
+    }
+    qDebug("%s: build %.1f ms, %.3f ms/query, %d results", QTest::currentDataTag(),
+           buildNs / 1e6, timer.nsecsElapsed() / 1e6 / operations, results.size());
+
+    // 结果按时间从新到旧排列
+    for (int i = 1; i < results.size(); ++i) {
+        QVERIFY(results.at(i - 1) > results.at(i));
+    }
+}
+
+void HistoryBenchmark::smallResultPrefix() {
+    // 小于 1e-4 的结果以科学计数法显示，前缀匹配其尾数
+    HistoryLog log;
+    QVERIFY(log.open(m_directory.filePath("small.dat")));
+    const double results[] = { 4e-05, 0.0004, 4.5e-07, 5e-05, 4.0, -4e-09 };
+    for (double result : results) {
+        QVERIFY(log.append(result, Operator::Multiply, 1.0, result, ErrorType::NoError));
+    }
+
+    HistoryIndex index(&log);
+    QCOMPARE(index.findResultPrefix("4"), QVector<quint64>({ 4, 2, 0 }));
+    QCOMPARE(index.findResultPrefix("4.5"), QVector<quint64>({ 2 }));
+    QCOMPARE(index.findResultPrefix("-4"), QVector<quint64>({ 5 }));
+}
+
+QTEST_MAIN(HistoryBenchmark)
+
+#include "HistoryBenchmark.moc"
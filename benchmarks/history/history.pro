@@ -0,0 +1,15 @@
+# 历史记录基准：内存映射日志的追加 / 读取，以及百万条记录下历史列表的滚动帧耗时
+include(../benchmarks.pri)
+
+QT += gui widgets
+
+TARGET = bench_history
+
+HEADERS += \
+    ../common/AllocationCounter.h \
+    ../../inc/ui/HistoryListModel.h
+
+SOURCES += \
+    ../common/AllocationCounter.cpp \
+    ../../src/ui/HistoryListModel.cpp \
+    HistoryBenchmark.cpp
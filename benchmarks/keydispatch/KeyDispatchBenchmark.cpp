@@ -0,0 +1,281 @@
+/**
+ * @file KeyDispatchBenchmark.cpp
+ * @brief 键盘分发基准测试
+ *
+ * 用固定种子生成数据录入式的按键序列（数字为主，夹带自动重复的连按），
+ * 预先构造成合成 QKeyEvent，再比较三种分发路径：
+ *   - legacy：改动前 keyPressEvent 的 if/else 判断链（读取 event->text() 并与 "+"、"-" 比较）
+ *   - table：KeyDispatchTable 查表
+ *   - window：QApplication::sendEvent 发送到真实的 MainWindow（含引擎处理）
+ * 每项输出 events/s、ns/event 以及每个事件的堆分配次数。
+ * 无显示环境时可用 QT_QPA_PLATFORM=offscreen 运行。
+ */
+
+#include "ui/KeyDispatchTable.h"
+#include "ui/MainWindow.h"
+#include "../common/AllocationCounter.h"
+#include "../common/BenchmarkReport.h"
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QKeyEvent>
+#include <QStandardPaths>
+#include <QtTest>
+#include <random>
+
+using namespace Calculator;
+
+namespace {
+
+const int TRACE_LENGTH = 100000;
+const quint32 TRACE_SEED = 20250101u;
+const int MAX_REPEAT = 8;
+
+// 录入按键对应的合成事件参数
+struct KeySpec {
+    int key;
+    Qt::KeyboardModifiers modifiers;
+    const char *text;
+};
+
+KeySpec keySpecOf(char c) {
+    switch (c) {
+    case '.': return { Qt::Key_Period, Qt::NoModifier, "." };
+    case '+': return { Qt::Key_Plus, Qt::ShiftModifier, "+" };
+    case '-': return { Qt::Key_Minus, Qt::NoModifier, "-" };
+    case '*': return { Qt::Key_Asterisk, Qt::ShiftModifier, "*" };
+    case '/': return { Qt::Key_Slash, Qt::NoModifier, "/" };
+    case '=': return { Qt::Key_Return, Qt::NoModifier, "\r" };
+    case 'B': return { Qt::Key_Backspace, Qt::NoModifier, "\b" };
+    case 'C': return { Qt::Key_Escape, Qt::NoModifier, "\x1b" };
+    default: break;
+    }
+    static const char DIGITS[] = "0123456789";
+    return { Qt::Key_0 + (c - '0'), Qt::KeypadModifier, DIGITS + (c - '0') };
+}
+
+// 固定种子的录入序列：数字为主，部分按键以自动重复方式连按
+QList<QKeyEvent *> buildEvents(int length, quint32 seed) {
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<int> pick(0, 99);
+    std::uniform_int_distribution<int> repeat(2, MAX_REPEAT);
+    QList<QKeyEvent *> events;
+    events.reserve(length);
+    while (events.size() < length) {
+        int roll = pick(generator);
+        char c;
+        int count = 1;
+        if (roll < 62) {
+            c = static_cast<char>('0' + roll % 10);
+            if (roll % 7 == 0) {
+                count = repeat(generator);
+            }
+        } else if (roll < 68) {
+            c = '.';
+        } else if (roll < 84) {
+            c = "+-*/"[roll % 4];
+        } else if (roll < 92) {
+            c = '=';
+        } else if (roll < 98) {
+            c = 'B';
+            count = repeat(generator);
+        } else {
+            c = 'C';
+        }
+        const KeySpec spec = keySpecOf(c);
+        for (int i = 0; i < count && events.size() < length; ++i) {
+            events.append(new QKeyEvent(QEvent::KeyPress, spec.key, spec.modifiers,
+                                        QString::fromLatin1(spec.text), i > 0));
+        }
+    }
+    return events;
+}
+
+// 改动前 MainWindow::keyPressEvent 的判断链，返回对应的命令 id
+int legacyDispatch(const QKeyEvent *event) {
+    static const int DIGIT0 = KeyDispatchTable::commandId("digit0");
+    static const int DIGIT_IDS[10] = {
+        DIGIT0,
+        KeyDispatchTable::commandId("digit1"), KeyDispatchTable::commandId("digit2"),
+        KeyDispatchTable::commandId("digit3"), KeyDispatchTable::commandId("digit4"),
+        KeyDispatchTable::commandId("digit5"), KeyDispatchTable::commandId("digit6"),
+        KeyDispatchTable::commandId("digit7"), KeyDispatchTable::commandId("digit8"),
+        KeyDispatchTable::commandId("digit9")
+    };
+    static const int ADD = KeyDispatchTable::commandId("add");
+    static const int SUBTRACT = KeyDispatchTable::commandId("subtract");
+    static const int MULTIPLY = KeyDispatchTable::commandId("multiply");
+    static const int DIVIDE = KeyDispatchTable::commandId("divide");
+    static const int EQUALS = KeyDispatchTable::commandId("equals");
+    static const int DECIMAL = KeyDispatchTable::commandId("decimal");
+    static const int BACKSPACE = KeyDispatchTable::commandId("backspace");
+    static const int CLEAR_ALL = KeyDispatchTable::commandId("clearAll");
+
+    QString keyText = event->text();
+    int key = event->key();
+
+    if (key >= Qt::Key_0 && key <= Qt::Key_9) {
+        return DIGIT_IDS[key - Qt::Key_0];
+    }
+    if (keyText == "+") {
+        return ADD;
+    } else if (keyText == "-") {
+        return SUBTRACT;
+    } else if (key == Qt::Key_Asterisk) {
+        return MULTIPLY;
+    } else if (key == Qt::Key_Slash) {
+        return DIVIDE;
+    } else if (key == Qt::Key_Equal || key == Qt::Key_Enter || key == Qt::Key_Return) {
+        return EQUALS;
+    } else if (key == Qt::Key_Period || key == Qt::Key_Comma) {
+        return DECIMAL;
+    } else if (key == Qt::Key_Backspace) {
+        return BACKSPACE;
+    } else if (key == Qt::Key_T && (event->modifiers() & Qt::ControlModifier)) {
+        return KeyDispatchTable::ToggleTheme;
+    } else if (key == Qt::Key_Escape) {
+        return CLEAR_ALL;
+    }
+    return KeyDispatchTable::NO_COMMAND;
+}
+
+} // namespace
+
+class KeyDispatchBenchmark : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void dispatch_data();
+    void dispatch();
+    void chords();
+    void chordPrefixRelease();
+
+private:
+    QList<QKeyEvent *> m_events;
+};
+
+void KeyDispatchBenchmark::initTestCase() {
+    // 主窗口读取 QSettings，避免使用真实的用户配置
+    QStandardPaths::setTestModeEnabled(true);
+    AllocationCounter::reportCoverage();
+
+    m_events = buildEvents(TRACE_LENGTH, TRACE_SEED);
+
+    // 默认键位表与改动前的判断链对录入序列给出相同的命令
+    KeyDispatchTable table;
+    for (const QKeyEvent *event : m_events) {
+        const int expected = legacyDispatch(event);
+        QVERIFY(expected != KeyDispatchTable::NO_COMMAND);
+        QCOMPARE(table.dispatch(event->key(), event->modifiers()), expected);
+    }
+}
+
+void KeyDispatchBenchmark::cleanupTestCase() {
+    qDeleteAll(m_events);
+    m_events.clear();
+}
+
+void KeyDispatchBenchmark::dispatch_data() {
+    QTest::addColumn<QString>("path");
+
+    QTest::newRow("legacy") << QString("legacy");
+    QTest::newRow("table") << QString("table");
+    QTest::newRow("window") << QString("window");
+}
+
+void KeyDispatchBenchmark::dispatch() {
+    QFETCH(QString, path);
+
+    KeyDispatchTable table;
+    QScopedPointer<MainWindow> window;
+    if (path == "window") {
+        window.reset(new MainWindow());
+    }
+    qint64 checksum = 0;
+    qint64 events = 0;
+    QElapsedTimer timer;
+    quint64 allocationsBefore = AllocationCounter::allocations();
+    timer.start();
+    if (path == "legacy") {
+        QBENCHMARK {
+            for (const QKeyEvent *event : m_events) {
+                checksum += legacyDispatch(event);
+            }
+            events += m_events.size();
+        }
+    } else if (path == "table") {
+        QBENCHMARK {
+            for (const QKeyEvent *event : m_events) {
+                checksum += table.dispatch(event->key(), event->modifiers());
+            }
+            events += m_events.size();
+        }
+    } else {
+        QBENCHMARK {
+            for (QKeyEvent *event : m_events) {
+                QApplication::sendEvent(window.data(), event);
+                checksum += event->isAccepted() ? 1 : 0;
+            }
+            events += m_events.size();
+        }
+    }
+    qint64 elapsed = timer.nsecsElapsed();
+    BenchmarkReport::reportRate(QTest::currentDataTag(), "event", events, elapsed,
+                                AllocationCounter::allocations() - allocationsBefore);
+    QVERIFY(checksum > 0);
+}
+
+void KeyDispatchBenchmark::chords() {
+    // 两段和弦的分发开销：Ctrl+K 之后再按一个数字键
+    KeyDispatchTable table;
+    QVERIFY(table.bind(QKeySequence(Qt::CTRL + Qt::Key_K, Qt::Key_1), KeyDispatchTable::ChangeSign));
+    QKeyEvent prefix(QEvent::KeyPress, Qt::Key_K, Qt::ControlModifier);
+    QKeyEvent second(QEvent::KeyPress, Qt::Key_1, Qt::NoModifier, QString("1"));
+    QCOMPARE(table.dispatch(prefix.key(), prefix.modifiers()), int(KeyDispatchTable::CHORD_PENDING));
+    QCOMPARE(table.dispatch(second.key(), second.modifiers()), int(KeyDispatchTable::ChangeSign));
+
+    qint64 checksum = 0;
+    qint64 events = 0;
+    QElapsedTimer timer;
+    quint64 allocationsBefore = AllocationCounter::allocations();
+    timer.start();
+    QBENCHMARK {
+        for (int i = 0; i < TRACE_LENGTH / 2; ++i) {
+            checksum += table.dispatch(prefix.key(), prefix.modifiers());
+            checksum += table.dispatch(second.key(), second.modifiers());
+        }
+        events += TRACE_LENGTH;
+    }
+    qint64 elapsed = timer.nsecsElapsed();
+    BenchmarkReport::reportRate("chord", "event", events, elapsed,
+                                AllocationCounter::allocations() - allocationsBefore);
+    QVERIFY(checksum != 0);
+}
+
+void KeyDispatchBenchmark::chordPrefixRelease() {
+    // 第二段无法绑定时不留下前缀，Ctrl+K 仍可绑定为单键
+    KeyDispatchTable table;
+    QVERIFY(!table.bind(QKeySequence(Qt::CTRL + Qt::Key_K, Qt::Key_Eacute), KeyDispatchTable::ChangeSign));
+    QCOMPARE(table.dispatch(Qt::Key_K, Qt::ControlModifier), int(KeyDispatchTable::NO_COMMAND));
+    QVERIFY(table.bind(QKeySequence(Qt::CTRL + Qt::Key_K), KeyDispatchTable::ChangeSign));
+
+    // 解除和弦的最后一个命令后前缀随之解除
+    table.unbindCommand(KeyDispatchTable::ChangeSign);
+    QVERIFY(table.bind(QKeySequence(Qt::CTRL + Qt::Key_K, Qt::Key_1), KeyDispatchTable::ChangeSign));
+    table.unbindCommand(KeyDispatchTable::ChangeSign);
+    QCOMPARE(table.dispatch(Qt::Key_K, Qt::ControlModifier), int(KeyDispatchTable::NO_COMMAND));
+    QCOMPARE(table.dispatch(Qt::Key_1, Qt::NoModifier), KeyDispatchTable::commandId("digit1"));
+    QVERIFY(table.bind(QKeySequence(Qt::CTRL + Qt::Key_K), KeyDispatchTable::ChangeSign));
+    table.unbindCommand(KeyDispatchTable::ChangeSign);
+
+    // 反复重绑时前缀层被复用，不会耗尽
+    for (int i = 0; i < 4 * KeyDispatchTable::MAX_CHORD_PREFIXES; ++i) {
+        QVERIFY(table.bind(QKeySequence(Qt::CTRL + Qt::Key_K, Qt::Key_1), KeyDispatchTable::ChangeSign));
+        table.unbindCommand(KeyDispatchTable::ChangeSign);
+    }
+}
+
+QTEST_MAIN(KeyDispatchBenchmark)
+
+#include "KeyDispatchBenchmark.moc"
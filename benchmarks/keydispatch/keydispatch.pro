@@ -0,0 +1,31 @@
+# 键盘分发基准：合成 QKeyEvent 在键位表、改动前的判断链与主窗口上的吞吐和分配次数
+include(../benchmarks.pri)
+
+# 编译期生成的界面主题（主窗口依赖）
+include(../../themes.pri)
+
+QT += gui widgets
+
+TARGET = bench_keydispatch
+
+HEADERS += \
+    ../common/AllocationCounter.h \
+    ../../inc/ui/ButtonTable.h \
+    ../../inc/ui/DisplayPanel.h \
+    ../../inc/ui/DisplayUpdateCoalescer.h \
+    ../../inc/ui/HistoryListModel.h \
+    ../../inc/ui/KeyDispatchTable.h \
+    ../../inc/ui/MainWindow.h \
+    ../../inc/ui/NumPadButton.h \
+    ../../inc/utils/StartupProfiler.h
+
+SOURCES += \
+    ../common/AllocationCounter.cpp \
+    ../../src/ui/DisplayPanel.cpp \
+    ../../src/ui/DisplayUpdateCoalescer.cpp \
+    ../../src/ui/HistoryListModel.cpp \
+    ../../src/ui/KeyDispatchTable.cpp \
+    ../../src/ui/MainWindow.cpp \
+    ../../src/ui/NumPadButton.cpp \
+    ../../src/utils/StartupProfiler.cpp \
+    KeyDispatchBenchmark.cpp
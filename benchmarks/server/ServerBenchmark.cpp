@@ -0,0 +1,215 @@
+/**
+ * @file ServerBenchmark.cpp
+ * @brief 引擎服务吞吐基准测试
+ *
+ * 在进程内启动 EngineServer（事件循环线程数为全部核心），客户端线程各自建立一个连接，
+ * 每次发送 depth 个请求后再读取全部响应（depth 为 1 时即一问一答）：
+ *   - keys：按键请求，分布在每个连接的多个会话上
+ *   - expression：表达式请求
+ * 每项输出全部客户端合计的 requests/s 与 ns/request。
+ */
+
+#include "core/CalculatorEngine.h"
+#include "server/EngineServer.h"
+#include "server/ServerProtocol.h"
+#include "../common/BenchmarkReport.h"
+#include <QDir>
+#include <QElapsedTimer>
+#include <QtTest>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace Calculator;
+
+namespace {
+
+const int REQUESTS_PER_CLIENT = 200000;
+const int SESSIONS_PER_CONNECTION = 64;
+
+int connectTo(const QString &path) {
+    const QByteArray name = QFile::encodeName(path);
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, name.constData(), name.size());
+
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd >= 0 && ::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+bool writeAll(int fd, const char *data, int size) {
+    while (size > 0) {
+        const ssize_t written = ::write(fd, data, size);
+        if (written <= 0) {
+            return false;
+        }
+        data += written;
+        size -= static_cast<int>(written);
+    }
+    return true;
+}
+
+bool readAll(int fd, char *data, int size) {
+    while (size > 0) {
+        const ssize_t received = ::read(fd, data, size);
+        if (received <= 0) {
+            return false;
+        }
+        data += received;
+        size -= static_cast<int>(received);
+    }
+    return true;
+}
+
+void appendRequest(QByteArray &out, quint32 tag, quint32 session, RequestType type, const char *payload) {
+    RequestHeader header;
+    header.tag = tag;
+    header.session = session;
+    header.length = static_cast<quint16>(std::strlen(payload));
+    header.type = type;
+    uchar bytes[REQUEST_HEADER_SIZE];
+    writeRequestHeader(bytes, header);
+    out.append(reinterpret_cast<const char*>(bytes), REQUEST_HEADER_SIZE);
+    out.append(payload);
+}
+
+// 发送一个请求并读取响应文本
+QByteArray roundTrip(int fd, RequestType type, const char *payload, ResponseHeader &response) {
+    QByteArray request;
+    appendRequest(request, 1, 0, type, payload);
+    uchar header[RESPONSE_HEADER_SIZE];
+    if (!writeAll(fd, request.constData(), request.size())
+        || !readAll(fd, reinterpret_cast<char*>(header), RESPONSE_HEADER_SIZE)) {
+        return QByteArray();
+    }
+    response = readResponseHeader(header);
+    QByteArray text(response.length, '\0');
+    readAll(fd, text.data(), text.size());
+    return text;
+}
+
+} // namespace
+
+class ServerBenchmark : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void pipelined_data();
+    void pipelined();
+
+private:
+    QString m_socketPath;
+    std::unique_ptr<EngineServer> m_server;
+};
+
+void ServerBenchmark::initTestCase() {
+    m_socketPath = QDir::temp().filePath(QString("calculator-bench-%1.sock").arg(QCoreApplication::applicationPid()));
+    ServerOptions options;
+    options.socketPath = m_socketPath;
+    m_server.reset(new EngineServer(options));
+    QVERIFY2(m_server->start(), qPrintable(m_server->errorString()));
+    qDebug("server threads: %d", m_server->threadCount());
+
+    // 会话语义与 CalculatorEngine 相同
+    const int fd = connectTo(m_socketPath);
+    QVERIFY(fd >= 0);
+    ResponseHeader response;
+    QCOMPARE(roundTrip(fd, RequestType::Keys, "12*3=", response), QByteArray("36"));
+    QCOMPARE(roundTrip(fd, RequestType::Keys, "+4=", response), QByteArray("40"));
+    QCOMPARE(roundTrip(fd, RequestType::Expression, "(1+2)*3", response), QByteArray("9"));
+    QCOMPARE(roundTrip(fd, RequestType::Expression, "1/0", response),
+             CalculatorEngine::errorText(ErrorType::DivisionByZero).toUtf8());
+    QCOMPARE(response.error, static_cast<quint8>(ErrorType::DivisionByZero));
+    QCOMPARE(roundTrip(fd, RequestType::Expression, "1e400", response),
+             CalculatorEngine::errorText(ErrorType::Overflow).toUtf8());
+    QCOMPARE(response.error, static_cast<quint8>(ErrorType::Overflow));
+    QCOMPARE(roundTrip(fd, RequestType::Reset, "", response), QByteArray("0"));
+    ::close(fd);
+}
+
+void ServerBenchmark::cleanupTestCase() {
+    m_server.reset();
+}
+
+void ServerBenchmark::pipelined_data() {
+    QTest::addColumn<bool>("expressions");
+    QTest::addColumn<int>("clients");
+    QTest::addColumn<int>("depth");
+
+    const int cores = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    QTest::newRow("keys 1 client depth 1") << false << 1 << 1;
+    QTest::newRow("keys 1 client depth 64") << false << 1 << 64;
+    QTest::newRow("keys all cores depth 1") << false << cores << 1;
+    QTest::newRow("keys all cores depth 256") << false << cores << 256;
+    QTest::newRow("expression all cores depth 256") << true << cores << 256;
+}
+
+void ServerBenchmark::pipelined() {
+    QFETCH(bool, expressions);
+    QFETCH(int, clients);
+    QFETCH(int, depth);
+
+    // 每个请求都以固定结果结束，响应长度已知
+    const RequestType type = expressions ? RequestType::Expression : RequestType::Keys;
+    const char *payload = expressions ? "(12+34)*2" : "C12+34*2=";
+    const int responseSize = RESPONSE_HEADER_SIZE + 2;
+    QByteArray batch;
+    for (int i = 0; i < depth; ++i) {
+        appendRequest(batch, static_cast<quint32>(i), static_cast<quint32>(i % SESSIONS_PER_CONNECTION),
+                      type, payload);
+    }
+
+    std::vector<int> sockets;
+    for (int i = 0; i < clients; ++i) {
+        sockets.push_back(connectTo(m_socketPath));
+        QVERIFY(sockets.back() >= 0);
+    }
+
+    QElapsedTimer timer;
+    qint64 requests = 0;
+    std::atomic<int> failures(0);
+    timer.start();
+    QBENCHMARK {
+        std::vector<std::thread> threads;
+        for (int fd : sockets) {
+            threads.emplace_back([&, fd]() {
+                QByteArray responses(depth * responseSize, '\0');
+                for (int sent = 0; sent < REQUESTS_PER_CLIENT; sent += depth) {
+                    if (!writeAll(fd, batch.constData(), batch.size())
+                        || !readAll(fd, responses.data(), responses.size())) {
+                        ++failures;
+                        return;
+                    }
+                }
+            });
+        }
+        for (std::thread &thread : threads) {
+            thread.join();
+        }
+        requests += static_cast<qint64>(clients) * ((REQUESTS_PER_CLIENT + depth - 1) / depth * depth);
+    }
+    qint64 elapsed = timer.nsecsElapsed();
+    BenchmarkReport::reportRate(QTest::currentDataTag(), "request", requests, elapsed);
+
+    for (int fd : sockets) {
+        ::close(fd);
+    }
+    QCOMPARE(failures.load(), 0);
+}
+
+QTEST_MAIN(ServerBenchmark)
+
+#include "ServerBenchmark.moc"
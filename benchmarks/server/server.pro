@@ -0,0 +1,12 @@
+# 引擎服务基准：Unix 域套接字上的流水线请求吞吐（仅 Linux）
+include(../benchmarks.pri)
+
+TARGET = bench_server
+
+SOURCES += \
+    ../../src/server/EngineServer.cpp \
+    ServerBenchmark.cpp
+
+HEADERS += \
+    ../../inc/server/EngineServer.h \
+    ../../inc/server/ServerProtocol.h
@@ -0,0 +1,230 @@
+/**
+ * @file ThemeBenchmark.cpp
+ * @brief 主题应用基准测试
+ *
+ * 在与主窗口相同的部件树（显示面板 + 19 个按钮）上比较两种主题方式：
+ *   - stylesheet：改动前的做法，qApp->setStyleSheet() 加载 qss，再对每个按钮
+ *     setStyleSheet() 一段 CSS 字符串
+ *   - compiled：编译期生成的 ThemeData，通过调色板与 paintEvent 应用
+ * startup 构建部件树、应用主题并离屏渲染一帧；themeSwitch 在默认 / 深色主题间切换并渲染。
+ * 无显示环境时可用 QT_QPA_PLATFORM=offscreen 运行。
+ */
+
+#include "ui/DisplayPanel.h"
+#include "ui/NumPadButton.h"
+#include "ui/Theme.h"
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QGridLayout>
+#include <QLineEdit>
+#include <QPushButton>
+#include <QVBoxLayout>
+#include <QtTest>
+
+using namespace Calculator;
+
+namespace {
+
+const char *const BUTTON_TEXTS[] = {
+    "CE", "C", "⌫", "÷",
+    "7", "8", "9", "×",
+    "4", "5", "6", "-",
+    "1", "2", "3", "+",
+    "0", ".", "="
+};
+const int BUTTON_COUNT = 19;
+
+// 改动前 setupButtonStyles() 中按钮类型对应的样式表
+const char NUMBER_STYLE[] =
+    "QPushButton { background-color: #f8f9fa; border: 1px solid #dee2e6; border-radius: 4px;"
+    " font-size: 16px; font-weight: 500; }"
+    "QPushButton:hover { background-color: #e9ecef; }"
+    "QPushButton:pressed { background-color: #dee2e6; }";
+const char OPERATOR_STYLE[] =
+    "QPushButton { background-color: #007bff; border: 1px solid #007bff; border-radius: 4px;"
+    " color: white; font-size: 16px; font-weight: 600; }"
+    "QPushButton:hover { background-color: #0056b3; }"
+    "QPushButton:pressed { background-color: #004085; }";
+const char EQUALS_STYLE[] =
+    "QPushButton { background-color: #28a745; border: 1px solid #28a745; border-radius: 4px;"
+    " color: white; font-size: 16px; font-weight: 600; }"
+    "QPushButton:hover { background-color: #218838; }"
+    "QPushButton:pressed { background-color: #1e7e34; }";
+const char FUNCTION_STYLE[] =
+    "QPushButton { background-color: #6c757d; border: 1px solid #6c757d; border-radius: 4px;"
+    " color: white; font-size: 14px; font-weight: 500; }"
+    "QPushButton:hover { background-color: #5a6268; }"
+    "QPushButton:pressed { background-color: #545b62; }";
+
+ButtonType buttonTypeOf(const QString &text) {
+    if (text.size() == 1 && text[0].isDigit()) return ButtonType::Number;
+    if (text == "+" || text == "-" || text == "×" || text == "÷") return ButtonType::Operator;
+    if (text == "=") return ButtonType::Equals;
+    if (text == ".") return ButtonType::Decimal;
+    return ButtonType::Function;
+}
+
+const char *legacyStyleOf(ButtonType type) {
+    switch (type) {
+    case ButtonType::Number:
+    case ButtonType::Decimal:
+        return NUMBER_STYLE;
+    case ButtonType::Operator:
+        return OPERATOR_STYLE;
+    case ButtonType::Equals:
+        return EQUALS_STYLE;
+    default:
+        return FUNCTION_STYLE;
+    }
+}
+
+QString readStyleSheet(const char *name) {
+    QFile file(QString(STYLES_DIR "/%1.qss").arg(QLatin1String(name)));
+    if (!file.open(QFile::ReadOnly)) {
+        return QString();
+    }
+    return QString::fromUtf8(file.readAll());
+}
+
+// 与主窗口相同形状的部件树
+struct WidgetTree {
+    QWidget root;
+    QLineEdit *display;
+    QList<QPushButton *> buttons;
+
+    explicit WidgetTree(bool compiled) {
+        root.resize(300, 400);
+        QVBoxLayout *layout = new QVBoxLayout(&root);
+        display = compiled ? new DisplayPanel() : new QLineEdit();
+        display->setText("12345.678");
+        layout->addWidget(display);
+        QGridLayout *grid = new QGridLayout();
+        for (int i = 0; i < BUTTON_COUNT; ++i) {
+            const QString text = QString::fromUtf8(BUTTON_TEXTS[i]);
+            QPushButton *button;
+            if (compiled) {
+                NumPadButton *numPad = new NumPadButton(text);
+                numPad->setButtonType(buttonTypeOf(text));
+                button = numPad;
+            } else {
+                button = new QPushButton(text);
+            }
+            grid->addWidget(button, i / 4, i % 4);
+            buttons.append(button);
+        }
+        layout->addLayout(grid);
+    }
+
+    void applyStyleSheet(const QString &styleSheet) {
+        qApp->setStyleSheet(styleSheet);
+        for (QPushButton *button : buttons) {
+            button->setStyleSheet(QLatin1String(legacyStyleOf(buttonTypeOf(button->text()))));
+        }
+    }
+
+    void applyTheme(const ThemeData &theme) {
+        const QPalette base = QApplication::palette();
+        root.setPalette(Theme::palette(theme, base));
+        static_cast<DisplayPanel *>(display)->setTheme(&theme);
+        for (QPushButton *button : buttons) {
+            static_cast<NumPadButton *>(button)->setTheme(&theme);
+        }
+    }
+};
+
+void reportRate(const char *name, qint64 operations, qint64 elapsedNs) {
+    qDebug("%s: %.3f ms/operation", name, elapsedNs / 1e6 / operations);
+}
+
+} // namespace
+
+class ThemeBenchmark : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanup();
+    void startup_data();
+    void startup();
+    void themeSwitch_data();
+    void themeSwitch();
+
+private:
+    QString m_defaultStyleSheet;
+    QString m_darkStyleSheet;
+};
+
+void ThemeBenchmark::initTestCase() {
+    m_defaultStyleSheet = readStyleSheet("default");
+    m_darkStyleSheet = readStyleSheet("dark");
+    QVERIFY(!m_defaultStyleSheet.isEmpty());
+    QVERIFY(!m_darkStyleSheet.isEmpty());
+    QVERIFY(Theme::find("default") != nullptr);
+    QVERIFY(Theme::find("dark") != nullptr);
+    // 旧版本设置中保存的样式表路径
+    QVERIFY(Theme::find(":/styles/dark.qss") != nullptr);
+}
+
+void ThemeBenchmark::cleanup() {
+    qApp->setStyleSheet(QString());
+}
+
+void ThemeBenchmark::startup_data() {
+    QTest::addColumn<bool>("compiled");
+    QTest::newRow("stylesheet") << false;
+    QTest::newRow("compiled") << true;
+}
+
+void ThemeBenchmark::startup() {
+    QFETCH(bool, compiled);
+
+    QElapsedTimer timer;
+    qint64 operations = 0;
+    timer.start();
+    QBENCHMARK {
+        // 全局样式表在每次迭代前清空，保证两种方式都从无样式开始
+        qApp->setStyleSheet(QString());
+        WidgetTree tree(compiled);
+        if (compiled) {
+            tree.applyTheme(Theme::defaultTheme());
+        } else {
+            tree.applyStyleSheet(m_defaultStyleSheet);
+        }
+        QVERIFY(!tree.root.grab().isNull());
+        ++operations;
+    }
+    reportRate(QTest::currentDataTag(), operations, timer.nsecsElapsed());
+}
+
+void ThemeBenchmark::themeSwitch_data() {
+    startup_data();
+}
+
+void ThemeBenchmark::themeSwitch() {
+    QFETCH(bool, compiled);
+
+    WidgetTree tree(compiled);
+    const ThemeData *dark = Theme::find("dark");
+    QVERIFY(dark != nullptr);
+
+    QElapsedTimer timer;
+    qint64 operations = 0;
+    bool useDark = false;
+    timer.start();
+    QBENCHMARK {
+        useDark = !useDark;
+        if (compiled) {
+            tree.applyTheme(useDark ? *dark : Theme::defaultTheme());
+        } else {
+            tree.applyStyleSheet(useDark ? m_darkStyleSheet : m_defaultStyleSheet);
+        }
+        QVERIFY(!tree.root.grab().isNull());
+        ++operations;
+    }
+    reportRate(QTest::currentDataTag(), operations, timer.nsecsElapsed());
+}
+
+QTEST_MAIN(ThemeBenchmark)
+
+#include "ThemeBenchmark.moc"
@@ -0,0 +1,20 @@
+# 主题基准：改动前的运行时样式表与编译期生成主题的启动与切换耗时
+include(../benchmarks.pri)
+
+# 编译期生成的界面主题
+include(../../themes.pri)
+
+QT += gui widgets
+
+TARGET = bench_theme
+
+DEFINES += STYLES_DIR=\\\"$$PWD/../../styles\\\"
+
+HEADERS += \
+    ../../inc/ui/DisplayPanel.h \
+    ../../inc/ui/NumPadButton.h
+
+SOURCES += \
+    ../../src/ui/DisplayPanel.cpp \
+    ../../src/ui/NumPadButton.cpp \
+    ThemeBenchmark.cpp
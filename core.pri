@@ -0,0 +1,59 @@
+# 计算核心与工具模块（不依赖 Qt Widgets），供 GUI 与无界面目标共享
+
+INCLUDEPATH += $$PWD/inc
+
+# 引擎运行指标（计数与耗时直方图），qmake "CONFIG+=metrics" 时编入
+metrics {
+    DEFINES += CALCULATOR_ENABLE_METRICS
+}
+
+# C++14 下 std::allocator 默认不遵守超过 16 字节的 alignas（如 WorkStealingPool 的任务区间）
+QMAKE_CXXFLAGS += -faligned-new
+
+SOURCES += \
+    $$PWD/src/core/BigInteger.cpp \
+    $$PWD/src/core/BigRational.cpp \
+    $$PWD/src/core/CalculatorEngine.cpp \
+    $$PWD/src/core/ColumnEvaluator.cpp \
+    $$PWD/src/core/Decimal128.cpp \
+    $$PWD/src/core/Expression.cpp \
+    $$PWD/src/core/ExpressionParser.cpp \
+    $$PWD/src/core/ExpressionProgram.cpp \
+    $$PWD/src/core/HistoryIndex.cpp \
+    $$PWD/src/core/HistoryLog.cpp \
+    $$PWD/src/core/KeystrokeReplay.cpp \
+    $$PWD/src/core/NumericBackend.cpp \
+    $$PWD/src/core/ResultCache.cpp \
+    $$PWD/src/utils/Metrics.cpp \
+    $$PWD/src/utils/NumberFormatter.cpp \
+    $$PWD/src/utils/NumberParser.cpp \
+    $$PWD/src/utils/SettingsManager.cpp \
+    $$PWD/src/utils/SettingsWriter.cpp \
+    $$PWD/src/utils/TraceRecorder.cpp \
+    $$PWD/src/utils/WorkStealingPool.cpp
+
+HEADERS += \
+    $$PWD/inc/core/Arithmetic.h \
+    $$PWD/inc/core/BigInteger.h \
+    $$PWD/inc/core/BigRational.h \
+    $$PWD/inc/core/CalculatorEngine.h \
+    $$PWD/inc/core/CalculationTypes.h \
+    $$PWD/inc/core/ColumnEvaluator.h \
+    $$PWD/inc/core/Decimal128.h \
+    $$PWD/inc/core/EngineCore.h \
+    $$PWD/inc/core/Expression.h \
+    $$PWD/inc/core/ExpressionParser.h \
+    $$PWD/inc/core/ExpressionProgram.h \
+    $$PWD/inc/core/HistoryIndex.h \
+    $$PWD/inc/core/HistoryLog.h \
+    $$PWD/inc/core/KeystrokeReplay.h \
+    $$PWD/inc/core/NumericBackend.h \
+    $$PWD/inc/core/ResultCache.h \
+    $$PWD/inc/utils/Constants.h \
+    $$PWD/inc/utils/Metrics.h \
+    $$PWD/inc/utils/NumberFormatter.h \
+    $$PWD/inc/utils/NumberParser.h \
+    $$PWD/inc/utils/SettingsManager.h \
+    $$PWD/inc/utils/SettingsWriter.h \
+    $$PWD/inc/utils/TraceRecorder.h \
+    $$PWD/inc/utils/WorkStealingPool.h
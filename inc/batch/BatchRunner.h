@@ -0,0 +1,94 @@
+/**
+ * @file BatchRunner.h
+ * @brief 无界面批量求值
+ * @author Jisq
+ * @version 1.0
+ * @date 2025
+ */
+
+#ifndef BATCHRUNNER_H
+#define BATCHRUNNER_H
+
+#include "../core/CalculationTypes.h"
+#include "../core/Decimal128.h"
+#include "../core/ResultCache.h"
+#include <QByteArray>
+#include <QString>
+#include <memory>
+
+class QIODevice;
+
+namespace Calculator {
+
+class CalculatorEngine;
+
+/**
+ * @brief 批处理选项
+ */
+struct BatchOptions {
+    QString inputPath;   // 输入文件路径，空表示标准输入
+    QString outputPath;  // 输出文件路径，空表示标准输出
+    bool keepState;      // 行与行之间保留引擎状态
+    bool expressions;    // 每行是中缀表达式而不是按键序列
+    bool quiet;          // 不输出每行结果，仅用于测量吞吐
+    bool printStats;     // 结束时向标准错误输出统计信息
+    int jobs;            // 表达式模式的工作线程数，1 为单线程，0 为硬件线程数
+    int cacheSlots;      // 双精度运算结果缓存的槽数，0 表示不缓存
+    NumericBackendType numericBackend;  // 按键模式使用的数值后端
+    DecimalContext decimalContext;      // 十进制后端的小数位数与舍入模式
+
+    BatchOptions()
+        : keepState(false)
+        , expressions(false)
+        , quiet(false)
+        , printStats(false)
+        , jobs(1)
+        , cacheSlots(0)
+        , numericBackend(NumericBackendType::Double) {}
+};
+
+/**
+ * @class BatchRunner
+ * @brief 无界面批量求值器
+ * 逐行读取按键序列（字符约定见 KeystrokeReplay.h）或中缀表达式，
+ * 在屏蔽信号的引擎上重放/求值，并输出每行结束时的显示文本。
+ * 表达式模式且 jobs != 1 时改用 ParallelBatchEvaluator 多线程求值。
+ * 仅依赖 core 与 utils 模块，不创建任何 QWidget。
+ */
+class BatchRunner {
+public:
+    explicit BatchRunner(const BatchOptions &options);
+
+    // 执行批处理，返回进程退出码
+    int run();
+
+    // 统计信息
+    qint64 linesProcessed() const { return m_lines; }
+    qint64 keystrokesProcessed() const { return m_keystrokes; }
+    qint64 unknownKeystrokes() const { return m_unknownKeys; }
+
+private:
+    // 处理一行输入
+    void processLine(CalculatorEngine &engine, const char *line, int length);
+
+    // 多线程求值整个输入（仅表达式模式）
+    int runParallel(QIODevice &input, QIODevice &output);
+
+    // 将输出缓冲写入设备
+    bool flushOutput(QIODevice &device);
+
+    // 输出统计信息
+    void reportStats(qint64 elapsedNs) const;
+
+private:
+    BatchOptions m_options;  // 批处理选项
+    QByteArray m_output;     // 输出缓冲
+    qint64 m_lines;          // 已处理行数
+    qint64 m_keystrokes;     // 已处理按键数
+    qint64 m_unknownKeys;    // 无法识别的按键数
+    std::unique_ptr<ResultCache> m_resultCache;  // 结果缓存，cacheSlots 为 0 时为空
+};
+
+} // namespace Calculator
+
+#endif // BATCHRUNNER_H
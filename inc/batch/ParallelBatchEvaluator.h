@@ -0,0 +1,87 @@
+/**
+ * @file ParallelBatchEvaluator.h
+ * @brief 多线程批量表达式求值
+ * @author Jisq
+ * @version 1.0
+ * @date 2025
+ */
+
+#ifndef PARALLELBATCHEVALUATOR_H
+#define PARALLELBATCHEVALUATOR_H
+
+#include "../core/Expression.h"
+#include "../core/ExpressionParser.h"
+#include "../core/ResultCache.h"
+#include "../utils/WorkStealingPool.h"
+#include <QByteArray>
+#include <vector>
+
+namespace Calculator {
+
+/**
+ * @class ParallelBatchEvaluator
+ * @brief 多线程批量表达式求值器
+ * 输入按行切分后每 CHUNK_LINES 行组成一个任务，交给任务窃取线程池执行。
+ * 每个工作线程持有自己的解析器与表达式缓冲（普通对象，不是 QObject），
+ * 各任务把结果写入自己的输出块，最后按输入顺序拼接。
+ */
+class ParallelBatchEvaluator {
+public:
+    /**
+     * @brief 单个工作线程的统计
+     */
+    struct WorkerReport {
+        qint64 lines;       // 求值的行数
+        qint64 chunks;      // 执行的任务块数
+        qint64 steals;      // 窃取次数
+        qint64 busyNs;      // 忙碌时间（纳秒）
+    };
+
+    // threadCount 为 0 时使用硬件线程数
+    explicit ParallelBatchEvaluator(int threadCount = 0);
+
+    /**
+     * @brief 求值 input 中的每一行表达式
+     * @param input 以换行分隔的表达式文本
+     * @param output 按输入顺序追加每行的显示文本；为空指针时只求值不输出
+     */
+    void evaluate(const QByteArray &input, QByteArray *output);
+
+    // 各线程共享的二元运算结果缓存（不持有），空指针表示不缓存
+    void setResultCache(ResultCache *cache) { m_resultCache = cache; }
+
+    int threadCount() const { return m_pool.threadCount(); }
+    qint64 lineCount() const { return m_lineCount; }
+
+    // 最近一次 evaluate() 的各线程统计
+    std::vector<WorkerReport> workerReports() const;
+
+    static const int CHUNK_LINES = 1024;   // 每个任务包含的行数
+
+private:
+    /**
+     * @brief 工作线程私有的求值状态
+     */
+    struct WorkerContext {
+        ExpressionParser parser;    // 解析器
+        Expression expression;      // 复用的表达式缓冲
+        qint64 lines;               // 本次求值的行数
+    };
+
+    // 求值一个任务块
+    void evaluateChunk(int worker, std::size_t chunk);
+
+private:
+    WorkStealingPool m_pool;                    // 线程池
+    std::vector<WorkerContext> m_contexts;      // 各线程的求值状态
+    std::vector<int> m_lineOffsets;             // 每行起始偏移（末尾附加一个哨兵）
+    std::vector<QByteArray> m_chunkOutputs;     // 各任务块的输出
+    const QByteArray *m_input;                  // 当前输入
+    bool m_collectOutput;                       // 是否生成输出
+    ResultCache *m_resultCache;                 // 结果缓存（读者无锁，可并发访问）
+    qint64 m_lineCount;                         // 当前输入的行数
+};
+
+} // namespace Calculator
+
+#endif // PARALLELBATCHEVALUATOR_H
@@ -0,0 +1,75 @@
+/**
+ * @file Arithmetic.h
+ * @brief 四则运算与错误检查
+ * @author Jisq
+ * @version 1.0
+ * @date 2025
+ */
+
+#ifndef ARITHMETIC_H
+#define ARITHMETIC_H
+
+#include "CalculationTypes.h"
+#include "../utils/Constants.h"
+#include <limits>
+
+namespace Calculator {
+
+// 是否为可执行的二元运算符（加减乘除）
+constexpr bool isArithmeticOperator(Operator op) {
+    return op == Operator::Add || op == Operator::Subtract ||
+           op == Operator::Multiply || op == Operator::Divide;
+}
+
+// 检查是否溢出（无穷、非数或超出最大计算值）
+// 非数与任何值比较都为假，因此同一组比较即可同时排除无穷和非数
+// （不用 std::abs，使这些函数可以在常量表达式中求值）
+constexpr bool checkOverflow(double value) {
+    return !(value <= Constants::MAX_CALCULATION_VALUE && value >= -Constants::MAX_CALCULATION_VALUE);
+}
+
+// 检查除数是否为零
+constexpr bool isZeroDivisor(double value) {
+    return value < std::numeric_limits<double>::epsilon() && value > -std::numeric_limits<double>::epsilon();
+}
+
+/**
+ * @brief 执行一次二元运算
+ * 与计算器引擎保持相同的错误语义：除数为零报告 DivisionByZero，
+ * 结果溢出报告 Overflow。出错时 error 被设置且返回值无意义。
+ * 可在常量表达式中求值（编译期折叠的按键序列与运行时结果一致）。
+ */
+constexpr double applyOperator(Operator op, double lhs, double rhs, ErrorType &error) {
+    double result = lhs;
+    switch (op) {
+    case Operator::Add:
+        result = lhs + rhs;
+        break;
+    case Operator::Subtract:
+        result = lhs - rhs;
+        break;
+    case Operator::Multiply:
+        result = lhs * rhs;
+        break;
+    case Operator::Divide:
+        if (isZeroDivisor(rhs)) {
+            error = ErrorType::DivisionByZero;
+            return 0.0;
+        }
+        result = lhs / rhs;
+        break;
+    default:
+        error = ErrorType::SyntaxError;
+        return 0.0;
+    }
+
+    if (checkOverflow(result)) {
+        error = ErrorType::Overflow;
+        return 0.0;
+    }
+    return result;
+}
+
+} // namespace Calculator
+
+#endif // ARITHMETIC_H
@@ -0,0 +1,92 @@
+/**
+ * @file BigInteger.h
+ * @brief 任意精度整数
+ * @author Jisq
+ * @version 1.0
+ * @date 2025
+ */
+
+#ifndef BIGINTEGER_H
+#define BIGINTEGER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Calculator {
+
+/**
+ * @class BigInteger
+ * @brief 任意精度有符号整数
+ * 能放进 int64 的值直接保存在机器字中，加减乘除都先走机器字快速路径，
+ * 只有溢出时才转为 32 位分段的大数表示；大数结果缩回 int64 范围后自动转回机器字。
+ * 大数乘法在两个操作数都足够长时使用 Karatsuba 算法，除法使用 Knuth 算法 D。
+ */
+class BigInteger {
+public:
+    BigInteger();
+    BigInteger(long long value);
+
+    // 解析十进制整数 "[-]digits"，失败时返回false
+    static bool fromString(const char *text, int length, BigInteger &out);
+
+    // 10 的 exponent 次幂（exponent >= 0）
+    static BigInteger powerOfTen(int exponent);
+
+    // 状态查询
+    bool isZero() const { return m_limbs.empty() && m_small == 0; }
+    bool isNegative() const { return m_limbs.empty() ? m_small < 0 : m_negative; }
+    bool isSmall() const { return m_limbs.empty(); }
+    long long smallValue() const { return m_small; }
+    int sign() const { return isZero() ? 0 : (isNegative() ? -1 : 1); }
+
+    // 二进制位数（绝对值）
+    int bitLength() const;
+
+    // 转换
+    double toDouble() const;
+    std::string toString() const;
+
+    // 运算
+    BigInteger operator-() const;
+    BigInteger abs() const;
+    BigInteger shiftedLeft(int bits) const;
+
+    friend BigInteger operator+(const BigInteger &a, const BigInteger &b);
+    friend BigInteger operator-(const BigInteger &a, const BigInteger &b);
+    friend BigInteger operator*(const BigInteger &a, const BigInteger &b);
+
+    // 截断除法：quotient 向零取整，remainder 与被除数同号；divisor 不能为零
+    static void divide(const BigInteger &dividend, const BigInteger &divisor,
+                       BigInteger &quotient, BigInteger &remainder);
+
+    // 最大公约数（非负）
+    static BigInteger gcd(const BigInteger &a, const BigInteger &b);
+
+    // 比较：返回 -1 / 0 / 1
+    static int compare(const BigInteger &a, const BigInteger &b);
+
+    friend bool operator==(const BigInteger &a, const BigInteger &b) { return compare(a, b) == 0; }
+    friend bool operator!=(const BigInteger &a, const BigInteger &b) { return compare(a, b) != 0; }
+    friend bool operator<(const BigInteger &a, const BigInteger &b) { return compare(a, b) < 0; }
+
+    static const int KARATSUBA_THRESHOLD = 32;  // 使用 Karatsuba 乘法的最小分段数
+
+private:
+    typedef std::vector<std::uint32_t> Magnitude;
+
+    // 由绝对值与符号构造，并在可能时缩回机器字表示
+    static BigInteger fromMagnitude(Magnitude &&magnitude, bool negative);
+
+    // 取绝对值的分段表示
+    Magnitude magnitude() const;
+
+private:
+    long long m_small;          // 机器字表示的值（m_limbs 为空时有效）
+    Magnitude m_limbs;          // 大数绝对值，低位在前，无前导零
+    bool m_negative;            // 大数符号
+};
+
+} // namespace Calculator
+
+#endif // BIGINTEGER_H
@@ -0,0 +1,68 @@
+/**
+ * @file BigRational.h
+ * @brief 任意精度有理数
+ * @author Jisq
+ * @version 1.0
+ * @date 2025
+ */
+
+#ifndef BIGRATIONAL_H
+#define BIGRATIONAL_H
+
+#include "BigInteger.h"
+#include <string>
+
+namespace Calculator {
+
+/**
+ * @class BigRational
+ * @brief 以最简分数表示的任意精度有理数
+ * 分母恒为正且与分子互素。分子分母都是 BigInteger，
+ * 小数值的运算全程停留在机器字中。
+ */
+class BigRational {
+public:
+    BigRational();
+    BigRational(const BigInteger &integer);
+    BigRational(const BigInteger &numerator, const BigInteger &denominator);
+
+    // 解析十进制数 "[-]digits[.digits][e[+-]digits]"，结果精确无舍入
+    static bool fromDecimal(const char *text, int length, BigRational &out);
+
+    const BigInteger &numerator() const { return m_numerator; }
+    const BigInteger &denominator() const { return m_denominator; }
+
+    bool isZero() const { return m_numerator.isZero(); }
+    bool isInteger() const { return m_denominator == BigInteger(1); }
+    int sign() const { return m_numerator.sign(); }
+
+    // 双精度近似值
+    double toDouble() const;
+
+    /**
+     * @brief 十进制文本
+     * 整数精确输出全部位数；非整数按 significantDigits 位有效数字四舍五入，
+     * 整数部分始终完整保留，绝对值小于 1e-4 时使用科学计数法，末尾零被移除。
+     */
+    std::string toDecimalString(int significantDigits) const;
+
+    BigRational operator-() const;
+
+    friend BigRational operator+(const BigRational &a, const BigRational &b);
+    friend BigRational operator-(const BigRational &a, const BigRational &b);
+    friend BigRational operator*(const BigRational &a, const BigRational &b);
+    // 除数不能为零
+    friend BigRational operator/(const BigRational &a, const BigRational &b);
+
+private:
+    // 约分并使分母为正
+    void normalize();
+
+private:
+    BigInteger m_numerator;     // 分子
+    BigInteger m_denominator;   // 分母（恒为正）
+};
+
+} // namespace Calculator
+
+#endif // BIGRATIONAL_H
@@ -36,6 +36,15 @@ enum class ErrorType {
     SyntaxError     // 语法错误
 };
 
+/**
+ * @brief 数值后端类型
+ */
+enum class NumericBackendType {
+    Double,     // 双精度浮点（默认，结果限制在 ±1e15 以内）
+    Rational,   // 任意精度有理数（整数与分数结果精确）
+    Decimal     // 128 位十进制定点数（固定小数位数，适合金额计算）
+};
+
 /**
  * @brief 按钮类型
  */
@@ -57,7 +66,7 @@ struct CalculatorState {
     bool waitingForOperand;   // 等待操作数输入
     ErrorType error;          // 错误状态
 
-    CalculatorState() 
+    constexpr CalculatorState()
         : currentValue(0.0)
         , storedValue(0.0)
         , pendingOperator(Operator::None)
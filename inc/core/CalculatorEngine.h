@@ -10,16 +10,28 @@
 #define CALCULATORENGINE_H
 
 #include "CalculationTypes.h"
+#include "EngineCore.h"
+#include "Expression.h"
+#include "ExpressionParser.h"
+#include "NumericBackend.h"
 #include <QObject>
 #include <QString>
+#include <memory>
 
 namespace Calculator {
 
+class HistoryLog;
+class ResultCache;
+
 /**
  * @class CalculatorEngine
  * @brief 计算器核心逻辑引擎
  * 负责处理所有计算逻辑，包括四则运算、错误处理、状态管理等。
  * 采用MVC模式，与界面层完全分离。
+ * 按键状态机由 EngineCore 实现，本类只是它的 Qt 适配层：把转换产生的变化转为信号，
+ * 并在运算时接入结果缓存、历史记录与数值后端。
+ * 默认以双精度计算；通过 setNumericBackend() 可为单个引擎实例切换数值后端，
+ * 如任意精度有理数后端可精确计算超过 1e15 的结果。表达式求值始终使用双精度。
  */
 class CalculatorEngine : public QObject {
     Q_OBJECT
@@ -29,9 +41,29 @@ public:
     ~CalculatorEngine() = default;
 
     // 状态访问
-    CalculatorState getState() const { return m_state; }
+    CalculatorState getState() const;
     QString getDisplayText() const;
-    bool hasError() const { return m_state.error != ErrorType::NoError; }
+    bool hasError() const { return m_core.hasError(); }
+
+    // 数值后端（切换后引擎状态被重置）
+    void setNumericBackend(NumericBackendType type);
+    void setNumericBackend(std::unique_ptr<NumericBackend> backend);
+    NumericBackendType numericBackendType() const;
+    const NumericBackend *numericBackend() const { return m_backend.get(); }
+
+    // 历史记录：每次完成的二元运算（含出错的运算）追加一条，引擎不持有日志，传入 nullptr 停止记录
+    void setHistoryLog(HistoryLog *log) { m_history = log; }
+    HistoryLog *historyLog() const { return m_history; }
+
+    // 设置双精度运算的结果缓存（不持有，可由多个引擎共享），空指针表示不缓存
+    void setResultCache(ResultCache *cache) { m_resultCache = cache; }
+    ResultCache *resultCache() const { return m_resultCache; }
+
+    // 格式化数字为显示文本（与显示面板一致）
+    static QString formatNumber(double value);
+    
+    // 错误类型对应的显示文本
+    static QString errorText(ErrorType error);
 
 public slots:
     // 处理数字输入槽函数
@@ -57,20 +89,46 @@ public slots:
     
     // 改变正负号槽函数
     void changeSign();
+    
+    // 求值完整的中缀表达式槽函数（结果如同按下等号后的状态）
+    void evaluateExpression(const QString &expression);
 
 signals:
-    // 显示内容改变信号
+    // 显示内容改变信号（仅在有接收者时才格式化显示文本）
     void displayChanged(const QString &displayText);
     
+    // 显示内容失效信号，不携带文本，供需要延迟刷新的界面使用
+    void displayInvalidated();
+    
     // 错误发生信号
     void errorOccurred(ErrorType errorType);
     
     // 状态更新信号
     void stateUpdated(const CalculatorState &state);
+    
+    // 历史记录追加信号（仅在设置了历史记录时发射）
+    void historyAppended();
 
 private:
-    // 执行计算
-    void calculate();
+    // 交给 EngineCore 的运算函数对象
+    struct Arithmetic {
+        CalculatorEngine *engine;
+        double operator()(Operator op, double lhs, double rhs, ErrorType &error) const {
+            return engine->applyArithmetic(op, lhs, rhs, error);
+        }
+    };
+    
+    // 执行一次运算（经过结果缓存或数值后端，并追加历史记录）
+    double applyArithmetic(Operator op, double lhs, double rhs, ErrorType &error);
+    
+    // 使用数值后端执行运算，返回结果的双精度近似值
+    double applyBackend(Operator op, ErrorType &error);
+    
+    // 把正在输入的操作数同步到数值后端，文本无法解析时返回 false
+    bool syncBackendOperand();
+    
+    // 编辑后端结果或覆盖后端操作数前把后端的文本写入输入缓冲
+    void prepareBackendEdit();
     
     // 重置计算器状态
     void reset();
@@ -78,16 +136,20 @@ private:
     // 设置错误状态
     void setError(ErrorType error);
     
-    // 格式化数字为字符串
-    QString formatNumber(double value) const;
+    // 把 EngineCore 转换产生的变化转为信号
+    void applyEffects(unsigned effects);
     
-    // 检查是否溢出
-    bool checkOverflow(double value) const;
+    // 发射显示内容改变信号（信号被屏蔽时不做格式化）
+    void notifyDisplayChanged();
 
 private:
-    CalculatorState m_state;        // 计算器状态
-    QString m_currentInput;         // 当前输入字符串
-    bool m_hasDecimal;              // 是否已输入小数点
+    EngineCore m_core;              // 按键状态机（状态与输入缓冲）
+    ExpressionParser m_parser;      // 表达式解析器
+    Expression m_expression;        // 复用的表达式缓冲
+    std::unique_ptr<NumericBackend> m_backend;  // 数值后端，空表示双精度
+    bool m_backendOperandSynced;    // 后端的当前操作数是否与输入一致
+    HistoryLog *m_history;          // 历史记录，空表示不记录
+    ResultCache *m_resultCache;     // 结果缓存，空表示直接计算
 };
 
 } // namespace Calculator
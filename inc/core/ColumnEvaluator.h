@@ -0,0 +1,64 @@
+/**
+ * @file ColumnEvaluator.h
+ * @brief 公式的按列向量化求值
+ * @author Jisq
+ * @version 1.0
+ * @date 2025
+ */
+
+#ifndef COLUMNEVALUATOR_H
+#define COLUMNEVALUATOR_H
+
+#include "Expression.h"
+#include "ExpressionProgram.h"
+#include <cstddef>
+#include <vector>
+
+namespace Calculator {
+
+/**
+ * @class ColumnEvaluator
+ * @brief 按列求值器
+ * 把公式编译为 ExpressionProgram 后，按块对整列数据逐条执行指令，
+ * 每条指令由 SIMD 内核（运行时根据 CPU 选择 AVX2 / SSE2 / 标量）处理一整块元素。
+ * 除零与溢出检查以向量掩码完成，结果写入逐元素的 ErrorType 列：
+ * 某一行出错不会中断整批计算，出错行的结果为 0。
+ */
+class ColumnEvaluator {
+public:
+    ColumnEvaluator();
+
+    // 解析并编译公式，失败时返回false
+    bool compile(const char *formula, int length);
+
+    // 变量信息（列的顺序与变量下标一致）
+    int variableCount() const { return m_expression.variableCount(); }
+    int variableIndex(const std::string &name) const { return m_expression.variableIndex(name); }
+
+    /**
+     * @brief 对列数据求值
+     * @param columns 每个变量一列（至少 variableCount() 列），columns[i] 指向 rows 个元素
+     * @param rows 行数
+     * @param results 输出结果列（rows 个元素）
+     * @param errors 输出错误列（rows 个元素）
+     */
+    void evaluate(const double *const *columns, std::size_t rows,
+                  double *results, ErrorType *errors) const;
+
+    // 便捷接口：列数少于 variableCount() 或各列长度不同时返回false，结果与错误列被清空
+    bool evaluate(const std::vector<std::vector<double> > &columns,
+                  std::vector<double> &results, std::vector<ErrorType> &errors) const;
+
+    // 当前 CPU 上选用的内核名称（"avx2"、"sse2" 或 "scalar"）
+    static const char *kernelName();
+
+    static const std::size_t BLOCK_SIZE = 512;  // 每块处理的行数
+
+private:
+    Expression m_expression;        // 公式语法树（保存变量名）
+    ExpressionProgram m_program;    // 编译后的指令
+};
+
+} // namespace Calculator
+
+#endif // COLUMNEVALUATOR_H
@@ -0,0 +1,111 @@
+/**
+ * @file Decimal128.h
+ * @brief 128 位十进制定点数
+ * @author Jisq
+ * @version 1.0
+ * @date 2025
+ */
+
+#ifndef DECIMAL128_H
+#define DECIMAL128_H
+
+#include "CalculationTypes.h"
+#include <cstdint>
+#include <string>
+
+namespace Calculator {
+
+/**
+ * @brief 舍入模式
+ */
+enum class RoundingMode {
+    HalfEven,   // 四舍六入五成双（银行家舍入）
+    HalfUp,     // 四舍五入
+    Down,       // 向零截断
+    Up,         // 远离零
+    Ceiling,    // 向正无穷
+    Floor       // 向负无穷
+};
+
+/**
+ * @brief 十进制运算上下文
+ * 值以 10^-scale 为单位保存，同一后端内所有值共用一个上下文。
+ */
+struct DecimalContext {
+    int scale;              // 小数位数，范围 [0, MAX_SCALE]
+    RoundingMode rounding;  // 乘除与解析时的舍入模式
+
+    static const int DEFAULT_SCALE = 10;
+    static const int MAX_SCALE = 18;
+
+    DecimalContext()
+        : scale(DEFAULT_SCALE)
+        , rounding(RoundingMode::HalfEven) {}
+
+    DecimalContext(int scaleValue, RoundingMode roundingMode)
+        : scale(scaleValue < 0 ? 0 : (scaleValue > MAX_SCALE ? MAX_SCALE : scaleValue))
+        , rounding(roundingMode) {}
+};
+
+/**
+ * @class Decimal128
+ * @brief 128 位十进制定点数
+ * 以符号加 128 位无符号整数（单位 10^-scale）表示，绝对值最多 38 位十进制数字。
+ * 只使用整数运算：加减是带进位的双字运算，乘除先得到 256 位中间结果再按上下文舍入。
+ * 编译器支持 __int128 时使用原生 128 位乘除，否则退回 32 位分段的可移植实现。
+ */
+class Decimal128 {
+public:
+    Decimal128()
+        : m_low(0)
+        , m_high(0)
+        , m_negative(false) {}
+
+    // 由十进制文本解析（支持小数与科学计数法），超出精度的位按上下文舍入
+    static bool parse(const char *text, int length, const DecimalContext &context, Decimal128 &out);
+
+    // 由整数构造（单位为 1）
+    static Decimal128 fromInteger(long long value, const DecimalContext &context);
+
+    bool isZero() const { return m_low == 0 && m_high == 0; }
+    bool isNegative() const { return m_negative; }
+
+    Decimal128 operator-() const {
+        Decimal128 result(*this);
+        result.m_negative = !m_negative && !isZero();
+        return result;
+    }
+
+    // 四则运算，结果超出 38 位时返回 Overflow，除数为零返回 DivisionByZero
+    static ErrorType add(const Decimal128 &lhs, const Decimal128 &rhs, Decimal128 &result);
+    static ErrorType subtract(const Decimal128 &lhs, const Decimal128 &rhs, Decimal128 &result);
+    static ErrorType multiply(const Decimal128 &lhs, const Decimal128 &rhs,
+                              const DecimalContext &context, Decimal128 &result);
+    static ErrorType divide(const Decimal128 &lhs, const Decimal128 &rhs,
+                            const DecimalContext &context, Decimal128 &result);
+
+    // 比较：返回 -1 / 0 / 1
+    static int compare(const Decimal128 &lhs, const Decimal128 &rhs);
+
+    friend bool operator==(const Decimal128 &lhs, const Decimal128 &rhs) { return compare(lhs, rhs) == 0; }
+    friend bool operator!=(const Decimal128 &lhs, const Decimal128 &rhs) { return compare(lhs, rhs) != 0; }
+
+    // 转换
+    double toDouble(int scale) const;
+    std::string toString(int scale) const;
+
+    // 写入十进制文本（不含结尾 '\0'），返回长度；buffer 至少 MAX_TEXT_LENGTH 字节
+    int format(int scale, char *buffer) const;
+
+    static const int MAX_DIGITS = 38;
+    static const int MAX_TEXT_LENGTH = MAX_DIGITS + 3;  // 符号、小数点与前导零
+
+private:
+    std::uint64_t m_low;    // 绝对值低 64 位
+    std::uint64_t m_high;   // 绝对值高 64 位
+    bool m_negative;        // 符号（零恒为非负）
+};
+
+} // namespace Calculator
+
+#endif // DECIMAL128_H
@@ -0,0 +1,557 @@
+/**
+ * @file EngineCore.h
+ * @brief 与 Qt 对象无关的计算器按键状态机
+ * @author Jisq
+ * @version 1.0
+ * @date 2025
+ */
+
+#ifndef ENGINECORE_H
+#define ENGINECORE_H
+
+#include "Arithmetic.h"
+#include "CalculationTypes.h"
+#include "../utils/Constants.h"
+#include "../utils/NumberFormatter.h"
+#include "../utils/NumberParser.h"
+#include <cstdint>
+
+namespace Calculator {
+
+/**
+ * @struct EngineCore
+ * @brief 双精度计算器的全部状态与按键转换
+ *
+ * 纯值类型：没有虚函数、信号与堆分配，可以按值复制，多个实例互不影响，
+ * 适合在一个进程中同时保存成千上万个独立的计算器。输入文本保存在定长缓冲中，
+ * 按键时增量累积尾数与十进制指数，数值在需要时才计算；
+ * 运算结果只保存精确值，文本在显示或继续编辑时才格式化。
+ *
+ * 每个转换返回 Effect 的按位或，说明调用方需要通知的变化；
+ * CalculatorEngine 把它们转换为 Qt 信号。需要缓存或记录运算时，
+ * inputOperator() / inputEquals() 接受自定义的运算函数对象，
+ * 签名与 applyOperator() 相同。
+ *
+ * 所有转换都是 constexpr，固定的按键序列可以在编译期折叠（见 KeystrokeReplay.h 的
+ * foldKeystrokes()），结果与运行时逐键输入完全相同。只有两种情况必须在运行时求值：
+ * 超过 19 位有效数字或非 [-]digits[.digits] 形式的输入文本的解析，
+ * 以及继续编辑非整数（或为零）的运算结果时的格式化。
+ */
+struct EngineCore {
+    static constexpr int INPUT_CAPACITY = 32;       // 输入缓冲长度（超出的按键被忽略）
+    static constexpr int MAX_MANTISSA_DIGITS = 19;  // uint64 可容纳的十进制位数
+
+    // 转换产生的变化
+    enum Effect : unsigned {
+        NoEffect = 0,
+        DisplayChanged = 1u << 0,   // 显示内容改变
+        StateChanged = 1u << 1,     // state 的公开字段改变（对应 stateUpdated 信号）
+        ErrorRaised = 1u << 2,      // 进入错误状态，错误类型见 state.error
+        Reset = 1u << 3             // 错误后的按键使状态被重置
+    };
+
+    // 直接计算的运算函数对象
+    struct DirectArithmetic {
+        constexpr double operator()(Operator op, double lhs, double rhs, ErrorType &error) const {
+            return applyOperator(op, lhs, rhs, error);
+        }
+    };
+
+    CalculatorState state;          // 计算器状态（currentValue 可能落后于输入，见 operandDirty）
+    char input[INPUT_CAPACITY];     // 当前输入文本（不以 '\0' 结尾）
+    std::uint8_t inputLength;       // 输入文本长度
+    bool inputTextValid;            // 为假时输入是尚未格式化的运算结果 inputValue
+    bool inputValueValid;           // inputValue 是否与输入一致
+    bool hasDecimal;                // 是否已输入小数点
+    bool operandDirty;              // state.currentValue 是否落后于输入
+    double inputValue;              // 输入的精确值（inputValueValid 为真时有效）
+
+    // 输入文本的增量累积状态（规则与 NumberParser 相同）
+    std::uint64_t mantissa;         // 前 19 位有效数字
+    std::int16_t exponent;          // 十进制指数修正（小数位为负）
+    std::uint8_t mantissaDigits;    // 已计入尾数的有效数字位数
+    bool truncated;                 // 是否有非零数字未计入尾数
+    bool negative;                  // 前导负号
+    bool fraction;                  // 已出现小数点
+    bool plain;                     // 文本是否为 [-]digits[.digits] 形式
+
+    constexpr EngineCore()
+        : state()
+        , input()
+        , inputLength(0)
+        , inputTextValid(true)
+        , inputValueValid(true)
+        , hasDecimal(false)
+        , operandDirty(false)
+        , inputValue(0.0)
+        , mantissa(0)
+        , exponent(0)
+        , mantissaDigits(0)
+        , truncated(false)
+        , negative(false)
+        , fraction(false)
+        , plain(true) {}
+
+    constexpr bool hasError() const { return state.error != ErrorType::NoError; }
+
+    // ---- 按键转换 ----
+
+    constexpr unsigned inputDigit(int digit) {
+        unsigned effects = DisplayChanged;
+        if (state.error != ErrorType::NoError) {
+            reset();
+            effects |= Reset | StateChanged;
+        }
+
+        if (state.waitingForOperand) {
+            setInputDigit(digit);
+            state.waitingForOperand = false;
+            hasDecimal = false;
+        } else {
+            ensureInputText();
+            if (inputIsZero()) {
+                setInputDigit(digit);
+            } else {
+                appendInputDigit(digit);
+            }
+        }
+
+        // 数值由输入缓冲增量维护，用到时再取
+        operandDirty = true;
+        return effects;
+    }
+
+    template <typename Apply>
+    constexpr unsigned inputOperator(Operator op, Apply apply) {
+        if (state.error != ErrorType::NoError) {
+            return NoEffect;
+        }
+
+        unsigned effects = NoEffect;
+        if (!state.waitingForOperand) {
+            effects |= calculate(apply);
+        }
+
+        syncOperandValue();
+        if (state.error == ErrorType::NoError) {
+            state.pendingOperator = op;
+            state.storedValue = state.currentValue;
+            state.waitingForOperand = true;
+            hasDecimal = false;
+            effects |= StateChanged;
+        }
+        return effects;
+    }
+
+    constexpr unsigned inputOperator(Operator op) {
+        return inputOperator(op, DirectArithmetic());
+    }
+
+    template <typename Apply>
+    constexpr unsigned inputEquals(Apply apply) {
+        if (state.error != ErrorType::NoError || state.pendingOperator == Operator::None) {
+            return NoEffect;
+        }
+
+        unsigned effects = NoEffect;
+        if (!state.waitingForOperand) {
+            effects |= calculate(apply);
+        }
+
+        if (state.error == ErrorType::NoError) {
+            state.pendingOperator = Operator::None;
+            state.waitingForOperand = false;
+            effects |= StateChanged;
+        }
+        return effects;
+    }
+
+    constexpr unsigned inputEquals() {
+        return inputEquals(DirectArithmetic());
+    }
+
+    constexpr unsigned inputDecimal() {
+        unsigned effects = NoEffect;
+        if (state.error != ErrorType::NoError) {
+            reset();
+            effects |= Reset | StateChanged;
+        }
+
+        if (state.waitingForOperand) {
+            setInputDigit(0);
+            state.waitingForOperand = false;
+            hasDecimal = false;
+        }
+
+        if (!hasDecimal) {
+            // 小数点不改变当前值，先按追加前的文本取值
+            syncOperandValue();
+            ensureInputText();
+            appendInputDecimalPoint();
+            hasDecimal = true;
+            effects |= DisplayChanged;
+        }
+        return effects;
+    }
+
+    constexpr unsigned clearEntry() {
+        clearInput();
+        state.currentValue = 0.0;
+        operandDirty = false;
+        hasDecimal = false;
+        state.waitingForOperand = true;
+        return DisplayChanged;
+    }
+
+    constexpr unsigned clearAll() {
+        reset();
+        return Reset | StateChanged | DisplayChanged;
+    }
+
+    constexpr unsigned backspace() {
+        if (state.waitingForOperand || state.error != ErrorType::NoError) {
+            return NoEffect;
+        }
+
+        // 删除最后一个字符
+        ensureInputText();
+        if (inputLength > 1) {
+            if (input[inputLength - 1] == '.') {
+                hasDecimal = false;
+            }
+            chopInput();
+            operandDirty = true;
+        } else {
+            clearInput();
+            state.currentValue = 0.0;
+            operandDirty = false;
+            state.waitingForOperand = true;
+        }
+        return DisplayChanged;
+    }
+
+    constexpr unsigned changeSign() {
+        if (state.error != ErrorType::NoError) {
+            return NoEffect;
+        }
+
+        if (state.waitingForOperand) {
+            state.storedValue = -state.storedValue;
+            state.currentValue = state.storedValue;
+        } else {
+            syncOperandValue();
+            state.currentValue = -state.currentValue;
+            assignResult(state.currentValue);
+        }
+        return DisplayChanged;
+    }
+
+    // ---- 状态访问 ----
+
+    // 当前状态（currentValue 已与输入同步）
+    constexpr CalculatorState currentState() const {
+        CalculatorState result = state;
+        if (operandDirty) {
+            result.currentValue = inputNumber();
+        }
+        return result;
+    }
+
+    // 显示文本写入 buffer（至少 NumberFormatter::BUFFER_SIZE 字节），返回长度；
+    // 错误状态下返回 0，错误文本由调用方决定
+    constexpr int displayText(char *buffer) const {
+        if (state.error != ErrorType::NoError) {
+            return 0;
+        }
+        if (state.waitingForOperand) {
+            return formatValue(state.storedValue, buffer);
+        }
+        if (!inputTextValid) {
+            return formatValue(inputValue, buffer);
+        }
+        if (inputLength == 0) {
+            buffer[0] = '0';
+            return 1;
+        }
+        for (int i = 0; i < inputLength; ++i) {
+            buffer[i] = input[i];
+        }
+        return inputLength;
+    }
+
+    // ---- 供适配层组合转换的基本操作 ----
+
+    // 重置为初始状态
+    constexpr void reset() {
+        *this = EngineCore();
+    }
+
+    // 执行待处理的运算；成功时结果成为输入并等待下一个操作数
+    template <typename Apply>
+    constexpr unsigned calculate(Apply apply) {
+        syncOperandValue();
+        if (!isArithmeticOperator(state.pendingOperator)) {
+            return NoEffect;
+        }
+
+        ErrorType error = ErrorType::NoError;
+        const double result = apply(state.pendingOperator, state.storedValue, state.currentValue, error);
+        if (error != ErrorType::NoError) {
+            state.error = error;
+            return ErrorRaised;
+        }
+
+        state.currentValue = result;
+        state.storedValue = 0.0;
+        assignResult(result);
+        state.waitingForOperand = true;
+        return NoEffect;
+    }
+
+    // 把输入的数值写回 state.currentValue
+    constexpr void syncOperandValue() {
+        if (operandDirty) {
+            state.currentValue = inputNumber();
+            operandDirty = false;
+        }
+    }
+
+    // 以运算结果替换输入，文本延迟到显示或编辑时再格式化
+    constexpr void assignResult(double value) {
+        inputLength = 0;
+        inputTextValid = false;
+        inputValue = value;
+        inputValueValid = true;
+        operandDirty = false;
+    }
+
+    // 以外部求得的值（如表达式的结果）作为当前值，如同刚输入了这个数
+    constexpr unsigned loadResult(double value) {
+        state.currentValue = value;
+        assignResult(value);
+        state.waitingForOperand = false;
+        return StateChanged | DisplayChanged;
+    }
+
+    // 以给定文本替换输入，value 为其精确值；文本超出缓冲时返回 false 且输入不变
+    constexpr bool assignText(const char *text, int length, double value) {
+        if (length < 0 || length > INPUT_CAPACITY) {
+            return false;
+        }
+        for (int i = 0; i < length; ++i) {
+            input[i] = text[i];
+        }
+        inputLength = static_cast<std::uint8_t>(length);
+        inputTextValid = true;
+        rescan();
+        inputValue = value;
+        inputValueValid = true;
+        operandDirty = false;
+        return true;
+    }
+
+    // 把尚未格式化的运算结果写成文本（与显示相同的 15 位有效数字）
+    constexpr void ensureInputText() {
+        if (inputTextValid) {
+            return;
+        }
+        char text[NumberFormatter::BUFFER_SIZE] = {};
+        const int length = formatValue(inputValue, text);
+        const double value = inputValue;
+        assignText(text, length, value);
+    }
+
+    // 输入对应的数值（文本无法解析时为 0）
+    constexpr double inputNumber() const {
+        if (inputValueValid) {
+            return inputValue;
+        }
+
+        if (plain && !truncated && mantissa == 0) {
+            // 全零；没有任何数字（如 "-"）的文本无效，取 0
+            bool hasDigit = false;
+            for (int i = 0; i < inputLength; ++i) {
+                hasDigit = hasDigit || (input[i] >= '0' && input[i] <= '9');
+            }
+            return negative && hasDigit ? -0.0 : 0.0;
+        }
+        if (plain && !truncated && mantissa <= (1ull << 53) && exponent >= -NumberParser::MAX_EXACT_POWER) {
+            // 快速路径：一次精确的除法即得到正确舍入的结果
+            double magnitude = static_cast<double>(mantissa);
+            if (exponent < 0) {
+                magnitude /= NumberParser::exactPowerOfTen(-exponent);
+            }
+            return negative ? -magnitude : magnitude;
+        }
+        return parseInput();
+    }
+
+    // 格式化为显示文本（15 位有效数字）。绝对值小于 10^15 的非零整数在这里直接写出，
+    // 可以在常量表达式中求值；其余交给 NumberFormatter（零的符号在常量表达式中无法区分）
+    static constexpr int formatValue(double value, char *buffer) {
+        const double limit = NumberParser::exactPowerOfTen(Constants::MAX_DISPLAY_LENGTH);
+        if (value != 0.0 && value > -limit && value < limit
+            && value == static_cast<double>(static_cast<std::int64_t>(value))) {
+            std::uint64_t magnitude = static_cast<std::uint64_t>(value < 0.0 ? -value : value);
+            int length = 0;
+            if (value < 0.0) {
+                buffer[length++] = '-';
+            }
+            char digits[Constants::MAX_DISPLAY_LENGTH] = {};
+            int count = 0;
+            do {
+                digits[count++] = static_cast<char>('0' + magnitude % 10);
+                magnitude /= 10;
+            } while (magnitude != 0);
+            while (count > 0) {
+                buffer[length++] = digits[--count];
+            }
+            return length;
+        }
+        return NumberFormatter::format(value, buffer, Constants::MAX_DISPLAY_LENGTH);
+    }
+
+private:
+    constexpr bool inputIsZero() const {
+        return inputLength == 1 && input[0] == '0';
+    }
+
+    constexpr void clearInput() {
+        inputLength = 0;
+        inputTextValid = true;
+        inputValue = 0.0;
+        inputValueValid = true;
+        mantissa = 0;
+        exponent = 0;
+        mantissaDigits = 0;
+        truncated = false;
+        negative = false;
+        fraction = false;
+        plain = true;
+    }
+
+    constexpr void setInputDigit(int digit) {
+        clearInput();
+        appendInputDigit(digit);
+    }
+
+    constexpr void appendInputDigit(int digit) {
+        if (inputLength >= INPUT_CAPACITY) {
+            return;
+        }
+        input[inputLength++] = static_cast<char>('0' + digit);
+        inputValueValid = false;
+        if (plain) {
+            accumulate(digit, fraction);
+        }
+    }
+
+    constexpr void appendInputDecimalPoint() {
+        if (inputLength >= INPUT_CAPACITY) {
+            return;
+        }
+        input[inputLength++] = '.';
+        inputValueValid = false;
+        if (fraction) {
+            plain = false;  // 第二个小数点使文本无效
+        }
+        fraction = true;
+    }
+
+    // 删除最后一个字符
+    constexpr void chopInput() {
+        if (inputLength == 0) {
+            return;
+        }
+        const char last = input[--inputLength];
+        inputValueValid = false;
+
+        // 尾数未满时每个数字都计入了尾数，可以直接撤销
+        if (plain && !truncated && mantissaDigits < MAX_MANTISSA_DIGITS) {
+            if (last == '.') {
+                fraction = false;
+                return;
+            }
+            if (last >= '0' && last <= '9') {
+                if (mantissa != 0) {
+                    mantissa /= 10;
+                    --mantissaDigits;
+                }
+                if (fraction) {
+                    ++exponent;
+                }
+                return;
+            }
+        }
+        rescan();
+    }
+
+    // 累积一个数字（与 NumberParser 相同的规则，保证两者得到同样的数值）
+    constexpr void accumulate(int digit, bool inFraction) {
+        if (mantissaDigits < MAX_MANTISSA_DIGITS) {
+            if (mantissa != 0 || digit != 0) {
+                mantissa = mantissa * 10 + static_cast<std::uint64_t>(digit);
+                ++mantissaDigits;
+            }
+            if (inFraction) {
+                --exponent;
+            }
+        } else {
+            if (!inFraction) {
+                ++exponent;
+            }
+            truncated = truncated || digit != 0;
+        }
+    }
+
+    // 由文本重新计算累积状态
+    constexpr void rescan() {
+        mantissa = 0;
+        exponent = 0;
+        mantissaDigits = 0;
+        truncated = false;
+        negative = false;
+        fraction = false;
+        plain = true;
+        inputValueValid = false;
+
+        int pos = 0;
+        if (pos < inputLength && input[pos] == '-') {
+            negative = true;
+            ++pos;
+        }
+        for (; pos < inputLength; ++pos) {
+            const char c = input[pos];
+            if (c >= '0' && c <= '9') {
+                accumulate(c - '0', fraction);
+            } else if (c == '.' && !fraction) {
+                fraction = true;
+            } else {
+                plain = false;  // 科学计数法或无效文本
+                return;
+            }
+        }
+    }
+
+    // 对整段文本做完整解析，与 QString::toDouble() 一致：整段都必须是合法数字，否则为 0
+    double parseInput() const {
+        const char *text = input;
+        int length = inputLength;
+        bool negativeText = false;
+        if (length > 0 && (text[0] == '-' || text[0] == '+')) {
+            negativeText = text[0] == '-';
+            ++text;
+            --length;
+        }
+
+        double magnitude = 0.0;
+        if (length == 0 || NumberParser::parse(text, length, magnitude) != length) {
+            return 0.0;
+        }
+        return negativeText ? -magnitude : magnitude;
+    }
+};
+
+} // namespace Calculator
+
+#endif // ENGINECORE_H
@@ -0,0 +1,101 @@
+/**
+ * @file Expression.h
+ * @brief 已编译的中缀表达式
+ * @author Jisq
+ * @version 1.0
+ * @date 2025
+ */
+
+#ifndef EXPRESSION_H
+#define EXPRESSION_H
+
+#include "CalculationTypes.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Calculator {
+
+class ResultCache;
+
+/**
+ * @brief 表达式语法树节点类型
+ */
+enum class NodeKind : std::uint8_t {
+    Constant,   // 数字常量
+    Variable,   // 变量引用
+    Negate,     // 一元负号
+    Binary      // 二元运算
+};
+
+/**
+ * @brief 表达式语法树节点
+ * 节点按后序保存在连续数组中，子节点总是排在父节点之前，用下标而不是指针相互引用。
+ */
+struct ExpressionNode {
+    NodeKind kind;      // 节点类型
+    Operator op;        // 二元运算符（仅 Binary 有效）
+    std::int32_t lhs;   // 左子节点下标 / 变量下标 / 负号的操作数
+    std::int32_t rhs;   // 右子节点下标（仅 Binary 有效）
+    double value;       // 常量值（仅 Constant 有效）
+};
+
+/**
+ * @class Expression
+ * @brief 解析后的表达式
+ * 一次解析、多次求值：语法树以后序扁平数组保存，求值时顺序扫描数组并使用
+ * 栈上的操作数栈，不递归、不分配内存，也不再涉及字符串处理。
+ * 变量按首次出现的顺序编号，求值时通过下标数组传入取值。
+ */
+class Expression {
+public:
+    Expression();
+
+    // 是否包含有效的语法树
+    bool isValid() const { return !m_nodes.empty(); }
+
+    // 求值，出错时设置 error（除零、溢出）并返回 0
+    double evaluate(const double *variables, ErrorType &error) const;
+
+    // 无变量表达式的求值
+    double evaluate(ErrorType &error) const { return evaluate(nullptr, error); }
+
+    // 二元运算经由结果缓存求值（cache 为空时与不带缓存的版本相同）
+    double evaluate(const double *variables, ErrorType &error, ResultCache *cache) const;
+
+    // 变量访问
+    int variableCount() const { return static_cast<int>(m_variables.size()); }
+    const std::string &variableName(int index) const { return m_variables[index]; }
+    int variableIndex(const std::string &name) const;
+
+    // 语法树访问（根节点为最后一个节点）
+    const std::vector<ExpressionNode> &nodes() const { return m_nodes; }
+    int rootIndex() const { return static_cast<int>(m_nodes.size()) - 1; }
+
+    // 求值所需的操作数栈深度
+    int stackDepth() const { return m_maxStackDepth; }
+
+    // 清空表达式（保留已分配的内存以便复用）
+    void clear();
+
+    static constexpr int MAX_STACK_DEPTH = 1024;    // 求值操作数栈容量
+
+private:
+    friend class ExpressionParser;
+
+    // 添加节点并返回下标
+    int addNode(const ExpressionNode &node);
+
+    // 查找或登记变量，返回变量下标
+    int internVariable(const char *name, int length);
+
+private:
+    std::vector<ExpressionNode> m_nodes;     // 扁平语法树
+    std::vector<std::string> m_variables;    // 变量名表
+    int m_stackDepth;                        // 按后序扫描到当前节点时的栈深度
+    int m_maxStackDepth;                     // 求值过程中的最大栈深度
+};
+
+} // namespace Calculator
+
+#endif // EXPRESSION_H
@@ -0,0 +1,69 @@
+/**
+ * @file ExpressionParser.h
+ * @brief 中缀表达式解析器
+ * @author Jisq
+ * @version 1.0
+ * @date 2025
+ */
+
+#ifndef EXPRESSIONPARSER_H
+#define EXPRESSIONPARSER_H
+
+#include "Expression.h"
+
+namespace Calculator {
+
+/**
+ * @class ExpressionParser
+ * @brief 递归下降的中缀表达式解析器
+ * 支持 + - * / （以及 × ÷）、一元正负号、括号、小数与科学计数法常量和变量名，
+ * 乘除优先于加减，同级运算左结合。解析结果写入 Expression 以便反复求值。
+ *
+ * 语法：
+ *   expr    := term (('+' | '-') term)*
+ *   term    := unary (('*' | '/' | '×' | '÷') unary)*
+ *   unary   := ('+' | '-') unary | primary
+ *   primary := number | identifier | '(' expr ')'
+ */
+class ExpressionParser {
+public:
+    ExpressionParser();
+
+    // 解析 UTF-8 文本，成功返回true；失败时 expression 被清空
+    bool parse(const char *text, int length, Expression &expression);
+
+    // 最近一次解析的错误类型与出错位置（字节偏移）
+    ErrorType error() const { return m_error; }
+    int errorPosition() const { return m_errorPosition; }
+
+    static constexpr int MAX_NESTING_DEPTH = 256;   // 最大括号/一元运算嵌套深度
+
+private:
+    int parseExpression();
+    int parseTerm();
+    int parseUnary();
+    int parsePrimary();
+
+    // 跳过空白字符
+    void skipWhitespace();
+
+    // 尝试匹配加减/乘除运算符，成功时前移位置
+    bool matchAdditive(Operator &op);
+    bool matchMultiplicative(Operator &op);
+
+    // 记录语法错误，返回 -1
+    int fail();
+
+private:
+    const char *m_text;         // 正在解析的文本
+    int m_length;               // 文本长度
+    int m_pos;                  // 当前位置
+    int m_depth;                // 当前嵌套深度
+    Expression *m_expression;   // 输出表达式
+    ErrorType m_error;          // 错误类型
+    int m_errorPosition;        // 错误位置
+};
+
+} // namespace Calculator
+
+#endif // EXPRESSIONPARSER_H
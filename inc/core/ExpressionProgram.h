@@ -0,0 +1,75 @@
+/**
+ * @file ExpressionProgram.h
+ * @brief 表达式字节码与寄存器虚拟机
+ * @author Jisq
+ * @version 1.0
+ * @date 2025
+ */
+
+#ifndef EXPRESSIONPROGRAM_H
+#define EXPRESSIONPROGRAM_H
+
+#include "Expression.h"
+#include <cstdint>
+#include <vector>
+
+namespace Calculator {
+
+/**
+ * @brief 三地址指令
+ * 操作码直接复用 Operator 的取值（Add/Subtract/Multiply/Divide），
+ * 另有 OPCODE_NEGATE 表示一元取负（只使用 lhs）。操作数均为寄存器编号。
+ */
+struct Instruction {
+    std::uint8_t op;    // 操作码
+    std::uint8_t dst;   // 目标寄存器
+    std::uint8_t lhs;   // 左操作数寄存器
+    std::uint8_t rhs;   // 右操作数寄存器
+};
+
+/**
+ * @class ExpressionProgram
+ * @brief 编译后的表达式程序
+ * 将 Expression 的语法树编译为连续的指令数组，由紧凑的分派循环执行。
+ * 寄存器文件布局为 [变量 | 常量 | 临时值]，整体位于求值函数的栈上，
+ * 每次求值只需拷贝变量与常量，不做任何堆分配。
+ * 编译时会折叠纯常量子表达式并合并相同的常量。
+ */
+class ExpressionProgram {
+public:
+    ExpressionProgram();
+
+    // 编译表达式，寄存器数超出上限时返回false（调用方可退回 Expression::evaluate）
+    bool compile(const Expression &expression);
+
+    // 是否已成功编译
+    bool isValid() const { return m_valid; }
+
+    // 求值，出错时设置 error（除零、溢出）并返回 0
+    double evaluate(const double *variables, ErrorType &error) const;
+
+    // 无变量程序的求值
+    double evaluate(ErrorType &error) const { return evaluate(nullptr, error); }
+
+    // 程序信息
+    int variableCount() const { return m_variableCount; }
+    int registerCount() const { return m_registerCount; }
+    int resultRegister() const { return m_resultRegister; }
+    const std::vector<Instruction> &instructions() const { return m_code; }
+    const std::vector<double> &constants() const { return m_constants; }
+
+    static const std::uint8_t OPCODE_NEGATE = 0xFF;  // 一元取负操作码
+    static constexpr int MAX_REGISTERS = 256;        // 寄存器文件容量
+
+private:
+    std::vector<Instruction> m_code;    // 指令数组
+    std::vector<double> m_constants;    // 常量池（按寄存器顺序）
+    int m_variableCount;                // 变量个数
+    int m_registerCount;                // 使用的寄存器总数
+    int m_resultRegister;               // 结果所在寄存器
+    bool m_valid;                       // 是否已成功编译
+};
+
+} // namespace Calculator
+
+#endif // EXPRESSIONPROGRAM_H
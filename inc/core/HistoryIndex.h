@@ -0,0 +1,126 @@
+/**
+ * @file HistoryIndex.h
+ * @brief 计算历史的检索索引
+ * @author Jisq
+ * @version 1.0
+ * @date 2025
+ */
+
+#ifndef HISTORYINDEX_H
+#define HISTORYINDEX_H
+
+#include "HistoryLog.h"
+#include <QByteArray>
+#include <QDateTime>
+#include <QString>
+#include <QVector>
+#include <vector>
+
+namespace Calculator {
+
+/**
+ * @brief 历史检索条件，各条件同时满足
+ */
+struct HistoryQuery {
+    bool hasResultRange;        // 结果在 [resultLow, resultHigh] 内
+    double resultLow;
+    double resultHigh;
+    QByteArray resultPrefix;    // 结果的显示文本以此开头（非空时生效）
+    bool hasTimeRange;          // 时间戳在 [timeFrom, timeTo) 内
+    qint64 timeFrom;
+    qint64 timeTo;
+    bool hasOperandRange;       // 任一操作数在 [operandLow, operandHigh] 内
+    double operandLow;
+    double operandHigh;
+
+    HistoryQuery();
+
+    bool isEmpty() const;
+
+    /**
+     * 解析搜索框文本，各项以空格分隔（数字中的千位分隔逗号会被忽略）：
+     *   4200       结果以 "4200" 开头
+     *   ~4200      结果约为 4200（±1%）
+     *   100..200   结果在 100 到 200 之间
+     *   10:30      now 当天 10:30 前后半小时内
+     *   x~12       任一操作数约为 12（±1%），x=12 为精确匹配
+     * @return 存在无法识别的项时返回 false
+     */
+    static bool parse(const QString &text, const QDateTime &now, HistoryQuery *query);
+};
+
+/**
+ * @class HistoryIndex
+ * @brief 历史记录的排序索引
+ *
+ * 对 HistoryLog 维护三个按值排序的记录下标数组：结果（不含出错的运算）、时间戳、
+ * 操作数（每条记录的左右操作数各一项）。范围查询是两次二分查找；
+ * 结果前缀查询按数位展开为至多十几个值区间（小于 1e-4 的科学计数法结果合为一个区间），
+ * 再用显示文本校验。
+ * 索引在查询前由 update() 增量追上日志：新记录排序后与已有数组归并。
+ * 每条记录占用 16 字节索引空间；首次查询时才建立，不影响启动。
+ */
+class HistoryIndex {
+public:
+    static const int DEFAULT_LIMIT = 1000;
+
+    explicit HistoryIndex(const HistoryLog *log);
+
+    // 追上日志的新记录（日志被清空或重新打开时重建）
+    void update();
+    quint64 indexedCount() const { return m_indexed; }
+
+    // 以下查询返回记录下标，按时间从新到旧排列，至多 limit 条
+    QVector<quint64> findResults(double low, double high, int limit = DEFAULT_LIMIT);
+    QVector<quint64> findResultPrefix(const QByteArray &prefix, int limit = DEFAULT_LIMIT);
+    QVector<quint64> findByTime(qint64 from, qint64 to, int limit = DEFAULT_LIMIT);
+    QVector<quint64> findOperands(double low, double high, int limit = DEFAULT_LIMIT);
+
+    // 结果最接近 value 的 count 条记录，按距离从近到远排列
+    QVector<quint64> findNearestResults(double value, int count);
+
+    // 组合查询：从候选最少的索引出发，再逐条检查其余条件
+    QVector<quint64> search(const HistoryQuery &query, int limit = DEFAULT_LIMIT);
+
+private:
+    // 排序数组中的一段候选
+    struct Span {
+        const std::vector<quint32> *keys;
+        size_t begin;
+        size_t end;
+        size_t size() const { return end - begin; }
+    };
+
+    Span resultSpan(double low, double high) const;
+    Span timeSpan(qint64 from, qint64 to) const;
+    Span operandSpan(double low, double high) const;
+
+    // 结果前缀对应的值区间，返回区间数
+    static int prefixRanges(const QByteArray &prefix, double *lows, double *highs, int capacity);
+    static bool resultHasPrefix(double value, const QByteArray &prefix);
+    // 落在前缀区间内的值是否必然以该前缀显示（outer 为区间远离零的一端）
+    static bool prefixImpliedByRange(double value, double outer);
+
+    // prefixChecked 为 true 时跳过结果前缀的校验
+    bool matches(const HistoryRecord &record, const HistoryQuery &query, bool prefixChecked) const;
+
+    // 收集候选中满足条件的记录，按时间从新到旧排序并截断；
+    // prefixOuter 非空表示候选来自结果前缀区间（每个区间远离零的一端）
+    QVector<quint64> collect(const Span *spans, const double *prefixOuter, int spanCount,
+                             const HistoryQuery &query, int limit) const;
+
+    double resultOf(quint32 index) const { return m_log->at(index).result; }
+    qint64 timeOf(quint32 index) const { return m_log->at(index).timestamp; }
+    double operandOf(quint32 key) const;
+
+    const HistoryLog *m_log;
+    quint64 m_indexed;                  // 已编入索引的记录数
+    quint64 m_generation;               // 建立索引时日志的 generation()
+    std::vector<quint32> m_byResult;    // 记录下标，按结果排序
+    std::vector<quint32> m_byTime;      // 记录下标，按时间戳排序
+    std::vector<quint32> m_byOperand;   // 记录下标 * 2 + (0 左 / 1 右)，按操作数排序
+};
+
+} // namespace Calculator
+
+#endif // HISTORYINDEX_H
@@ -0,0 +1,104 @@
+/**
+ * @file HistoryLog.h
+ * @brief 计算历史记录（内存映射的追加日志）
+ * @author Jisq
+ * @version 1.0
+ * @date 2025
+ */
+
+#ifndef HISTORYLOG_H
+#define HISTORYLOG_H
+
+#include "CalculationTypes.h"
+#include <QFile>
+#include <QString>
+#include <QtGlobal>
+
+namespace Calculator {
+
+/**
+ * @brief 一条历史记录（定长 40 字节，直接写入映射的文件）
+ * 出错的运算同样记录，此时 result 为 0。
+ */
+struct HistoryRecord {
+    double leftOperand;     // 左操作数
+    double rightOperand;    // 右操作数
+    double result;          // 结果
+    qint64 timestamp;       // 完成时间（自纪元起的毫秒数，UTC）
+    quint8 op;              // Operator
+    quint8 error;           // ErrorType
+    quint8 reserved[6];     // 保留，写入时为 0
+
+    Operator operatorType() const { return static_cast<Operator>(op); }
+    ErrorType errorType() const { return static_cast<ErrorType>(error); }
+};
+
+static_assert(sizeof(HistoryRecord) == 40, "HistoryRecord must stay 40 bytes (file format)");
+
+/**
+ * @class HistoryLog
+ * @brief 计算历史的持久化存储
+ *
+ * 文件由 64 字节的文件头和连续的 HistoryRecord 组成，整个文件通过 QFile::map()
+ * 映射到内存：追加是一次结构体拷贝加文件头计数递增，按下标访问是指针运算，
+ * 记录不占用进程堆。映射空间用完时按容量成倍扩展文件（每次至多 GROWTH_LIMIT 条）并重新映射，
+ * 关闭时截掉未使用的预留空间。
+ * 记录先写入、再递增文件头计数，进程异常退出时最多丢失正在写入的一条。
+ * 扩展会重新映射，at() 返回的引用在下一次 append() 之后可能失效。
+ */
+class HistoryLog {
+public:
+    static const quint32 FORMAT_VERSION = 1;
+    static const quint64 INITIAL_CAPACITY = 4096;       // 新文件预留的记录数
+    static const quint64 GROWTH_LIMIT = 1024 * 1024;    // 单次扩展的最大记录数
+
+    HistoryLog();
+    ~HistoryLog();
+
+    HistoryLog(const HistoryLog &) = delete;
+    HistoryLog &operator=(const HistoryLog &) = delete;
+
+    /**
+     * 打开或创建历史文件。
+     * @return 失败时返回 false（无法打开、不是历史文件或版本不符），详情见 errorString()
+     */
+    bool open(const QString &path);
+    void close();
+    bool isOpen() const { return m_header != nullptr; }
+    QString fileName() const { return m_file.fileName(); }
+    QString errorString() const { return m_errorString; }
+
+    // 记录数与随机访问（index < count()）
+    quint64 count() const;
+    const HistoryRecord &at(quint64 index) const;
+
+    // 追加一条记录，文件未打开或扩展失败时返回 false
+    bool append(const HistoryRecord &record);
+    bool append(double left, Operator op, double right, double result, ErrorType error);
+
+    // 删除全部记录并收缩文件
+    bool clear();
+
+    // 每次 clear() 或 open() 后递增，基于记录下标的派生数据（如 HistoryIndex）据此判断是否需要重建
+    quint64 generation() const { return m_generation; }
+
+private:
+    struct Header;
+
+    // 把文件扩展或收缩到 capacity 条记录并重新映射
+    bool remap(quint64 capacity);
+    void unmap();
+    bool fail(const QString &message);
+
+    QFile m_file;
+    uchar *m_map;
+    Header *m_header;
+    HistoryRecord *m_records;
+    quint64 m_capacity;
+    quint64 m_generation;       // 记录序列被替换的次数
+    QString m_errorString;
+};
+
+} // namespace Calculator
+
+#endif // HISTORYLOG_H
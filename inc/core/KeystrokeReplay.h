@@ -0,0 +1,111 @@
+/**
+ * @file KeystrokeReplay.h
+ * @brief 按键序列重放
+ * @author Jisq
+ * @version 1.0
+ * @date 2025
+ */
+
+#ifndef KEYSTROKEREPLAY_H
+#define KEYSTROKEREPLAY_H
+
+#include "EngineCore.h"
+
+namespace Calculator {
+
+class CalculatorEngine;
+
+/**
+ * 按键脚本字符约定（与键盘快捷键保持一致）：
+ *   0-9      数字输入
+ *   . ,      小数点
+ *   + - * /  运算符
+ *   = 回车   等号
+ *   C c      全部清除(C)
+ *   E e      清除当前输入(CE)
+ *   B b <    退格
+ *   N n ~    正负号切换
+ *   空白字符被忽略
+ */
+
+// 把单个按键字符应用到任意具有按键接口的引擎（CalculatorEngine 或 EngineCore），
+// 无法识别的字符返回false；引擎为 EngineCore 时可在常量表达式中求值
+template <typename Engine>
+constexpr bool applyKeystroke(Engine &engine, char key) {
+    if (key >= '0' && key <= '9') {
+        engine.inputDigit(key - '0');
+        return true;
+    }
+
+    switch (key) {
+    case '.':
+    case ',':
+        engine.inputDecimal();
+        break;
+    case '+':
+        engine.inputOperator(Operator::Add);
+        break;
+    case '-':
+        engine.inputOperator(Operator::Subtract);
+        break;
+    case '*':
+        engine.inputOperator(Operator::Multiply);
+        break;
+    case '/':
+        engine.inputOperator(Operator::Divide);
+        break;
+    case '=':
+    case '\n':
+        engine.inputEquals();
+        break;
+    case 'C':
+    case 'c':
+        engine.clearAll();
+        break;
+    case 'E':
+    case 'e':
+        engine.clearEntry();
+        break;
+    case 'B':
+    case 'b':
+    case '<':
+        engine.backspace();
+        break;
+    case 'N':
+    case 'n':
+    case '~':
+        engine.changeSign();
+        break;
+    case ' ':
+    case '\t':
+    case '\r':
+        break;
+    default:
+        return false;
+    }
+    return true;
+}
+
+// 重放单个按键字符，无法识别的字符返回false
+bool replayKeystroke(CalculatorEngine &engine, char key);
+
+// 重放整段按键序列，返回无法识别的字符数
+int replayKeystrokes(CalculatorEngine &engine, const char *keys, int length);
+
+/**
+ * @brief 在编译期折叠一段以 '\0' 结尾的按键序列（无法识别的字符被忽略）
+ * 用于固定的计算配方，结果可以直接用 static_assert 检查，运行时没有任何开销：
+ *   constexpr EngineCore price = foldKeystrokes("19.99*1.08=");
+ *   static_assert(price.currentState().currentValue == 19.99 * 1.08, "");
+ */
+constexpr EngineCore foldKeystrokes(const char *keys) {
+    EngineCore core;
+    for (; *keys != '\0'; ++keys) {
+        applyKeystroke(core, *keys);
+    }
+    return core;
+}
+
+} // namespace Calculator
+
+#endif // KEYSTROKEREPLAY_H
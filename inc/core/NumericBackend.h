@@ -0,0 +1,178 @@
+/**
+ * @file NumericBackend.h
+ * @brief 可替换的数值后端
+ * @author Jisq
+ * @version 1.0
+ * @date 2025
+ */
+
+#ifndef NUMERICBACKEND_H
+#define NUMERICBACKEND_H
+
+#include "CalculationTypes.h"
+#include "BigRational.h"
+#include "Decimal128.h"
+#include "../utils/Constants.h"
+#include <memory>
+#include <string>
+
+namespace Calculator {
+
+/**
+ * @class NumericBackend
+ * @brief 数值后端接口
+ * 引擎的按键状态机仍以文本维护正在输入的操作数，计算时把操作数交给后端。
+ * 后端持有当前操作数与存储值两个寄存器，按自己的数值类型完成运算和格式化，
+ * 引擎只通过 double 近似值更新 CalculatorState。
+ */
+class NumericBackend {
+public:
+    virtual ~NumericBackend() {}
+
+    virtual NumericBackendType type() const = 0;
+
+    // 由十进制文本设置当前操作数，文本无法解析时返回false
+    virtual bool setOperand(const char *text, int length) = 0;
+
+    // 存储值 = 当前操作数
+    virtual void storeOperand() = 0;
+
+    // 当前操作数 = 存储值
+    virtual void loadStored() = 0;
+
+    // 取反
+    virtual void negateOperand() = 0;
+    virtual void negateStored() = 0;
+
+    // 当前操作数 = 存储值 op 当前操作数，存储值清零；出错时寄存器不变
+    virtual ErrorType apply(Operator op) = 0;
+
+    // 两个寄存器清零
+    virtual void reset() = 0;
+
+    // 双精度近似值
+    virtual double operandValue() const = 0;
+    virtual double storedValue() const = 0;
+
+    // 显示文本
+    virtual std::string formatOperand() const = 0;
+    virtual std::string formatStored() const = 0;
+};
+
+/**
+ * @class BasicNumericBackend
+ * @brief 按策略类实现的数值后端
+ * Policy 需提供：
+ *   typedef ... Value;                       数值类型（默认构造为零）
+ *   static const NumericBackendType TYPE;    后端类型
+ *   bool parse(const char*, int, Value&) const;
+ *   ErrorType apply(Operator, const Value&, const Value&, Value&) const;
+ *   double toDouble(const Value&) const;
+ *   std::string format(const Value&) const;
+ * 策略对象按值保存，可携带精度等配置。
+ */
+template <typename Policy>
+class BasicNumericBackend : public NumericBackend {
+public:
+    typedef typename Policy::Value Value;
+
+    explicit BasicNumericBackend(const Policy &policy = Policy())
+        : m_policy(policy)
+        , m_operand()
+        , m_stored() {}
+
+    NumericBackendType type() const override { return Policy::TYPE; }
+
+    bool setOperand(const char *text, int length) override {
+        return m_policy.parse(text, length, m_operand);
+    }
+
+    void storeOperand() override { m_stored = m_operand; }
+    void loadStored() override { m_operand = m_stored; }
+    void negateOperand() override { m_operand = -m_operand; }
+    void negateStored() override { m_stored = -m_stored; }
+
+    ErrorType apply(Operator op) override {
+        Value result;
+        ErrorType error = m_policy.apply(op, m_stored, m_operand, result);
+        if (error == ErrorType::NoError) {
+            m_operand = std::move(result);
+            m_stored = Value();
+        }
+        return error;
+    }
+
+    void reset() override {
+        m_operand = Value();
+        m_stored = Value();
+    }
+
+    double operandValue() const override { return m_policy.toDouble(m_operand); }
+    double storedValue() const override { return m_policy.toDouble(m_stored); }
+
+    std::string formatOperand() const override { return m_policy.format(m_operand); }
+    std::string formatStored() const override { return m_policy.format(m_stored); }
+
+    // 策略配置
+    const Policy &policy() const { return m_policy; }
+
+    // 寄存器访问
+    const Value &operand() const { return m_operand; }
+    const Value &stored() const { return m_stored; }
+
+private:
+    Policy m_policy;    // 数值策略
+    Value m_operand;    // 当前操作数
+    Value m_stored;     // 存储值
+};
+
+/**
+ * @brief 任意精度有理数策略
+ * 加减乘除均精确，不受 MAX_CALCULATION_VALUE 限制；
+ * 整数结果完整显示，非整数结果按 displayDigits 位有效数字显示。
+ */
+struct RationalPolicy {
+    typedef BigRational Value;
+    static const NumericBackendType TYPE = NumericBackendType::Rational;
+
+    int displayDigits;  // 非整数结果显示的有效数字位数
+
+    RationalPolicy()
+        : displayDigits(Constants::MAX_DISPLAY_LENGTH) {}
+
+    bool parse(const char *text, int length, Value &value) const;
+    ErrorType apply(Operator op, const Value &lhs, const Value &rhs, Value &result) const;
+    double toDouble(const Value &value) const { return value.toDouble(); }
+    std::string format(const Value &value) const { return value.toDecimalString(displayDigits); }
+};
+
+/**
+ * @brief 十进制定点数策略
+ * 数值以 context.scale 位小数的 Decimal128 保存，0.1 + 0.2 精确等于 0.3；
+ * 乘除结果按 context.rounding 舍入到 scale 位，绝对值超过 38 位数字时报告 Overflow。
+ */
+struct DecimalPolicy {
+    typedef Decimal128 Value;
+    static const NumericBackendType TYPE = NumericBackendType::Decimal;
+
+    DecimalContext context;  // 小数位数与舍入模式
+
+    DecimalPolicy() {}
+    explicit DecimalPolicy(const DecimalContext &decimalContext)
+        : context(decimalContext) {}
+
+    bool parse(const char *text, int length, Value &value) const;
+    ErrorType apply(Operator op, const Value &lhs, const Value &rhs, Value &result) const;
+    double toDouble(const Value &value) const { return value.toDouble(context.scale); }
+    std::string format(const Value &value) const { return value.toString(context.scale); }
+};
+
+typedef BasicNumericBackend<RationalPolicy> RationalBackend;
+typedef BasicNumericBackend<DecimalPolicy> DecimalBackend;
+
+// 创建指定类型的后端（Double 返回空指针，表示使用引擎内置的双精度路径）
+std::unique_ptr<NumericBackend> createNumericBackend(NumericBackendType type);
+
+} // namespace Calculator
+
+#endif // NUMERICBACKEND_H
@@ -0,0 +1,99 @@
+/**
+ * @file ResultCache.h
+ * @brief 二元运算结果的记忆化缓存
+ * @author Jisq
+ * @version 1.0
+ * @date 2025
+ */
+
+#ifndef RESULTCACHE_H
+#define RESULTCACHE_H
+
+#include "CalculationTypes.h"
+#include <QtGlobal>
+#include <atomic>
+#include <cstddef>
+
+namespace Calculator {
+
+/**
+ * @class ResultCache
+ * @brief 以（左操作数、运算符、右操作数）为键缓存运算结果与错误类型
+ *
+ * 固定容量的开放寻址哈希表：键为两个 double 的位模式加运算符，
+ * 每个槽 32 字节，两个槽占一条缓存行，表按缓存行对齐；
+ * 查找只探测起始缓存行及其后一条（共 PROBE_SLOTS 个槽），满了就覆盖其中一个。
+ *
+ * 读者无锁：每个槽带序列号（seqlock），读取前后序列号一致且为偶数才算命中，
+ * 与写入交错的读取按未命中处理。写者用 CAS 把序列号置为奇数来占用槽，
+ * 占用失败（另一线程正在写）时直接放弃这次写入。
+ * 因此同一个缓存可以由多个求值线程同时读写。
+ */
+class ResultCache {
+public:
+    static const int DEFAULT_CAPACITY = 1 << 16;   // 默认槽数（2 MB）
+    static const int PROBE_SLOTS = 4;              // 每次查找探测的槽数
+
+    /**
+     * @brief 命中统计
+     */
+    struct Stats {
+        quint64 hits;
+        quint64 misses;
+    };
+
+    // capacity 向上取整为 2 的幂，至少 PROBE_SLOTS
+    explicit ResultCache(int capacity = DEFAULT_CAPACITY);
+    ~ResultCache();
+
+    ResultCache(const ResultCache&) = delete;
+    ResultCache& operator=(const ResultCache&) = delete;
+
+    int capacity() const { return static_cast<int>(m_mask + 1); }
+
+    // 查找缓存的结果，命中时写入 result 与 error
+    bool lookup(Operator op, double lhs, double rhs, double &result, ErrorType &error);
+
+    // 写入一条结果（槽正被其他线程写入时放弃）
+    void insert(Operator op, double lhs, double rhs, double result, ErrorType error);
+
+    // 与 applyOperator() 语义相同，先查缓存，未命中时计算并写入
+    double apply(Operator op, double lhs, double rhs, ErrorType &error);
+
+    // 各线程计数之和
+    Stats stats() const;
+    void resetStats();
+
+    // 清空所有槽（不能与读写并发调用）
+    void clear();
+
+private:
+    // 一个槽，全部字段为原子量，读者与写者并发访问时没有数据竞争
+    struct Slot {
+        std::atomic<quint32> sequence;  // 偶数为稳定状态，奇数为正在写入
+        std::atomic<quint32> tag;       // 非零表示已占用：运算符 | 错误类型 << 8 | 1 << 16
+        std::atomic<quint64> lhs;       // 左操作数的位模式
+        std::atomic<quint64> rhs;       // 右操作数的位模式
+        std::atomic<quint64> result;    // 结果的位模式
+    };
+
+    // 计数分片，按线程分散；每个分片独占一条缓存行，避免多个线程争用
+    struct alignas(64) Counter {
+        std::atomic<quint64> hits;
+        std::atomic<quint64> misses;
+    };
+
+    static const int COUNTER_SHARDS = 16;
+
+    static quint64 hashKey(Operator op, quint64 lhs, quint64 rhs);
+    // 当前线程使用的计数分片
+    static int shardIndex();
+
+    Slot *m_slots;          // 按缓存行对齐的槽数组
+    quint64 m_mask;         // 槽数 - 1
+    Counter *m_counters;    // 按缓存行对齐的 COUNTER_SHARDS 个计数分片
+};
+
+} // namespace Calculator
+
+#endif // RESULTCACHE_H
@@ -0,0 +1,126 @@
+/**
+ * @file EngineServer.h
+ * @brief 多会话计算引擎服务（Unix 域套接字）
+ * @author Jisq
+ * @version 1.0
+ * @date 2025
+ */
+
+#ifndef ENGINESERVER_H
+#define ENGINESERVER_H
+
+#include "ServerProtocol.h"
+#include <QByteArray>
+#include <QString>
+#include <QtGlobal>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace Calculator {
+
+/**
+ * @brief 服务选项
+ */
+struct ServerOptions {
+    QString socketPath;  // Unix 域套接字路径（已存在的套接字文件会被替换）
+    int threads;         // 事件循环线程数，0 为硬件线程数
+    int maxSessions;     // 每个连接的会话数上限
+
+    ServerOptions()
+        : threads(0)
+        , maxSessions(4096) {}
+};
+
+/**
+ * @class EngineServer
+ * @brief 在一个进程中托管大量独立的计算器会话，通过 Unix 域套接字提供按键与表达式求值
+ *
+ * 每个会话是一个 EngineCore 值（双精度后端，语义与 CalculatorEngine 逐键一致），
+ * 不创建 QObject，也不经过信号；帧格式见 ServerProtocol.h。
+ *
+ * 每个线程有自己的 epoll 事件循环，监听套接字以 EPOLLEXCLUSIVE 注册到所有循环中；
+ * 被唤醒的线程接受新连接，按轮转分给各个事件循环，此后连接一直由同一线程处理。
+ * 会话保存在连接内，因此请求路径上没有锁。
+ * 一次读取中的全部完整帧依次处理，响应合并为一次写入；
+ * 对端不读取响应导致输出积压时暂停读取该连接，直到输出写完。
+ *
+ * 仅用于 Linux（epoll、eventfd）。
+ */
+class EngineServer {
+public:
+    /**
+     * @brief 单个事件循环线程的统计（stop() 之后读取）
+     */
+    struct WorkerReport {
+        qint64 connections;     // 分到的连接数
+        qint64 requests;        // 处理的请求数
+        qint64 bytesIn;         // 读取的字节数
+        qint64 bytesOut;        // 写出的字节数
+    };
+
+    static const int READ_CHUNK = 64 * 1024;        // 单次读取的最大字节数
+    static const int MAX_EVENTS = 64;               // 单次 epoll_wait 取回的事件数
+
+    explicit EngineServer(const ServerOptions &options);
+    ~EngineServer();
+
+    EngineServer(const EngineServer&) = delete;
+    EngineServer& operator=(const EngineServer&) = delete;
+
+    // 绑定套接字并启动事件循环线程；失败时返回 false，原因见 errorString()
+    bool start();
+    // 通知所有线程退出并等待，关闭全部连接并删除套接字文件
+    void stop();
+
+    bool isRunning() const { return !m_threads.empty(); }
+    int threadCount() const { return static_cast<int>(m_workers.size()); }
+    QString errorString() const { return m_errorString; }
+    std::vector<WorkerReport> workerReports() const;
+
+private:
+    struct Connection;
+    struct Worker;
+
+    // 事件循环主体
+    void workerLoop(Worker &worker);
+
+    // 接受所有等待中的连接，按轮转注册到各线程的事件循环
+    void acceptConnections();
+
+    // 读取并处理所有完整的请求帧；连接应关闭时返回 false
+    bool readConnection(Worker &worker, Connection &connection);
+
+    // 处理一个请求，把响应追加到连接的输出缓冲
+    void handleRequest(Worker &worker, Connection &connection,
+                       const RequestHeader &request, const char *payload);
+
+    // 尽量写出输出缓冲，并按剩余量切换读写关注；连接应关闭时返回 false
+    bool flushConnection(Worker &worker, Connection &connection);
+
+    void closeConnection(Worker &worker, int fd);
+
+    static const int ERROR_TYPE_COUNT = 5;          // ErrorType 的取值个数
+
+    // 记录失败原因（附带 errno 的描述）并释放已创建的资源，返回 false
+    bool fail(const char *what);
+
+    // 关闭监听套接字、停止事件与各线程的 epoll，删除套接字文件
+    void release();
+
+private:
+    ServerOptions m_options;
+    QString m_errorString;
+    int m_listenFd;
+    int m_stopFd;                                   // eventfd，置位后所有线程退出
+    bool m_bound;                                   // 套接字文件是否由本服务创建
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::vector<std::thread> m_threads;
+    std::atomic<unsigned> m_nextWorker;             // 下一个新连接分给的线程
+    QByteArray m_errorTexts[ERROR_TYPE_COUNT];      // 按 ErrorType 下标的 UTF-8 错误提示
+};
+
+} // namespace Calculator
+
+#endif // ENGINESERVER_H
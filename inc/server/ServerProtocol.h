@@ -0,0 +1,104 @@
+/**
+ * @file ServerProtocol.h
+ * @brief 引擎服务的二进制帧格式
+ * @author Jisq
+ * @version 1.0
+ * @date 2025
+ */
+
+#ifndef SERVERPROTOCOL_H
+#define SERVERPROTOCOL_H
+
+#include <QtEndian>
+#include <QtGlobal>
+
+namespace Calculator {
+
+/**
+ * 所有整数均为小端序。客户端可以不等响应连续发送多个请求（流水线），
+ * 同一连接上的响应严格按请求顺序返回，tag 原样带回，便于客户端对应。
+ *
+ * 请求帧（REQUEST_HEADER_SIZE 字节头 + 负载）：
+ *   偏移 0   u32 tag       客户端自定的请求编号
+ *   偏移 4   u32 session   会话编号，在本连接内有效，首次使用时创建
+ *   偏移 8   u16 length    负载字节数
+ *   偏移 10  u8  type      RequestType
+ *   偏移 11  u8  reserved  置 0
+ *
+ * 响应帧（RESPONSE_HEADER_SIZE 字节头 + 文本）：
+ *   偏移 0   u32 tag       对应请求的 tag
+ *   偏移 4   u8  status    ResponseStatus
+ *   偏移 5   u8  error     会话的 ErrorType（status 为 Ok 时有效）
+ *   偏移 6   u16 length    文本字节数
+ *   文本为会话的显示文本（UTF-8）；会话处于错误状态时为错误提示，与界面显示相同。
+ */
+
+// 请求类型
+enum class RequestType : quint8 {
+    Keys = 1,           // 负载为按键脚本（字符约定见 KeystrokeReplay.h，无法识别的字符被忽略）
+    Expression = 2,     // 负载为中缀表达式，语义同 CalculatorEngine::evaluateExpression()
+    Reset = 3,          // 全部清除(C)，负载忽略
+    Close = 4           // 释放会话，负载忽略，响应文本为空
+};
+
+// 响应状态
+enum class ResponseStatus : quint8 {
+    Ok = 0,
+    BadRequest = 1,     // 未知的请求类型，会话不变
+    SessionLimit = 2    // 本连接的会话数已达上限，请求未执行
+};
+
+struct RequestHeader {
+    quint32 tag;
+    quint32 session;
+    quint16 length;
+    RequestType type;
+};
+
+struct ResponseHeader {
+    quint32 tag;
+    ResponseStatus status;
+    quint8 error;
+    quint16 length;
+};
+
+const int REQUEST_HEADER_SIZE = 12;
+const int RESPONSE_HEADER_SIZE = 8;
+const int MAX_PAYLOAD_SIZE = 0xFFFF;
+
+inline void writeRequestHeader(uchar *buffer, const RequestHeader &header) {
+    qToLittleEndian<quint32>(header.tag, buffer);
+    qToLittleEndian<quint32>(header.session, buffer + 4);
+    qToLittleEndian<quint16>(header.length, buffer + 8);
+    buffer[10] = static_cast<uchar>(header.type);
+    buffer[11] = 0;
+}
+
+inline RequestHeader readRequestHeader(const uchar *buffer) {
+    RequestHeader header;
+    header.tag = qFromLittleEndian<quint32>(buffer);
+    header.session = qFromLittleEndian<quint32>(buffer + 4);
+    header.length = qFromLittleEndian<quint16>(buffer + 8);
+    header.type = static_cast<RequestType>(buffer[10]);
+    return header;
+}
+
+inline void writeResponseHeader(uchar *buffer, const ResponseHeader &header) {
+    qToLittleEndian<quint32>(header.tag, buffer);
+    buffer[4] = static_cast<uchar>(header.status);
+    buffer[5] = header.error;
+    qToLittleEndian<quint16>(header.length, buffer + 6);
+}
+
+inline ResponseHeader readResponseHeader(const uchar *buffer) {
+    ResponseHeader header;
+    header.tag = qFromLittleEndian<quint32>(buffer);
+    header.status = static_cast<ResponseStatus>(buffer[4]);
+    header.error = buffer[5];
+    header.length = qFromLittleEndian<quint16>(buffer + 6);
+    return header;
+}
+
+} // namespace Calculator
+
+#endif // SERVERPROTOCOL_H
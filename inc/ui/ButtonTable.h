@@ -0,0 +1,75 @@
+/**
+ * @file ButtonTable.h
+ * @brief 计算器按钮描述表
+ * @author Jisq
+ * @version 1.0
+ * @date 2025
+ */
+
+#ifndef BUTTONTABLE_H
+#define BUTTONTABLE_H
+
+#include "../core/CalculationTypes.h"
+#include <qnamespace.h>
+
+namespace Calculator {
+
+/**
+ * @brief 按钮触发的操作
+ */
+enum class ButtonAction {
+    Digit,        // 数字输入，value 为数字
+    Decimal,      // 小数点
+    Operator,     // 运算符，op 为运算符
+    Equals,       // 等号
+    ClearEntry,   // 清除当前输入(CE)
+    ClearAll,     // 全部清除(C)
+    Backspace     // 退格
+};
+
+/**
+ * @brief 按钮描述
+ * 同一张表同时决定界面布局（位置、跨度、样式类型）与点击分发（操作、参数），
+ * 按钮 id 即表中的下标。
+ */
+struct ButtonDescriptor {
+    const char *label;     // 按钮文字（UTF-8）
+    const char *name;      // 命令名（键位设置中使用）
+    int row;               // 网格行
+    int column;            // 网格列
+    int columnSpan;        // 跨列数
+    ButtonType type;       // 样式类型
+    ButtonAction action;   // 触发的操作
+    int digit;             // Digit 操作的数字
+    Operator op;           // Operator 操作的运算符
+    int key;               // 默认绑定的键盘按键（Qt::Key）
+};
+
+// 按钮网格（5×4）：从上到下、从左到右
+constexpr ButtonDescriptor BUTTON_TABLE[] = {
+    { "CE", "clearEntry",   0, 0, 1, ButtonType::Function, ButtonAction::ClearEntry, 0, Operator::None,     Qt::Key_Delete    },
+    { "C",  "clearAll",     0, 1, 1, ButtonType::Function, ButtonAction::ClearAll,   0, Operator::None,     Qt::Key_Escape    },
+    { "⌫",  "backspace",    0, 2, 1, ButtonType::Function, ButtonAction::Backspace,  0, Operator::None,     Qt::Key_Backspace },
+    { "÷",  "divide",       0, 3, 1, ButtonType::Operator, ButtonAction::Operator,   0, Operator::Divide,   Qt::Key_Slash     },
+    { "7",  "digit7",       1, 0, 1, ButtonType::Number,   ButtonAction::Digit,      7, Operator::None,     Qt::Key_7         },
+    { "8",  "digit8",       1, 1, 1, ButtonType::Number,   ButtonAction::Digit,      8, Operator::None,     Qt::Key_8         },
+    { "9",  "digit9",       1, 2, 1, ButtonType::Number,   ButtonAction::Digit,      9, Operator::None,     Qt::Key_9         },
+    { "×",  "multiply",     1, 3, 1, ButtonType::Operator, ButtonAction::Operator,   0, Operator::Multiply, Qt::Key_Asterisk  },
+    { "4",  "digit4",       2, 0, 1, ButtonType::Number,   ButtonAction::Digit,      4, Operator::None,     Qt::Key_4         },
+    { "5",  "digit5",       2, 1, 1, ButtonType::Number,   ButtonAction::Digit,      5, Operator::None,     Qt::Key_5         },
+    { "6",  "digit6",       2, 2, 1, ButtonType::Number,   ButtonAction::Digit,      6, Operator::None,     Qt::Key_6         },
+    { "-",  "subtract",     2, 3, 1, ButtonType::Operator, ButtonAction::Operator,   0, Operator::Subtract, Qt::Key_Minus     },
+    { "1",  "digit1",       3, 0, 1, ButtonType::Number,   ButtonAction::Digit,      1, Operator::None,     Qt::Key_1         },
+    { "2",  "digit2",       3, 1, 1, ButtonType::Number,   ButtonAction::Digit,      2, Operator::None,     Qt::Key_2         },
+    { "3",  "digit3",       3, 2, 1, ButtonType::Number,   ButtonAction::Digit,      3, Operator::None,     Qt::Key_3         },
+    { "+",  "add",          3, 3, 1, ButtonType::Operator, ButtonAction::Operator,   0, Operator::Add,      Qt::Key_Plus      },
+    { "0",  "digit0",       4, 0, 2, ButtonType::Number,   ButtonAction::Digit,      0, Operator::None,     Qt::Key_0         },
+    { ".",  "decimal",      4, 2, 1, ButtonType::Decimal,  ButtonAction::Decimal,    0, Operator::None,     Qt::Key_Period    },
+    { "=",  "equals",       4, 3, 1, ButtonType::Equals,   ButtonAction::Equals,     0, Operator::None,     Qt::Key_Equal     },
+};
+
+constexpr int BUTTON_COUNT = sizeof(BUTTON_TABLE) / sizeof(BUTTON_TABLE[0]);
+
+} // namespace Calculator
+
+#endif // BUTTONTABLE_H
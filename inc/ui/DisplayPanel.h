@@ -9,6 +9,7 @@
 #ifndef DISPLAYPANEL_H
 #define DISPLAYPANEL_H
 
+#include "Theme.h"
 #include <QLineEdit>
 #include <QPainter>
 
@@ -30,6 +31,9 @@ public:
     bool errorState() const { return m_errorState; }
     void setErrorState(bool error);
     
+    // 应用主题，nullptr 表示使用调色板默认颜色
+    void setTheme(const ThemeData *theme);
+    
 public slots:
     // 更新显示内容槽函数
     void updateDisplay(const QString &text);
@@ -49,7 +53,11 @@ protected:
     void keyPressEvent(QKeyEvent *event) override;
 
 private:
-    bool m_errorState;   // 错误状态标志
+    // 按主题与错误状态更新文字颜色
+    void updateTextColor();
+
+    bool m_errorState;         // 错误状态标志
+    const ThemeData *m_theme;  // 当前主题（静态主题表中的条目）
 };
 
 } // namespace Calculator
@@ -0,0 +1,52 @@
+/**
+ * @file DisplayUpdateCoalescer.h
+ * @brief 显示刷新合并器
+ * @author Jisq
+ * @version 1.0
+ * @date 2025
+ */
+
+#ifndef DISPLAYUPDATECOALESCER_H
+#define DISPLAYUPDATECOALESCER_H
+
+#include <QObject>
+#include <QTimer>
+
+namespace Calculator {
+
+class CalculatorEngine;
+class DisplayPanel;
+
+/**
+ * @class DisplayUpdateCoalescer
+ * @brief 合并引擎到显示面板的刷新
+ * 引擎的显示失效与状态更新只设置脏标记，并在本轮事件循环结束后统一刷新一次：
+ * 每个输入事件最多格式化一次显示文本、重绘一次面板。
+ * 键盘自动重复时同一轮事件循环内的多次按键也只刷新一次。
+ */
+class DisplayUpdateCoalescer : public QObject {
+    Q_OBJECT
+
+public:
+    DisplayUpdateCoalescer(CalculatorEngine *engine, DisplayPanel *panel,
+                           QObject *parent = nullptr);
+
+    bool isDirty() const { return m_dirty; }
+
+public slots:
+    // 标记显示内容失效，并安排一次延迟刷新
+    void markDirty();
+
+    // 立即刷新（无脏标记时不做任何事）
+    void flush();
+
+private:
+    CalculatorEngine *m_engine;   // 数据来源
+    DisplayPanel *m_panel;        // 刷新目标
+    QTimer m_flushTimer;          // 零间隔单次定时器，回到事件循环后触发
+    bool m_dirty;                 // 显示内容是否落后于引擎状态
+};
+
+} // namespace Calculator
+
+#endif // DISPLAYUPDATECOALESCER_H
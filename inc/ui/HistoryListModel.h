@@ -0,0 +1,67 @@
+/**
+ * @file HistoryListModel.h
+ * @brief 计算历史列表模型
+ * @author Jisq
+ * @version 1.0
+ * @date 2025
+ */
+
+#ifndef HISTORYLISTMODEL_H
+#define HISTORYLISTMODEL_H
+
+#include "../core/HistoryLog.h"
+#include <QAbstractListModel>
+#include <QString>
+#include <QVector>
+
+namespace Calculator {
+
+/**
+ * @class HistoryListModel
+ * @brief 以 HistoryLog 为数据源的列表模型（最新的记录在第 0 行）
+ * 模型本身不保存任何逐行数据：行号换算为日志下标，显示文本在 data() 中按需格式化。
+ * 行按 FETCH_BATCH 分批暴露给视图（canFetchMore / fetchMore），
+ * 视图只会请求可见行，因此内存与帧耗时不随记录数增长。
+ * 设置过滤后只显示给定的记录下标（由 HistoryIndex 检索得到）。
+ */
+class HistoryListModel : public QAbstractListModel {
+    Q_OBJECT
+
+public:
+    static const int FETCH_BATCH = 256;
+
+    explicit HistoryListModel(const HistoryLog *log, QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    bool canFetchMore(const QModelIndex &parent) const override;
+    void fetchMore(const QModelIndex &parent) override;
+
+    // 行号对应的日志下标
+    quint64 recordIndex(int row) const {
+        return m_filtered ? m_filter.at(row) : m_total - 1 - row;
+    }
+
+    // 只显示给定的记录（按行序排列），clearFilter() 恢复完整历史
+    void setFilter(const QVector<quint64> &records);
+    void clearFilter();
+    bool isFiltered() const { return m_filtered; }
+
+    // 格式化一条记录，如 "12 × 3 = 36"
+    static QString formatRecord(const HistoryRecord &record);
+
+public slots:
+    // 日志有新记录或被清空后调用，新记录插入到顶部（过滤时不变）
+    void refresh();
+
+private:
+    const HistoryLog *m_log;   // 数据来源（不持有）
+    quint64 m_total;           // 模型已知的记录数
+    int m_loaded;              // 已暴露给视图的行数
+    QVector<quint64> m_filter; // 过滤后的记录下标
+    bool m_filtered;           // 是否处于过滤状态
+};
+
+} // namespace Calculator
+
+#endif // HISTORYLISTMODEL_H
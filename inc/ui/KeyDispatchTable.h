@@ -0,0 +1,109 @@
+/**
+ * @file KeyDispatchTable.h
+ * @brief 键盘按键到命令的分发表
+ * @author Jisq
+ * @version 1.0
+ * @date 2025
+ */
+
+#ifndef KEYDISPATCHTABLE_H
+#define KEYDISPATCHTABLE_H
+
+#include "ButtonTable.h"
+#include <QKeySequence>
+#include <QMap>
+#include <QString>
+#include <QtGlobal>
+#include <vector>
+
+namespace Calculator {
+
+/**
+ * @class KeyDispatchTable
+ * @brief 预先计算的键位表
+ *
+ * 命令 0..BUTTON_COUNT-1 即按钮 id（与点击按钮等价），其后为没有对应按钮的命令。
+ * 按键码直接索引定长数组（可打印键 0x00-0x7f、特殊键 0x01000000-0x010000ff），
+ * 修饰键只区分 Ctrl / Alt / Meta（Shift 与小键盘标志被忽略，"+" 等字符本身就需要 Shift）。
+ * 支持两段和弦（如 "Ctrl+K, T"）：第一段命中前缀时记录状态，由下一次按键完成。
+ * dispatch() 不分配内存、不构造 QString；键位的增删只在加载设置时发生。
+ */
+class KeyDispatchTable {
+public:
+    // 没有对应按钮的命令
+    enum Command {
+        ChangeSign = BUTTON_COUNT,   // 正负号切换
+        ToggleTheme,                 // 切换主题
+        COMMAND_COUNT
+    };
+
+    static const int NO_COMMAND = -1;       // 未绑定
+    static const int CHORD_PENDING = -2;    // 和弦前缀，等待下一次按键
+    static const int MAX_CHORD_PREFIXES = 8;
+
+    // 构造后即为默认键位
+    KeyDispatchTable();
+
+    // 清空全部键位
+    void clear();
+
+    // 恢复默认键位：按钮表中的按键，以及回车、逗号、F9、Ctrl+T 等附加键位
+    void loadDefaults();
+
+    /**
+     * 按命令名覆盖键位（通常来自 SettingsManager::getKeyBindings()）。
+     * 值为 QKeySequence 可移植文本，多个键位用 "; " 分隔，空字符串表示解除绑定。
+     * @return 无法识别的命令名或无法绑定的键位数
+     */
+    int applyOverrides(const QMap<QString, QString> &bindings);
+
+    // 绑定一到两段的键序列；与已有前缀或单键绑定冲突时返回 false
+    bool bind(const QKeySequence &sequence, int command);
+
+    // 解除某个命令的全部键位；不再有任何第二段键位的和弦前缀一并解除
+    void unbindCommand(int command);
+
+    // 分发一次按键，返回命令、NO_COMMAND 或 CHORD_PENDING
+    int dispatch(int key, Qt::KeyboardModifiers modifiers);
+
+    bool isChordPending() const { return m_pendingLayer != 0; }
+    void cancelChord() { m_pendingLayer = 0; }
+
+    // 命令名与命令 id 互查（找不到时分别返回 NO_COMMAND 与 nullptr）
+    static int commandId(const QString &name);
+    static const char *commandName(int command);
+
+private:
+    static const int MODIFIER_SLOTS = 8;      // Ctrl / Alt / Meta 的组合
+    static const int PRINTABLE_KEYS = 0x80;
+    static const int SPECIAL_KEYS = 0x100;
+    static const int SPECIAL_KEY_BASE = 0x01000000;
+    static const int PREFIX_BASE = 64;        // 表项 >= PREFIX_BASE 表示和弦前缀
+
+    // 一层键位：根层或某个和弦前缀之后的第二段
+    struct Layer {
+        qint8 printable[MODIFIER_SLOTS][PRINTABLE_KEYS];
+        qint8 special[MODIFIER_SLOTS][SPECIAL_KEYS];
+    };
+
+    // 按键对应的表项，按键码超出范围时返回 nullptr
+    qint8 *entry(int layer, int key, Qt::KeyboardModifiers modifiers);
+
+    // 按键码是否落在定长数组的范围内
+    static bool isTableKey(int key);
+
+    // 前缀层的分配与回收：没有任何键位的层视为空闲，指向它的前缀被清除
+    bool isEmptyLayer(int layer) const;
+    int freeLayer() const;
+    void releaseEmptyPrefixes();
+
+    static int modifierSlot(Qt::KeyboardModifiers modifiers);
+    static bool isModifierKey(int key);
+
+    std::vector<Layer> m_layers;   // [0] 为根层
+    int m_pendingLayer;            // 和弦进行中时为前缀层下标，否则为 0
+};
+
+} // namespace Calculator
+
+#endif // KEYDISPATCHTABLE_H
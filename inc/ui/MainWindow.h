@@ -10,12 +10,20 @@
 #define MAINWINDOW_H
 
 #include "../../inc/core/CalculatorEngine.h"
+#include "../../inc/core/HistoryIndex.h"
+#include "../../inc/core/HistoryLog.h"
 #include "../../inc/utils/SettingsManager.h"
 #include "DisplayPanel.h"
+#include "ButtonTable.h"
+#include "DisplayUpdateCoalescer.h"
+#include "HistoryListModel.h"
+#include "KeyDispatchTable.h"
+#include "NumPadButton.h"
+#include "Theme.h"
 #include <QMainWindow>
 #include <QLineEdit>
+#include <QListView>
 #include <QPushButton>
-#include <QMap>
 
 namespace Calculator {
 
@@ -37,31 +45,28 @@ protected:
     
     // 重写窗口关闭事件
     void closeEvent(QCloseEvent *event) override;
+    
+    // 监视显示面板的首次绘制
+    bool eventFilter(QObject *watched, QEvent *event) override;
 
 private slots:
-    // 计算器按钮点击槽函数
-    void onDigitClicked();
-
-    // 其他按钮点击槽函数
-    void onOperatorClicked();
-    
-    // 其他按钮点击槽函数
-    void onFunctionClicked();
-    
-    // 等号按钮点击槽函数
-    void onEqualsClicked();
-    
-    // 小数点按钮点击槽函数
-    void onDecimalClicked();
+    // 按钮点击槽函数，id 为按钮描述表中的下标
+    void onButtonClicked(int id);
     
     // 显示内容改变槽函数
     void onDisplayChanged(const QString &text);
     
-    // 处理计算错误槽函数
-    void onErrorOccurred(ErrorType errorType);
+    // 主题切换槽函数（参数为主题名）
+    void onThemeChanged(const QString &theme);
+    
+    // 首帧显示后执行的延迟初始化
+    void completeInitialization();
+
+    // 重新加载设置中的键位
+    void loadKeyBindings();
 
-    // 处理计算器状态更新槽函数
-    void onEngineStateUpdated(const CalculatorState& state);
+    // 按搜索框内容过滤历史列表
+    void applyHistorySearch();
 
 private:
     // 初始化UI组件
@@ -70,21 +75,41 @@ private:
     // 连接信号和槽
     void setupConnections();
     
-    // 加载和保存设置
-    void loadStyleSheet();
+    // 加载设置中的主题
+    void loadTheme();
+    
+    // 应用编译期生成的主题
+    void applyTheme(const ThemeData &theme);
+
+    // 切换到下一个可用主题
+    void cycleTheme();
+
+    // 执行键位表中的命令
+    void executeCommand(int command);
+
+    // 输入处理完后显示没有失效时结束其延迟区间（见 TraceRecorder::endIdleInputs）
+    void endInputIfIdle();
+    
+    // 打开历史记录文件并交给引擎记录
+    void openHistory();
     
     // 保存和恢复窗口状态
     void saveWindowState();
     void restoreWindowState();
-    
-    // 设置按钮样式
-    void setupButtonStyles();
 
 private:
     QWidget *m_centralWidget;              // 中央窗口部件
     DisplayPanel *m_displayPanel;             // 计算结果显示面板
     CalculatorEngine *m_engine;            // 计算器引擎
-    QMap<QString, QPushButton*> m_buttons; // 按钮映射表
+    DisplayUpdateCoalescer *m_displayUpdater; // 显示刷新合并器
+    QLineEdit *m_historySearch;            // 历史搜索框
+    QListView *m_historyView;              // 历史列表
+    HistoryListModel *m_historyModel;      // 历史列表模型（打开历史记录后创建）
+    bool m_deferredInitScheduled;          // 延迟初始化是否已安排
+    NumPadButton *m_buttons[BUTTON_COUNT]; // 按钮，下标即按钮 id
+    KeyDispatchTable m_keyDispatch;        // 键盘分发表
+    HistoryLog m_history;                  // 计算历史（内存映射文件）
+    HistoryIndex m_historyIndex;           // 历史检索索引（首次搜索时建立）
 };
 
 }
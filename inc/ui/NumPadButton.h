@@ -10,6 +10,7 @@
 #define NUMPADBUTTON_H
 
 #include "../core/CalculationTypes.h"
+#include "Theme.h"
 #include <QPushButton>
 #include <QPainter>
 
@@ -35,6 +36,9 @@ public:
     
     // 设置按钮对应的键盘快捷键
     void setShortcutKey(int key);
+    
+    // 应用主题（颜色在绘制时解析，字体在此处设置），nullptr 表示使用调色板
+    void setTheme(const ThemeData *theme);
 
 protected:
     // 重写绘制事件
@@ -61,6 +65,7 @@ private:
     bool m_isPressed;          // 按下状态
     bool m_isHovered;          // 悬停状态
     int m_shortcutKey;         // 快捷键
+    const ThemeData *m_theme;  // 当前主题（静态主题表中的条目）
 };
 
 } // namespace Calculator
@@ -0,0 +1,106 @@
+/**
+ * @file Theme.h
+ * @brief 编译期生成的界面主题
+ * @author Jisq
+ * @version 1.0
+ * @date 2025
+ */
+
+#ifndef THEME_H
+#define THEME_H
+
+#include "../core/CalculationTypes.h"
+#include <QBrush>
+#include <QColor>
+#include <QPalette>
+#include <QRect>
+#include <QString>
+
+namespace Calculator {
+
+// 按钮类型数量（ThemeData::buttons 按 ButtonType 的顺序索引）
+const int BUTTON_TYPE_COUNT = 5;
+
+/**
+ * @brief 主题颜色
+ * 固定颜色（可带纵向渐变），或引用应用默认调色板中的角色，对应样式表中的 palette(...)。
+ */
+struct ThemeColor {
+    int role;       // QPalette::ColorRole，QPalette::NoRole 表示使用 top/bottom
+    QRgb top;       // 渐变起点颜色（纯色时与 bottom 相同）
+    QRgb bottom;    // 渐变终点颜色
+};
+
+/**
+ * @brief 一个状态下的背景、边框与文字颜色
+ */
+struct ThemeBoxStyle {
+    ThemeColor background;
+    ThemeColor border;
+    ThemeColor text;
+};
+
+/**
+ * @brief 一类按钮的样式
+ */
+struct ThemeButtonStyle {
+    ThemeBoxStyle normal;    // 常态
+    ThemeBoxStyle hover;     // 悬停
+    ThemeBoxStyle pressed;   // 按下
+    int borderRadius;        // 圆角半径（像素）
+    int fontPixelSize;       // 字号（像素）
+    int fontWeight;          // 字重（CSS 取值 100-900）
+};
+
+/**
+ * @brief 主题数据
+ * 由 tools/qss2theme.py 在构建时根据 styles 目录下的样式表生成，运行时不解析样式表。
+ */
+struct ThemeData {
+    const char *name;                 // 主题名（样式表文件名，不含扩展名）
+    ThemeColor windowBackground;      // 主窗口背景
+    ThemeColor windowText;            // 主窗口文字
+    ThemeColor centralBackground;     // 中央部件背景
+    ThemeBoxStyle panel;              // 显示面板
+    ThemeColor panelFocusBorder;      // 显示面板获得焦点时的边框
+    ThemeColor panelErrorText;        // 显示面板错误状态的文字与边框
+    int panelRadius;                  // 显示面板圆角半径
+    int panelFontPixelSize;           // 显示面板字号
+    ThemeButtonStyle buttons[BUTTON_TYPE_COUNT];
+};
+
+/**
+ * @class Theme
+ * @brief 主题查找与颜色解析
+ */
+class Theme {
+public:
+    // 按主题名（如 "dark"）查找，样式表路径按文件名识别；找不到时返回 nullptr
+    static const ThemeData *find(const QString &nameOrPath);
+
+    // 默认主题（第一个样式表）
+    static const ThemeData &defaultTheme();
+
+    // 已编译的主题数量与访问
+    static int count();
+    static const ThemeData &at(int index);
+
+    // 按钮样式
+    static const ThemeButtonStyle &buttonStyle(const ThemeData &theme, ButtonType type);
+
+    // 解析颜色：调色板角色从 base 中取，渐变取起点颜色
+    static QColor color(const ThemeColor &color, const QPalette &base);
+
+    // 在 rect 上填充的画刷，渐变时为纵向线性渐变
+    static QBrush brush(const ThemeColor &color, const QPalette &base, const QRect &rect);
+
+    // 由主题生成窗口调色板
+    static QPalette palette(const ThemeData &theme, const QPalette &base);
+
+    // CSS 字重转换为 QFont 字重
+    static int fontWeight(int cssWeight);
+};
+
+} // namespace Calculator
+
+#endif // THEME_H
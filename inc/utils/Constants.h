@@ -28,7 +28,8 @@ public:
     static constexpr double MIN_CALCULATION_VALUE = -1e15;  // 最小计算值
 
     // 界面尺寸常量
-    static constexpr int WINDOW_WIDTH = 300;            // 窗口宽度
+    static constexpr int WINDOW_WIDTH = 300;            // 窗口宽度（计算区）
+    static constexpr int HISTORY_PANEL_WIDTH = 180;     // 历史面板宽度（含与计算区的间距）
     static constexpr int WINDOW_HEIGHT = 400;           // 窗口高度
     static constexpr int BUTTON_WIDTH = 60;             // 按钮宽度
     static constexpr int BUTTON_HEIGHT = 50;            // 按钮高度
@@ -0,0 +1,145 @@
+/**
+ * @file Metrics.h
+ * @brief 引擎运行指标：调用次数、耗时直方图与错误计数
+ * @author Jisq
+ * @version 1.0
+ * @date 2025
+ */
+
+#ifndef METRICS_H
+#define METRICS_H
+
+#include "../core/CalculationTypes.h"
+#include <QByteArray>
+#include <QString>
+#include <QtGlobal>
+#include <chrono>
+
+namespace Calculator {
+
+/**
+ * @brief 被计时的引擎操作
+ */
+enum class MetricOperation {
+    InputDigit,
+    InputOperator,
+    Calculate,
+    FormatNumber
+};
+
+/**
+ * @brief 对数线性（HDR 风格）的耗时直方图
+ * 以纳秒计：小于 SUB_BUCKETS 的值各占一个桶，此后每个 2 的幂区间再均分为 SUB_BUCKETS 个桶，
+ * 相对误差不超过 1/SUB_BUCKETS（约 6%），覆盖 1 ns 到约 2^MAX_EXPONENT ns（约 18 分钟）。
+ */
+struct LatencyHistogram {
+    static const int SUB_BUCKET_BITS = 4;
+    static const int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static const int MAX_EXPONENT = 40;
+    static const int BUCKET_COUNT = (MAX_EXPONENT - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    quint64 count;                  // 样本数
+    quint64 sumNs;                  // 耗时之和
+    quint64 buckets[BUCKET_COUNT];  // 各桶样本数
+
+    void clear();
+    void merge(const LatencyHistogram &other);
+
+    // 分位数 q（0..1）处的耗时上界（纳秒），没有样本时返回 0
+    quint64 percentile(double q) const;
+
+    static int bucketIndex(quint64 ns);
+    // 桶内的最大值（纳秒）
+    static quint64 bucketUpperBound(int index);
+};
+
+/**
+ * @brief 某一时刻的全部指标（各线程之和）
+ */
+struct MetricsSnapshot {
+    static const int OPERATION_COUNT = 4;
+    static const int ERROR_TYPE_COUNT = 5;
+
+    LatencyHistogram operations[OPERATION_COUNT];   // 按 MetricOperation 下标
+    quint64 errors[ERROR_TYPE_COUNT];               // 按 ErrorType 下标（NoError 不计）
+
+    const LatencyHistogram &operation(MetricOperation op) const {
+        return operations[static_cast<int>(op)];
+    }
+    quint64 errorCount(ErrorType error) const { return errors[static_cast<int>(error)]; }
+
+    // Prometheus 文本格式（text/plain; version=0.0.4）
+    QByteArray toPrometheusText() const;
+};
+
+/**
+ * @class Metrics
+ * @brief 指标的记录、汇总与定时导出
+ *
+ * 每个线程第一次记录时得到自己的计数块，记录只写本线程的计数块（无锁、无原子读改写）；
+ * snapshot() 汇总所有线程的计数块，线程退出时其计数并入汇总值，不会丢失。
+ *
+ * 指标在编译期开关：定义 CALCULATOR_ENABLE_METRICS（qmake 中 CONFIG += metrics）时，
+ * 下面的 CALCULATOR_METRIC_* 宏才会展开为记录代码；未定义时它们为空，引擎没有任何额外开销，
+ * snapshot() 返回全零。
+ */
+class Metrics {
+public:
+    // 编译时是否启用了指标
+    static bool isEnabled();
+
+    static void recordLatency(MetricOperation op, quint64 ns);
+    static void recordError(ErrorType error);
+
+    static MetricsSnapshot snapshot();
+
+    // 清零所有线程的计数（用于测试与基准，不应与记录并发调用）
+    static void reset();
+
+    // 把当前快照以 Prometheus 文本格式原子地写入 path（先写临时文件再改名）
+    static bool writePrometheusFile(const QString &path);
+
+    // 后台线程每隔 intervalMs 毫秒导出一次；再次调用会替换之前的设置
+    static void startPeriodicDump(const QString &path, int intervalMs);
+    // 停止定时导出，停止前再导出一次
+    static void stopPeriodicDump();
+
+    /**
+     * @brief 作用域计时：构造时开始，析构时记录
+     */
+    class ScopedTimer {
+    public:
+        explicit ScopedTimer(MetricOperation op)
+            : m_operation(op)
+            , m_start(std::chrono::steady_clock::now()) {}
+        ~ScopedTimer() {
+            const std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - m_start;
+            recordLatency(m_operation, static_cast<quint64>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+        }
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    private:
+        MetricOperation m_operation;
+        std::chrono::steady_clock::time_point m_start;
+    };
+};
+
+} // namespace Calculator
+
+#ifdef CALCULATOR_ENABLE_METRICS
+#define CALCULATOR_METRIC_CONCAT_(a, b) a##b
+#define CALCULATOR_METRIC_CONCAT(a, b) CALCULATOR_METRIC_CONCAT_(a, b)
+// 为所在作用域计时
+#define CALCULATOR_METRIC_SCOPE(op) \
+    ::Calculator::Metrics::ScopedTimer CALCULATOR_METRIC_CONCAT(metricScope, __LINE__)(op)
+// 记录一次错误
+#define CALCULATOR_METRIC_ERROR(error) ::Calculator::Metrics::recordError(error)
+#else
+#define CALCULATOR_METRIC_SCOPE(op) do {} while (false)
+#define CALCULATOR_METRIC_ERROR(error) do {} while (false)
+#endif
+
+#endif // METRICS_H
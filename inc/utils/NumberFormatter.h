@@ -0,0 +1,39 @@
+/**
+ * @file NumberFormatter.h
+ * @brief 无堆分配的数字格式化
+ * @author Jisq
+ * @version 1.0
+ * @date 2025
+ */
+
+#ifndef NUMBERFORMATTER_H
+#define NUMBERFORMATTER_H
+
+#include "Constants.h"
+
+namespace Calculator {
+
+/**
+ * @class NumberFormatter
+ * @brief 双精度数字格式化工具
+ * 输出与 QString::number(value, 'g', significantDigits) 相同的文本：
+ * 按有效数字正确舍入（恰好一半时远离零），去除尾随零，
+ * 十进制指数小于 -4 或不小于有效位数时使用 "1.5e-10" 形式的科学计数法。
+ * 结果直接写入调用者提供的缓冲区，不做任何堆分配，与区域设置无关。
+ * 常见的整数与 [1e-8, 2^64) 范围内的值用 64/128 位整数运算精确求得数字，
+ * 其余情况使用栈上定长大整数的精确除法。
+ */
+class NumberFormatter
+{
+public:
+    // 格式化到 buffer（至少 BUFFER_SIZE 字节，不写结尾 '\0'），返回写入的字符数
+    static int format(double value, char *buffer,
+                      int significantDigits = Constants::MAX_DISPLAY_LENGTH);
+
+    static constexpr int MAX_SIGNIFICANT_DIGITS = 17;  // 可区分任意两个 double 的位数
+    static constexpr int BUFFER_SIZE = 32;             // 最长输出 "-d.dddddddddddddddde-308"
+};
+
+} // namespace Calculator
+
+#endif // NUMBERFORMATTER_H
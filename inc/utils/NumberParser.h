@@ -0,0 +1,41 @@
+/**
+ * @file NumberParser.h
+ * @brief 与区域设置无关的十进制数字解析
+ * @author Jisq
+ * @version 1.0
+ * @date 2025
+ */
+
+#ifndef NUMBERPARSER_H
+#define NUMBERPARSER_H
+
+namespace Calculator {
+
+/**
+ * @class NumberParser
+ * @brief 十进制数字解析工具
+ * 常见的短数字（不超过19位有效数字、指数较小）直接用整数尾数与精确的
+ * 10的幂计算出正确舍入的结果；其余情况回退到 Qt 的 C 区域解析。
+ */
+class NumberParser
+{
+public:
+    // 解析无符号十进制数字 "digits[.digits][e[+-]digits]"，
+    // 返回消耗的字符数，0 表示开头不是数字
+    static int parse(const char *text, int length, double &value);
+
+    static constexpr int MAX_EXACT_POWER = 22;  // double 可精确表示的最大10的幂
+
+    // 精确的 10^exponent（0 <= exponent <= MAX_EXACT_POWER），可在常量表达式中使用
+    static constexpr double exactPowerOfTen(int exponent) { return EXACT_POWERS_OF_TEN[exponent]; }
+
+private:
+    static constexpr double EXACT_POWERS_OF_TEN[MAX_EXACT_POWER + 1] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+};
+
+} // namespace Calculator
+
+#endif // NUMBERPARSER_H
@@ -9,12 +9,23 @@
 #ifndef SETTINGSMANAGER_H
 #define SETTINGSMANAGER_H
 
+#include "SettingsWriter.h"
+#include <QByteArray>
+#include <QMap>
 #include <QObject>
-#include <QSettings>
 #include <QString>
+#include <QStringList>
 
 namespace Calculator {
 
+/**
+ * @class SettingsManager
+ * @brief 设置的内存缓存
+ *
+ * 构造时从 QSettings 读取一次全部设置到类型化的成员中，之后读取只是成员访问；
+ * 修改先更新缓存，值确实变化时才交给 SettingsWriter 在后台线程合并写盘，
+ * 界面线程（包括 closeEvent）不会等待磁盘 I/O。
+ */
 class SettingsManager : public QObject
 {
     Q_OBJECT
@@ -43,14 +54,36 @@ public:
     QString getLanguage() const;
     void setLanguage(const QString &language);
 
+    // 键位设置：命令名 -> QKeySequence 可移植文本（多个键位用 "; " 分隔），只含用户覆盖的命令
+    QMap<QString, QString> getKeyBindings() const;
+    // 覆盖某个命令的键位，sequence 为空字符串时解除绑定，传入空 QString() 时恢复默认
+    void setKeyBinding(const QString &command, const QString &sequence);
+
+    // 补写缺失的默认设置（由后台线程写盘，启动时在首帧之后调用）
+    void writeDefaults();
+
+    // 阻塞到所有修改写入磁盘（事件循环结束后调用）
+    void waitForWrites();
+
 signals:
     void themeChanged(const QString &newTheme);
+    void keyBindingsChanged();
 
 private:
     explicit SettingsManager(QObject *parent = nullptr);
     ~SettingsManager() = default;
 
-    QSettings m_settings;
+    // 从 QSettings 读取全部设置
+    void load();
+
+    QString m_stylePreference;
+    QByteArray m_windowGeometry;
+    bool m_soundEnabled;
+    QString m_language;
+    QMap<QString, QString> m_keyBindings;   // 只含用户覆盖的命令
+    QStringList m_missingDefaults;          // 加载时文件中缺少的默认设置键
+
+    SettingsWriter m_writer;                // 最后析构：写完剩余修改
 };
 
 }
@@ -0,0 +1,71 @@
+/**
+ * @file SettingsWriter.h
+ * @brief 设置的后台写入线程
+ * @author Jisq
+ * @version 1.0
+ * @date 2025
+ */
+
+#ifndef SETTINGSWRITER_H
+#define SETTINGSWRITER_H
+
+#include <QMap>
+#include <QString>
+#include <QVariant>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace Calculator {
+
+/**
+ * @class SettingsWriter
+ * @brief 合并设置修改并在后台线程写入 QSettings
+ *
+ * setValue() / remove() 只把修改记入待写表（同一键只保留最后一次）并立即返回；
+ * 写入线程在第一次修改后等待 COALESCE_MS，把期间的所有修改一次写入并 sync()。
+ * 写入线程在第一次修改时才启动，析构时写完剩余修改后退出。
+ */
+class SettingsWriter {
+public:
+    static const int COALESCE_MS = 500;     // 合并窗口（毫秒）
+
+    SettingsWriter(const QString &organization, const QString &application);
+    ~SettingsWriter();
+
+    SettingsWriter(const SettingsWriter&) = delete;
+    SettingsWriter& operator=(const SettingsWriter&) = delete;
+
+    void setValue(const QString &key, const QVariant &value);
+    void remove(const QString &key);
+
+    // 不再等待合并窗口，尽快写入（不阻塞调用方）
+    void flush();
+
+    // 阻塞到已提交的修改全部写入磁盘
+    void waitForIdle();
+
+    // 已完成的写入批次数
+    quint64 batchCount() const;
+
+private:
+    void enqueue(const QString &key, const QVariant &value);
+    void run();
+
+    const QString m_organization;
+    const QString m_application;
+
+    mutable std::mutex m_mutex;             // 保护以下状态
+    std::condition_variable m_wakeCondition;    // 有修改、请求立即写入或退出
+    std::condition_variable m_idleCondition;    // 一批写入完成
+    QMap<QString, QVariant> m_pending;      // 待写入的修改，无效 QVariant 表示删除
+    bool m_flushRequested;
+    bool m_writing;
+    bool m_stopping;
+    quint64 m_batches;
+    std::thread m_thread;
+};
+
+} // namespace Calculator
+
+#endif // SETTINGSWRITER_H
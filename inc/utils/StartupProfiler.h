@@ -0,0 +1,60 @@
+/**
+ * @file StartupProfiler.h
+ * @brief 启动阶段计时
+ * @author Jisq
+ * @version 1.0
+ * @date 2025
+ */
+
+#ifndef STARTUPPROFILER_H
+#define STARTUPPROFILER_H
+
+#include <QElapsedTimer>
+
+namespace Calculator {
+
+/**
+ * @class StartupProfiler
+ * @brief 记录冷启动各阶段的时间戳
+ * 时间从 main() 入口调用 start() 开始计算。阶段记录总是进行（固定数组，无内存分配），
+ * 只有启用后（--startup-profile）才在 report() 时输出到标准错误。
+ */
+class StartupProfiler {
+public:
+    static constexpr int MAX_PHASES = 32;
+
+    static StartupProfiler &instance();
+
+    // 开始计时（main() 的第一条语句）
+    void start();
+
+    // 记录一个阶段完成的时间，phase 须为字符串常量
+    void mark(const char *phase);
+
+    // 是否在 report() 时输出
+    void setEnabled(bool enabled) { m_enabled = enabled; }
+    bool isEnabled() const { return m_enabled; }
+
+    // 输出各阶段的累计与增量耗时（未启用或已输出过时不做任何事）
+    void report();
+
+    int phaseCount() const { return m_count; }
+
+private:
+    StartupProfiler();
+
+    struct Phase {
+        const char *name;
+        qint64 elapsedNs;
+    };
+
+    QElapsedTimer m_timer;
+    Phase m_phases[MAX_PHASES];
+    int m_count;
+    bool m_enabled;
+    bool m_reported;
+};
+
+} // namespace Calculator
+
+#endif // STARTUPPROFILER_H
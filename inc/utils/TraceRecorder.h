@@ -0,0 +1,143 @@
+/**
+ * @file TraceRecorder.h
+ * @brief 输入到绘制延迟的事件追踪
+ * @author Jisq
+ * @version 1.0
+ * @date 2025
+ */
+
+#ifndef TRACERECORDER_H
+#define TRACERECORDER_H
+
+#include <QByteArray>
+#include <QString>
+#include <QtGlobal>
+#include <atomic>
+#include <memory>
+
+namespace Calculator {
+
+/**
+ * @class TraceRecorder
+ * @brief 固定容量的环形事件缓冲，导出为 Chrome trace JSON（Perfetto 可直接打开）
+ *
+ * 未启用时每个追踪点只有一次原子读与分支。启用后事件写入预先分配的环形缓冲：
+ * 写者用 fetch_add 取得槽位，写完字段后发布槽位的序列号（无锁，多线程可同时写入）；
+ * 缓冲写满后覆盖最旧的事件，内存不随运行时间增长。
+ *
+ * 输入延迟用异步事件表示：beginInput() 在按键或点击被分发为命令时开始一段 "input"，
+ * 显示面板下一次绘制完成时 endInputs() 结束所有未结束的输入，
+ * 因此在时间线上可以直接看到每次输入到屏幕更新的耗时。
+ * 输入没有改变显示（不会触发重绘）时由 endIdleInputs() 立即结束，不把空闲时间计为延迟。
+ * 事件名与分类必须是字符串常量（只保存指针）。
+ */
+class TraceRecorder {
+public:
+    static const int DEFAULT_CAPACITY = 1 << 16;   // 默认事件数（约 3 MB）
+    static const int MAX_OPEN_INPUTS = 64;          // 同时未结束的输入数上限
+
+    static TraceRecorder &instance();
+
+    // 分配缓冲并开始记录（capacity 向上取整为 2 的幂）；只应在启动时调用一次
+    void enable(int capacity = DEFAULT_CAPACITY);
+    void disable();
+    static bool isEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+    // 自 enable() 以来的纳秒数
+    qint64 now() const;
+
+    // 记录一段已完成的区间
+    void complete(const char *category, const char *name, qint64 startNs, qint64 durationNs);
+    // 记录一个瞬时事件
+    void instant(const char *category, const char *name);
+
+    // 输入到达与绘制完成（见类说明）
+    void beginInput(const char *name);
+    void endInputs();
+
+    // 显示已改变、重绘即将发生：未结束的输入留给那次重绘结束
+    void markPaintPending();
+    // 没有等待中的重绘时结束未结束的输入（输入没有引起显示变化）
+    void endIdleInputs();
+
+    // 已写入的事件总数（含被覆盖的）
+    quint64 eventCount() const { return m_next.load(std::memory_order_relaxed); }
+
+    // 导出缓冲中仍保留的事件
+    QByteArray toChromeTraceJson() const;
+    bool writeChromeTrace(const QString &path) const;
+
+    /**
+     * @brief 作用域追踪点：析构时记录一段完整区间
+     */
+    class Scope {
+    public:
+        Scope(const char *category, const char *name)
+            : m_category(category)
+            , m_name(name)
+            , m_start(isEnabled() ? instance().now() : -1) {}
+        ~Scope() {
+            if (m_start >= 0) {
+                TraceRecorder &recorder = instance();
+                recorder.complete(m_category, m_name, m_start, recorder.now() - m_start);
+            }
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        const char *m_category;
+        const char *m_name;
+        qint64 m_start;     // 未启用时为 -1
+    };
+
+private:
+    TraceRecorder();
+
+    // Chrome trace 的事件类型
+    enum Phase : quint8 {
+        Complete = 'X',
+        Instant = 'i',
+        AsyncBegin = 'b',
+        AsyncEnd = 'e'
+    };
+
+    // 一个事件槽，字段均为原子量，导出与写入并发时没有数据竞争
+    struct Event {
+        std::atomic<quint64> sequence;      // 写完后为事件序号 + 1，写入中为 0
+        std::atomic<const char*> category;
+        std::atomic<const char*> name;
+        std::atomic<qint64> start;          // 纳秒
+        std::atomic<qint64> duration;       // 纳秒（仅 Complete）
+        std::atomic<quint64> id;            // 异步事件编号（仅 AsyncBegin / AsyncEnd）
+        std::atomic<quint32> thread;        // 线程编号
+        std::atomic<quint8> phase;
+    };
+
+    void record(Phase phase, const char *category, const char *name,
+                qint64 start, qint64 duration, quint64 id);
+    static quint32 threadIndex();
+
+    static std::atomic<bool> s_enabled;
+
+    std::unique_ptr<Event[]> m_events;
+    quint64 m_mask;
+    std::atomic<quint64> m_next;            // 下一个事件序号
+    std::atomic<qint64> m_origin;           // enable() 时的 steady_clock 纳秒数
+
+    // 未结束的输入编号区间 [m_firstOpenInput, m_nextInput)
+    std::atomic<quint64> m_nextInput;
+    std::atomic<quint64> m_firstOpenInput;
+    std::atomic<bool> m_paintPending;       // markPaintPending() 之后、下一次 endInputs() 之前为真
+};
+
+} // namespace Calculator
+
+// 为所在作用域添加追踪点
+#define CALCULATOR_TRACE_CONCAT_(a, b) a##b
+#define CALCULATOR_TRACE_CONCAT(a, b) CALCULATOR_TRACE_CONCAT_(a, b)
+#define CALCULATOR_TRACE_SCOPE(category, name) \
+    ::Calculator::TraceRecorder::Scope CALCULATOR_TRACE_CONCAT(traceScope, __LINE__)(category, name)
+
+#endif // TRACERECORDER_H
@@ -0,0 +1,95 @@
+/**
+ * @file WorkStealingPool.h
+ * @brief 任务窃取线程池
+ * @author Jisq
+ * @version 1.0
+ * @date 2025
+ */
+
+#ifndef WORKSTEALINGPOOL_H
+#define WORKSTEALINGPOOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Calculator {
+
+/**
+ * @class WorkStealingPool
+ * @brief 任务窃取线程池
+ * 每次 run() 把编号为 [0, taskCount) 的任务按区间平均分给各个工作线程，
+ * 线程从自己区间的头部取任务；自己的区间取空后，从其他线程区间的尾部窃取一半。
+ * 工作线程常驻，多次 run() 之间复用。
+ */
+class WorkStealingPool {
+public:
+    // 任务函数：worker 为执行线程编号（0..threadCount-1），task 为任务编号
+    typedef std::function<void(int worker, std::size_t task)> TaskFunction;
+
+    /**
+     * @brief 单个工作线程在最近一次 run() 中的统计
+     */
+    struct WorkerStats {
+        std::uint64_t tasks;        // 执行的任务数
+        std::uint64_t steals;       // 成功窃取的次数
+        std::int64_t busyNs;        // 执行任务的总耗时（纳秒）
+    };
+
+    // threadCount 为 0 时使用硬件线程数
+    explicit WorkStealingPool(int threadCount = 0);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    // 执行全部任务，阻塞直到完成
+    void run(std::size_t taskCount, const TaskFunction &function);
+
+    int threadCount() const { return static_cast<int>(m_ranges.size()); }
+    const std::vector<WorkerStats> &stats() const { return m_stats; }
+
+private:
+    /**
+     * @brief 每个线程的任务区间 [begin, end)
+     * 按缓存行对齐，每个区间独占缓存行，避免相邻线程的区间互相伪共享。
+     */
+    struct alignas(64) TaskRange {
+        std::mutex mutex;
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    // 工作线程主循环
+    void workerLoop(int worker);
+
+    // 执行当前批次直到取不到任务
+    void execute(int worker);
+
+    // 从自己的区间头部取一个任务
+    bool popLocal(int worker, std::size_t &task);
+
+    // 从其他线程的区间尾部窃取一半，返回其中第一个任务
+    bool steal(int worker, std::size_t &task);
+
+private:
+    std::vector<TaskRange> m_ranges;        // 各线程的任务区间
+    std::vector<WorkerStats> m_stats;       // 各线程统计
+    std::vector<std::thread> m_threads;     // 工作线程
+
+    std::mutex m_mutex;                     // 保护以下批次状态
+    std::condition_variable m_startCondition;
+    std::condition_variable m_doneCondition;
+    const TaskFunction *m_function;         // 当前批次的任务函数
+    std::uint64_t m_generation;             // 批次编号
+    int m_activeWorkers;                    // 尚未完成当前批次的线程数
+    bool m_stopping;                        // 线程池正在析构
+};
+
+} // namespace Calculator
+
+#endif // WORKSTEALINGPOOL_H
@@ -0,0 +1,234 @@
+/**
+ * @file BatchRunner.cpp
+ * @brief 无界面批量求值实现
+ */
+
+#include "../../inc/batch/BatchRunner.h"
+#include "../../inc/batch/ParallelBatchEvaluator.h"
+#include "../../inc/core/CalculatorEngine.h"
+#include "../../inc/core/KeystrokeReplay.h"
+#include <QElapsedTimer>
+#include <QFile>
+#include <QDebug>
+#include <cstdio>
+#include <cstring>
+
+namespace Calculator {
+
+namespace {
+
+const int READ_CHUNK_SIZE = 1 << 20;      // 每次读取的字节数
+const int OUTPUT_FLUSH_SIZE = 1 << 20;    // 输出缓冲刷新阈值
+
+} // namespace
+
+BatchRunner::BatchRunner(const BatchOptions &options)
+    : m_options(options)
+    , m_lines(0)
+    , m_keystrokes(0)
+    , m_unknownKeys(0)
+{
+}
+
+int BatchRunner::run() {
+    QFile input;
+    bool inputOpened = false;
+    if (m_options.inputPath.isEmpty()) {
+        inputOpened = input.open(stdin, QIODevice::ReadOnly);
+    } else {
+        input.setFileName(m_options.inputPath);
+        inputOpened = input.open(QIODevice::ReadOnly);
+    }
+    if (!inputOpened) {
+        qCritical() << "无法打开输入:" << m_options.inputPath << input.errorString();
+        return 1;
+    }
+
+    QFile output;
+    bool outputOpened = false;
+    if (m_options.outputPath.isEmpty()) {
+        outputOpened = output.open(stdout, QIODevice::WriteOnly);
+    } else {
+        output.setFileName(m_options.outputPath);
+        outputOpened = output.open(QIODevice::WriteOnly | QIODevice::Truncate);
+    }
+    if (!outputOpened) {
+        qCritical() << "无法打开输出:" << m_options.outputPath << output.errorString();
+        return 1;
+    }
+
+    if (m_options.cacheSlots > 0) {
+        m_resultCache.reset(new ResultCache(m_options.cacheSlots));
+    }
+
+    if (m_options.expressions && m_options.jobs != 1) {
+        return runParallel(input, output);
+    }
+
+    // 屏蔽引擎信号：批处理不需要逐键格式化显示文本
+    CalculatorEngine engine;
+    engine.blockSignals(true);
+    if (m_options.numericBackend == NumericBackendType::Decimal) {
+        engine.setNumericBackend(std::unique_ptr<NumericBackend>(
+            new DecimalBackend(DecimalPolicy(m_options.decimalContext))));
+    } else {
+        engine.setNumericBackend(m_options.numericBackend);
+    }
+    engine.setResultCache(m_resultCache.get());
+
+    // 预留输出缓冲，刷新后复用同一块内存
+    m_output.reserve(OUTPUT_FLUSH_SIZE * 2);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // 分块读取并按行切分，避免逐行分配
+    QByteArray buffer;
+    buffer.resize(READ_CHUNK_SIZE);
+    int filled = 0;
+    bool atEnd = false;
+
+    while (!atEnd) {
+        if (filled == buffer.size()) {
+            buffer.resize(buffer.size() * 2);  // 单行超过缓冲区时扩容
+        }
+        qint64 bytesRead = input.read(buffer.data() + filled, buffer.size() - filled);
+        if (bytesRead <= 0) {
+            atEnd = true;
+        } else {
+            filled += static_cast<int>(bytesRead);
+        }
+
+        const char *data = buffer.constData();
+        int lineStart = 0;
+        for (;;) {
+            const void *newline = std::memchr(data + lineStart, '\n', filled - lineStart);
+            if (!newline) {
+                break;
+            }
+            int lineEnd = static_cast<int>(static_cast<const char*>(newline) - data);
+            processLine(engine, data + lineStart, lineEnd - lineStart);
+            lineStart = lineEnd + 1;
+        }
+
+        // 文件末尾没有换行的最后一行
+        if (atEnd && lineStart < filled) {
+            processLine(engine, data + lineStart, filled - lineStart);
+            lineStart = filled;
+        }
+
+        // 将未完成的行移动到缓冲区开头
+        if (lineStart > 0) {
+            std::memmove(buffer.data(), data + lineStart, filled - lineStart);
+            filled -= lineStart;
+        }
+
+        if (m_output.size() >= OUTPUT_FLUSH_SIZE && !flushOutput(output)) {
+            return 1;
+        }
+    }
+
+    if (!flushOutput(output)) {
+        return 1;
+    }
+
+    if (m_options.printStats) {
+        reportStats(timer.nsecsElapsed());
+    }
+    return 0;
+}
+
+int BatchRunner::runParallel(QIODevice &input, QIODevice &output) {
+    QElapsedTimer timer;
+    timer.start();
+
+    const QByteArray data = input.readAll();
+    ParallelBatchEvaluator evaluator(m_options.jobs);
+    evaluator.setResultCache(m_resultCache.get());
+    evaluator.evaluate(data, m_options.quiet ? nullptr : &m_output);
+    m_lines = evaluator.lineCount();
+    // 与 processLine() 相同，按键数不含行结束符
+    m_keystrokes = data.size() - data.count('\n');
+
+    if (!flushOutput(output)) {
+        return 1;
+    }
+
+    if (m_options.printStats) {
+        reportStats(timer.nsecsElapsed());
+
+        // 各线程吞吐
+        const std::vector<ParallelBatchEvaluator::WorkerReport> reports = evaluator.workerReports();
+        for (std::size_t i = 0; i < reports.size(); ++i) {
+            const ParallelBatchEvaluator::WorkerReport &report = reports[i];
+            const double busySeconds = report.busyNs > 0 ? report.busyNs / 1e9 : 1e-9;
+            std::fprintf(stderr,
+                         "worker %2d: %lld lines  %lld chunks  %lld steals  busy %.3f s  %.0f lines/s\n",
+                         static_cast<int>(i),
+                         static_cast<long long>(report.lines),
+                         static_cast<long long>(report.chunks),
+                         static_cast<long long>(report.steals),
+                         busySeconds,
+                         report.lines / busySeconds);
+        }
+    }
+    return 0;
+}
+
+void BatchRunner::processLine(CalculatorEngine &engine, const char *line, int length) {
+    if (m_options.expressions) {
+        engine.evaluateExpression(QString::fromUtf8(line, length));
+    } else {
+        if (!m_options.keepState) {
+            engine.clearAll();
+        }
+        m_unknownKeys += replayKeystrokes(engine, line, length);
+    }
+    m_keystrokes += length;
+    ++m_lines;
+
+    if (!m_options.quiet) {
+        m_output.append(engine.getDisplayText().toUtf8());
+        m_output.append('\n');
+    }
+}
+
+bool BatchRunner::flushOutput(QIODevice &device) {
+    if (m_output.isEmpty()) {
+        return true;
+    }
+    if (device.write(m_output) != m_output.size()) {
+        qCritical() << "写入输出失败:" << device.errorString();
+        return false;
+    }
+    m_output.resize(0);
+    return true;
+}
+
+void BatchRunner::reportStats(qint64 elapsedNs) const {
+    double seconds = elapsedNs / 1e9;
+    if (seconds <= 0.0) {
+        seconds = 1e-9;
+    }
+    std::fprintf(stderr,
+                 "lines: %lld  keystrokes: %lld  unknown: %lld\n"
+                 "elapsed: %.3f s  throughput: %.0f keys/s  %.0f lines/s\n",
+                 static_cast<long long>(m_lines),
+                 static_cast<long long>(m_keystrokes),
+                 static_cast<long long>(m_unknownKeys),
+                 seconds,
+                 m_keystrokes / seconds,
+                 m_lines / seconds);
+
+    if (m_resultCache) {
+        const ResultCache::Stats cache = m_resultCache->stats();
+        const quint64 lookups = cache.hits + cache.misses;
+        std::fprintf(stderr, "result cache: %d slots  %llu hits  %llu misses  hit rate %.1f%%\n",
+                     m_resultCache->capacity(),
+                     static_cast<unsigned long long>(cache.hits),
+                     static_cast<unsigned long long>(cache.misses),
+                     lookups > 0 ? 100.0 * cache.hits / lookups : 0.0);
+    }
+}
+
+} // namespace Calculator
@@ -0,0 +1,117 @@
+/**
+ * @file ParallelBatchEvaluator.cpp
+ * @brief 多线程批量表达式求值实现
+ */
+
+#include "../../inc/batch/ParallelBatchEvaluator.h"
+#include "../../inc/core/CalculatorEngine.h"
+#include "../../inc/utils/NumberFormatter.h"
+#include <algorithm>
+#include <cstring>
+
+namespace Calculator {
+
+const int ParallelBatchEvaluator::CHUNK_LINES;
+
+ParallelBatchEvaluator::ParallelBatchEvaluator(int threadCount)
+    : m_pool(threadCount)
+    , m_contexts(m_pool.threadCount())
+    , m_input(nullptr)
+    , m_collectOutput(false)
+    , m_resultCache(nullptr)
+    , m_lineCount(0)
+{
+}
+
+void ParallelBatchEvaluator::evaluate(const QByteArray &input, QByteArray *output) {
+    // 单线程切分行：memchr 扫描远快于求值本身
+    m_lineOffsets.clear();
+    const char *data = input.constData();
+    const int size = input.size();
+    int lineStart = 0;
+    while (lineStart < size) {
+        m_lineOffsets.push_back(lineStart);
+        const void *newline = std::memchr(data + lineStart, '\n', size - lineStart);
+        lineStart = newline ? static_cast<int>(static_cast<const char*>(newline) - data) + 1 : size;
+    }
+    m_lineCount = static_cast<qint64>(m_lineOffsets.size());
+    m_lineOffsets.push_back(size);
+
+    const std::size_t chunks = (m_lineOffsets.size() - 1 + CHUNK_LINES - 1) / CHUNK_LINES;
+    m_chunkOutputs.assign(chunks, QByteArray());
+    for (std::size_t i = 0; i < m_contexts.size(); ++i) {
+        m_contexts[i].lines = 0;
+    }
+    m_input = &input;
+    m_collectOutput = output != nullptr;
+
+    m_pool.run(chunks, [this](int worker, std::size_t chunk) {
+        evaluateChunk(worker, chunk);
+    });
+
+    // 按输入顺序合并输出
+    if (output) {
+        int total = 0;
+        for (std::size_t i = 0; i < chunks; ++i) {
+            total += m_chunkOutputs[i].size();
+        }
+        output->reserve(output->size() + total);
+        for (std::size_t i = 0; i < chunks; ++i) {
+            output->append(m_chunkOutputs[i]);
+        }
+    }
+    m_chunkOutputs.clear();
+    m_input = nullptr;
+}
+
+std::vector<ParallelBatchEvaluator::WorkerReport> ParallelBatchEvaluator::workerReports() const {
+    const std::vector<WorkStealingPool::WorkerStats> &stats = m_pool.stats();
+    std::vector<WorkerReport> reports(stats.size());
+    for (std::size_t i = 0; i < stats.size(); ++i) {
+        reports[i].lines = m_contexts[i].lines;
+        reports[i].chunks = static_cast<qint64>(stats[i].tasks);
+        reports[i].steals = static_cast<qint64>(stats[i].steals);
+        reports[i].busyNs = stats[i].busyNs;
+    }
+    return reports;
+}
+
+void ParallelBatchEvaluator::evaluateChunk(int worker, std::size_t chunk) {
+    WorkerContext &context = m_contexts[worker];
+    QByteArray &out = m_chunkOutputs[chunk];
+    const char *data = m_input->constData();
+
+    const std::size_t firstLine = chunk * CHUNK_LINES;
+    const std::size_t lastLine = std::min(firstLine + CHUNK_LINES, m_lineOffsets.size() - 1);
+    for (std::size_t line = firstLine; line < lastLine; ++line) {
+        const int begin = m_lineOffsets[line];
+        int end = m_lineOffsets[line + 1];
+        if (end > begin && data[end - 1] == '\n') {
+            --end;
+        }
+
+        ErrorType error = ErrorType::NoError;
+        double value = 0.0;
+        if (!context.parser.parse(data + begin, end - begin, context.expression)) {
+            error = context.parser.error();
+        } else if (context.expression.variableCount() > 0) {
+            error = ErrorType::InvalidInput;  // 批处理中没有变量取值
+        } else {
+            value = context.expression.evaluate(nullptr, error, m_resultCache);
+        }
+
+        if (m_collectOutput) {
+            if (error == ErrorType::NoError) {
+                // 直接格式化到栈缓冲，不经过 QString
+                char text[NumberFormatter::BUFFER_SIZE];
+                out.append(text, NumberFormatter::format(value, text));
+            } else {
+                out.append(CalculatorEngine::errorText(error).toUtf8());
+            }
+            out.append('\n');
+        }
+    }
+    context.lines += static_cast<qint64>(lastLine - firstLine);
+}
+
+} // namespace Calculator
@@ -0,0 +1,186 @@
+/**
+ * @file main.cpp
+ * @brief 无界面批处理程序入口
+ * @author Jisq
+ * @version 1.0
+ * @date 2025
+ */
+
+#include "../../inc/batch/BatchRunner.h"
+#include "../../inc/utils/Metrics.h"
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDebug>
+
+#ifdef CALCULATOR_HAS_SERVER
+#include "../../inc/server/EngineServer.h"
+#include <csignal>
+#include <cstdio>
+#include <pthread.h>
+
+namespace {
+
+// 运行引擎服务直到收到 SIGINT 或 SIGTERM
+int runServer(const Calculator::ServerOptions &options, bool printStats)
+{
+    // 先屏蔽信号再创建线程，事件循环线程继承屏蔽字，信号只由主线程的 sigwait 取走
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+    Calculator::EngineServer server(options);
+    if (!server.start()) {
+        qCritical() << "无法启动服务:" << server.errorString();
+        return 1;
+    }
+    std::fprintf(stderr, "serving on %s with %d threads\n",
+                 options.socketPath.toLocal8Bit().constData(), server.threadCount());
+
+    int signal = 0;
+    sigwait(&signals, &signal);
+    server.stop();
+
+    if (printStats) {
+        const std::vector<Calculator::EngineServer::WorkerReport> reports = server.workerReports();
+        for (std::size_t i = 0; i < reports.size(); ++i) {
+            const Calculator::EngineServer::WorkerReport &report = reports[i];
+            std::fprintf(stderr,
+                         "worker %2d: %lld connections  %lld requests  %lld bytes in  %lld bytes out\n",
+                         static_cast<int>(i),
+                         static_cast<long long>(report.connections),
+                         static_cast<long long>(report.requests),
+                         static_cast<long long>(report.bytesIn),
+                         static_cast<long long>(report.bytesOut));
+        }
+    }
+    return 0;
+}
+
+} // namespace
+#endif
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("CalculatorBatch");
+    app.setApplicationVersion("1.0.0");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("计算器无界面批处理：逐行重放按键序列或求值表达式并输出显示结果");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    parser.addPositionalArgument("input", "输入文件，省略时读取标准输入");
+
+    QCommandLineOption outputOption(QStringList() << "o" << "output", "结果写入文件而不是标准输出", "file");
+    QCommandLineOption keepStateOption(QStringList() << "k" << "keep-state", "行与行之间保留计算器状态");
+    QCommandLineOption expressionOption(QStringList() << "x" << "expressions", "每行输入是中缀表达式（如 (1+2)*3）");
+    QCommandLineOption jobsOption(QStringList() << "j" << "jobs", "表达式模式的工作线程数（0 为全部核心，默认 1）", "n", "1");
+    QCommandLineOption backendOption(QStringList() << "b" << "backend", "按键模式的数值后端：double、rational（任意精度）或 decimal（十进制定点，默认 double）", "type", "double");
+    QCommandLineOption scaleOption("scale", "decimal 后端的小数位数（0-18，默认 10）", "n", "10");
+    QCommandLineOption roundingOption("rounding", "decimal 后端的舍入模式：half-even、half-up、down、up、ceiling、floor（默认 half-even）", "mode", "half-even");
+    QCommandLineOption cacheOption("cache", "双精度运算结果缓存的槽数（0 为不缓存，默认 0）", "slots", "0");
+    QCommandLineOption metricsFileOption("metrics-file", "结束时把引擎指标以 Prometheus 文本格式写入文件", "file");
+    QCommandLineOption quietOption(QStringList() << "q" << "quiet", "不输出结果，仅执行求值");
+    QCommandLineOption statsOption(QStringList() << "s" << "stats", "结束时向标准错误输出吞吐统计");
+    QCommandLineOption serveOption("serve", "不读取输入，在 Unix 域套接字上提供多会话引擎服务（仅 Linux，-j 为事件循环线程数，省略时为全部核心）", "socket");
+    QCommandLineOption maxSessionsOption("max-sessions", "服务模式下每个连接的会话数上限（默认 4096）", "n", "4096");
+    parser.addOption(outputOption);
+    parser.addOption(keepStateOption);
+    parser.addOption(expressionOption);
+    parser.addOption(jobsOption);
+    parser.addOption(backendOption);
+    parser.addOption(scaleOption);
+    parser.addOption(roundingOption);
+    parser.addOption(cacheOption);
+    parser.addOption(metricsFileOption);
+    parser.addOption(quietOption);
+    parser.addOption(statsOption);
+    parser.addOption(serveOption);
+    parser.addOption(maxSessionsOption);
+    parser.process(app);
+
+    if (parser.isSet(serveOption)) {
+#ifdef CALCULATOR_HAS_SERVER
+        // 会话是双精度的 EngineCore，不支持其他数值后端与结果缓存
+        if (parser.value(backendOption) != "double" || parser.value(cacheOption).toInt() != 0) {
+            qCritical() << "服务模式只支持 double 后端且不使用结果缓存";
+            return 1;
+        }
+        Calculator::ServerOptions serverOptions;
+        serverOptions.socketPath = parser.value(serveOption);
+        serverOptions.threads = parser.isSet(jobsOption) ? parser.value(jobsOption).toInt() : 0;
+        serverOptions.maxSessions = parser.value(maxSessionsOption).toInt();
+        if (serverOptions.maxSessions <= 0) {
+            qCritical() << "无效的会话数上限:" << parser.value(maxSessionsOption);
+            return 1;
+        }
+        return runServer(serverOptions, parser.isSet(statsOption));
+#else
+        qCritical() << "此平台的构建不包含服务模式";
+        return 1;
+#endif
+    }
+
+    Calculator::BatchOptions options;
+    const QStringList positional = parser.positionalArguments();
+    if (!positional.isEmpty()) {
+        options.inputPath = positional.first();
+    }
+    options.outputPath = parser.value(outputOption);
+    options.keepState = parser.isSet(keepStateOption);
+    options.expressions = parser.isSet(expressionOption);
+    options.jobs = parser.value(jobsOption).toInt();
+
+    const QString backend = parser.value(backendOption);
+    if (backend == "rational") {
+        options.numericBackend = Calculator::NumericBackendType::Rational;
+    } else if (backend == "decimal") {
+        options.numericBackend = Calculator::NumericBackendType::Decimal;
+    } else if (backend != "double") {
+        qCritical() << "未知的数值后端:" << backend;
+        return 1;
+    }
+
+    const QString rounding = parser.value(roundingOption);
+    Calculator::RoundingMode roundingMode;
+    if (rounding == "half-even") {
+        roundingMode = Calculator::RoundingMode::HalfEven;
+    } else if (rounding == "half-up") {
+        roundingMode = Calculator::RoundingMode::HalfUp;
+    } else if (rounding == "down") {
+        roundingMode = Calculator::RoundingMode::Down;
+    } else if (rounding == "up") {
+        roundingMode = Calculator::RoundingMode::Up;
+    } else if (rounding == "ceiling") {
+        roundingMode = Calculator::RoundingMode::Ceiling;
+    } else if (rounding == "floor") {
+        roundingMode = Calculator::RoundingMode::Floor;
+    } else {
+        qCritical() << "未知的舍入模式:" << rounding;
+        return 1;
+    }
+    options.decimalContext = Calculator::DecimalContext(parser.value(scaleOption).toInt(), roundingMode);
+    options.cacheSlots = parser.value(cacheOption).toInt();
+    if (options.cacheSlots < 0) {
+        qCritical() << "无效的缓存槽数:" << parser.value(cacheOption);
+        return 1;
+    }
+    options.quiet = parser.isSet(quietOption);
+    options.printStats = parser.isSet(statsOption);
+
+    Calculator::BatchRunner runner(options);
+    const int result = runner.run();
+
+    if (parser.isSet(metricsFileOption)) {
+        if (!Calculator::Metrics::isEnabled()) {
+            qWarning() << "未编入指标（构建时需 CONFIG+=metrics），导出的计数全为零";
+        }
+        if (!Calculator::Metrics::writePrometheusFile(parser.value(metricsFileOption))) {
+            qCritical() << "无法写入指标文件:" << parser.value(metricsFileOption);
+            return 1;
+        }
+    }
+    return result;
+}
@@ -0,0 +1,684 @@
+/**
+ * @file BigInteger.cpp
+ * @brief 任意精度整数实现
+ */
+
+#include "../../inc/core/BigInteger.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Calculator {
+
+namespace {
+
+typedef std::vector<std::uint32_t> Magnitude;
+
+const std::uint32_t DECIMAL_CHUNK = 1000000000u;   // 十进制转换时每段 9 位
+const int DECIMAL_CHUNK_DIGITS = 9;
+
+// 带溢出检查的机器字运算
+inline bool addOverflows(long long a, long long b, long long &result) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_add_overflow(a, b, &result);
+#else
+    if ((b > 0 && a > std::numeric_limits<long long>::max() - b) ||
+        (b < 0 && a < std::numeric_limits<long long>::min() - b)) {
+        return true;
+    }
+    result = a + b;
+    return false;
+#endif
+}
+
+inline bool subOverflows(long long a, long long b, long long &result) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_sub_overflow(a, b, &result);
+#else
+    if ((b < 0 && a > std::numeric_limits<long long>::max() + b) ||
+        (b > 0 && a < std::numeric_limits<long long>::min() + b)) {
+        return true;
+    }
+    result = a - b;
+    return false;
+#endif
+}
+
+inline bool mulOverflows(long long a, long long b, long long &result) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_mul_overflow(a, b, &result);
+#else
+    if (a == 0 || b == 0) {
+        result = 0;
+        return false;
+    }
+    const long long maxValue = std::numeric_limits<long long>::max();
+    const long long minValue = std::numeric_limits<long long>::min();
+    if ((a == -1 && b == minValue) || (b == -1 && a == minValue)) {
+        return true;
+    }
+    if (a > 0 ? (b > 0 ? a > maxValue / b : b < minValue / a)
+              : (b > 0 ? a < minValue / b : a < maxValue / b)) {
+        return true;
+    }
+    result = a * b;
+    return false;
+#endif
+}
+
+// 机器字的绝对值（避免 INT64_MIN 取负溢出）
+inline std::uint64_t absoluteValue(long long value) {
+    return value < 0 ? 0 - static_cast<std::uint64_t>(value)
+                     : static_cast<std::uint64_t>(value);
+}
+
+inline void trim(Magnitude &m) {
+    while (!m.empty() && m.back() == 0) {
+        m.pop_back();
+    }
+}
+
+int compareMagnitude(const std::uint32_t *a, size_t na, const std::uint32_t *b, size_t nb) {
+    if (na != nb) {
+        return na < nb ? -1 : 1;
+    }
+    for (size_t i = na; i-- > 0;) {
+        if (a[i] != b[i]) {
+            return a[i] < b[i] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+inline int compareMagnitude(const Magnitude &a, const Magnitude &b) {
+    return compareMagnitude(a.data(), a.size(), b.data(), b.size());
+}
+
+// out = a + b
+void addMagnitude(const std::uint32_t *a, size_t na, const std::uint32_t *b, size_t nb, Magnitude &out) {
+    if (na < nb) {
+        std::swap(a, b);
+        std::swap(na, nb);
+    }
+    out.resize(na + 1);
+    std::uint64_t carry = 0;
+    for (size_t i = 0; i < na; ++i) {
+        carry += a[i];
+        if (i < nb) {
+            carry += b[i];
+        }
+        out[i] = static_cast<std::uint32_t>(carry);
+        carry >>= 32;
+    }
+    out[na] = static_cast<std::uint32_t>(carry);
+    trim(out);
+}
+
+// a -= b（要求 a >= b）
+void subtractInPlace(Magnitude &a, const std::uint32_t *b, size_t nb) {
+    std::int64_t borrow = 0;
+    for (size_t i = 0; i < a.size(); ++i) {
+        std::int64_t diff = static_cast<std::int64_t>(a[i]) - borrow - (i < nb ? b[i] : 0);
+        borrow = diff < 0 ? 1 : 0;
+        a[i] = static_cast<std::uint32_t>(diff + (borrow << 32));
+        if (i >= nb && borrow == 0) {
+            break;
+        }
+    }
+    trim(a);
+}
+
+// out[offset..] += b
+void addInPlace(Magnitude &out, const Magnitude &b, size_t offset) {
+    if (out.size() < offset + b.size() + 1) {
+        out.resize(offset + b.size() + 1, 0);
+    }
+    std::uint64_t carry = 0;
+    size_t i = 0;
+    for (; i < b.size(); ++i) {
+        carry += static_cast<std::uint64_t>(out[offset + i]) + b[i];
+        out[offset + i] = static_cast<std::uint32_t>(carry);
+        carry >>= 32;
+    }
+    for (size_t k = offset + i; carry != 0; ++k) {
+        if (k == out.size()) {
+            out.push_back(0);
+        }
+        carry += out[k];
+        out[k] = static_cast<std::uint32_t>(carry);
+        carry >>= 32;
+    }
+}
+
+void schoolbookMultiply(const std::uint32_t *a, size_t na, const std::uint32_t *b, size_t nb, Magnitude &out) {
+    out.assign(na + nb, 0);
+    for (size_t i = 0; i < na; ++i) {
+        std::uint64_t carry = 0;
+        const std::uint64_t ai = a[i];
+        if (ai == 0) {
+            continue;
+        }
+        for (size_t j = 0; j < nb; ++j) {
+            carry += ai * b[j] + out[i + j];
+            out[i + j] = static_cast<std::uint32_t>(carry);
+            carry >>= 32;
+        }
+        out[i + nb] = static_cast<std::uint32_t>(carry);
+    }
+    trim(out);
+}
+
+/**
+ * @brief 大数乘法
+ * 两个操作数都不短于阈值时按 Karatsuba 拆分：
+ * a = a1·B^m + a0, b = b1·B^m + b0,
+ * a·b = z2·B^2m + (z1 - z2 - z0)·B^m + z0，其中 z1 = (a0 + a1)(b0 + b1)。
+ * 长度悬殊时先按较短操作数的长度分块，保证每次递归都是等长拆分。
+ */
+void multiplyMagnitude(const std::uint32_t *a, size_t na, const std::uint32_t *b, size_t nb, Magnitude &out) {
+    if (na < nb) {
+        std::swap(a, b);
+        std::swap(na, nb);
+    }
+    if (nb < static_cast<size_t>(BigInteger::KARATSUBA_THRESHOLD)) {
+        schoolbookMultiply(a, na, b, nb, out);
+        return;
+    }
+
+    if (na >= 2 * nb) {
+        // 不平衡：把较长的操作数切成与较短操作数等长的块
+        out.assign(na + nb, 0);
+        Magnitude partial;
+        for (size_t offset = 0; offset < na; offset += nb) {
+            size_t length = std::min(nb, na - offset);
+            multiplyMagnitude(a + offset, length, b, nb, partial);
+            addInPlace(out, partial, offset);
+        }
+        trim(out);
+        return;
+    }
+
+    const size_t m = nb / 2;
+    const std::uint32_t *a0 = a, *a1 = a + m;
+    const std::uint32_t *b0 = b, *b1 = b + m;
+    size_t na0 = m, nb0 = m;
+    while (na0 > 0 && a0[na0 - 1] == 0) --na0;
+    while (nb0 > 0 && b0[nb0 - 1] == 0) --nb0;
+
+    Magnitude z0, z1, z2, sumA, sumB;
+    multiplyMagnitude(a0, na0, b0, nb0, z0);
+    multiplyMagnitude(a1, na - m, b1, nb - m, z2);
+    addMagnitude(a0, na0, a1, na - m, sumA);
+    addMagnitude(b0, nb0, b1, nb - m, sumB);
+    multiplyMagnitude(sumA.data(), sumA.size(), sumB.data(), sumB.size(), z1);
+    subtractInPlace(z1, z0.data(), z0.size());
+    subtractInPlace(z1, z2.data(), z2.size());
+
+    out.assign(na + nb, 0);
+    addInPlace(out, z0, 0);
+    addInPlace(out, z1, m);
+    addInPlace(out, z2, 2 * m);
+    trim(out);
+}
+
+// a /= divisor，返回余数（单段除数快速路径）
+std::uint32_t divideBySmall(Magnitude &a, std::uint32_t divisor) {
+    std::uint64_t remainder = 0;
+    for (size_t i = a.size(); i-- > 0;) {
+        std::uint64_t current = (remainder << 32) | a[i];
+        a[i] = static_cast<std::uint32_t>(current / divisor);
+        remainder = current % divisor;
+    }
+    trim(a);
+    return static_cast<std::uint32_t>(remainder);
+}
+
+// a = a * factor + addend
+void multiplyAddSmall(Magnitude &a, std::uint32_t factor, std::uint32_t addend) {
+    std::uint64_t carry = addend;
+    for (size_t i = 0; i < a.size(); ++i) {
+        carry += static_cast<std::uint64_t>(a[i]) * factor;
+        a[i] = static_cast<std::uint32_t>(carry);
+        carry >>= 32;
+    }
+    if (carry != 0) {
+        a.push_back(static_cast<std::uint32_t>(carry));
+    }
+}
+
+inline int leadingZeros(std::uint32_t value) {
+    int count = 0;
+    while ((value & 0x80000000u) == 0) {
+        value <<= 1;
+        ++count;
+    }
+    return count;
+}
+
+/**
+ * @brief 多段除法（Knuth 算法 D）
+ * 要求除数至少两段；quotient 与 remainder 均为绝对值。
+ */
+void divideMagnitude(const Magnitude &dividend, const Magnitude &divisor,
+                     Magnitude &quotient, Magnitude &remainder) {
+    const size_t n = divisor.size();
+    const size_t m = dividend.size() - n;
+    const int shift = leadingZeros(divisor.back());
+
+    // 规格化：使除数最高段的最高位为 1
+    Magnitude v(n), u(dividend.size() + 1);
+    for (size_t i = n; i-- > 0;) {
+        v[i] = (divisor[i] << shift) |
+               (shift != 0 && i > 0 ? divisor[i - 1] >> (32 - shift) : 0);
+    }
+    u[dividend.size()] = shift != 0 ? dividend.back() >> (32 - shift) : 0;
+    for (size_t i = dividend.size(); i-- > 0;) {
+        u[i] = (dividend[i] << shift) |
+               (shift != 0 && i > 0 ? dividend[i - 1] >> (32 - shift) : 0);
+    }
+
+    quotient.assign(m + 1, 0);
+    const std::uint64_t base = 1ull << 32;
+    for (size_t j = m + 1; j-- > 0;) {
+        // 估算商的一段
+        std::uint64_t numerator = (static_cast<std::uint64_t>(u[j + n]) << 32) | u[j + n - 1];
+        std::uint64_t qhat = numerator / v[n - 1];
+        std::uint64_t rhat = numerator % v[n - 1];
+        while (qhat >= base ||
+               qhat * v[n - 2] > ((rhat << 32) | u[j + n - 2])) {
+            --qhat;
+            rhat += v[n - 1];
+            if (rhat >= base) {
+                break;
+            }
+        }
+
+        // 乘减
+        std::int64_t borrow = 0;
+        std::uint64_t carry = 0;
+        for (size_t i = 0; i < n; ++i) {
+            std::uint64_t product = qhat * v[i] + carry;
+            carry = product >> 32;
+            std::int64_t diff = static_cast<std::int64_t>(u[i + j]) - borrow -
+                                static_cast<std::int64_t>(product & 0xFFFFFFFFu);
+            borrow = diff < 0 ? 1 : 0;
+            u[i + j] = static_cast<std::uint32_t>(diff + (borrow << 32));
+        }
+        std::int64_t diff = static_cast<std::int64_t>(u[j + n]) - borrow -
+                            static_cast<std::int64_t>(carry);
+        u[j + n] = static_cast<std::uint32_t>(diff);
+
+        // 估值偏大一时加回
+        if (diff < 0) {
+            --qhat;
+            std::uint64_t sum = 0;
+            for (size_t i = 0; i < n; ++i) {
+                sum += static_cast<std::uint64_t>(u[i + j]) + v[i];
+                u[i + j] = static_cast<std::uint32_t>(sum);
+                sum >>= 32;
+            }
+            u[j + n] += static_cast<std::uint32_t>(sum);
+        }
+        quotient[j] = static_cast<std::uint32_t>(qhat);
+    }
+    trim(quotient);
+
+    // 反规格化余数
+    remainder.assign(n, 0);
+    for (size_t i = 0; i < n; ++i) {
+        remainder[i] = (u[i] >> shift) |
+                       (shift != 0 ? u[i + 1] << (32 - shift) : 0);
+    }
+    trim(remainder);
+}
+
+} // namespace
+
+BigInteger::BigInteger()
+    : m_small(0)
+    , m_negative(false)
+{
+}
+
+BigInteger::BigInteger(long long value)
+    : m_small(value)
+    , m_negative(false)
+{
+}
+
+BigInteger BigInteger::fromMagnitude(Magnitude &&magnitude, bool negative) {
+    trim(magnitude);
+    BigInteger result;
+    if (magnitude.size() <= 2) {
+        std::uint64_t value = magnitude.empty() ? 0 : magnitude[0];
+        if (magnitude.size() == 2) {
+            value |= static_cast<std::uint64_t>(magnitude[1]) << 32;
+        }
+        const std::uint64_t limit = static_cast<std::uint64_t>(std::numeric_limits<long long>::max());
+        if (value <= limit) {
+            result.m_small = negative ? -static_cast<long long>(value) : static_cast<long long>(value);
+            return result;
+        }
+        if (negative && value == limit + 1) {
+            result.m_small = std::numeric_limits<long long>::min();
+            return result;
+        }
+    }
+    result.m_limbs = std::move(magnitude);
+    result.m_negative = negative;
+    return result;
+}
+
+BigInteger::Magnitude BigInteger::magnitude() const {
+    if (!m_limbs.empty()) {
+        return m_limbs;
+    }
+    Magnitude result;
+    std::uint64_t value = absoluteValue(m_small);
+    while (value != 0) {
+        result.push_back(static_cast<std::uint32_t>(value));
+        value >>= 32;
+    }
+    return result;
+}
+
+bool BigInteger::fromString(const char *text, int length, BigInteger &out) {
+    int pos = 0;
+    bool negative = false;
+    if (pos < length && (text[pos] == '-' || text[pos] == '+')) {
+        negative = text[pos] == '-';
+        ++pos;
+    }
+    if (pos >= length) {
+        return false;
+    }
+
+    // 18 位以内直接在机器字中累加
+    long long small = 0;
+    int start = pos;
+    for (; pos < length && pos - start < 18; ++pos) {
+        if (text[pos] < '0' || text[pos] > '9') {
+            return false;
+        }
+        small = small * 10 + (text[pos] - '0');
+    }
+    if (pos == length) {
+        out = BigInteger(negative ? -small : small);
+        return true;
+    }
+
+    Magnitude magnitude;
+    for (std::uint64_t value = static_cast<std::uint64_t>(small); value != 0; value >>= 32) {
+        magnitude.push_back(static_cast<std::uint32_t>(value));
+    }
+    while (pos < length) {
+        std::uint32_t chunk = 0;
+        std::uint32_t factor = 1;
+        for (int i = 0; i < DECIMAL_CHUNK_DIGITS && pos < length; ++i, ++pos) {
+            if (text[pos] < '0' || text[pos] > '9') {
+                return false;
+            }
+            chunk = chunk * 10 + static_cast<std::uint32_t>(text[pos] - '0');
+            factor *= 10;
+        }
+        multiplyAddSmall(magnitude, factor, chunk);
+    }
+    out = fromMagnitude(std::move(magnitude), negative);
+    return true;
+}
+
+BigInteger BigInteger::powerOfTen(int exponent) {
+    if (exponent <= 18) {
+        long long value = 1;
+        for (int i = 0; i < exponent; ++i) {
+            value *= 10;
+        }
+        return BigInteger(value);
+    }
+    Magnitude magnitude(1, 1);
+    for (; exponent >= DECIMAL_CHUNK_DIGITS; exponent -= DECIMAL_CHUNK_DIGITS) {
+        multiplyAddSmall(magnitude, DECIMAL_CHUNK, 0);
+    }
+    std::uint32_t factor = 1;
+    for (int i = 0; i < exponent; ++i) {
+        factor *= 10;
+    }
+    multiplyAddSmall(magnitude, factor, 0);
+    return fromMagnitude(std::move(magnitude), false);
+}
+
+int BigInteger::bitLength() const {
+    if (m_limbs.empty()) {
+        std::uint64_t value = absoluteValue(m_small);
+        int bits = 0;
+        while (value != 0) {
+            value >>= 1;
+            ++bits;
+        }
+        return bits;
+    }
+    return static_cast<int>(m_limbs.size()) * 32 - leadingZeros(m_limbs.back());
+}
+
+double BigInteger::toDouble() const {
+    if (m_limbs.empty()) {
+        return static_cast<double>(m_small);
+    }
+    // 取最高的 64 位再按位数缩放（截断误差低于双精度的有效位）
+    const int bits = bitLength();
+    const int shift = bits - 64;
+    std::uint64_t top = 0;
+    for (int bit = 63; bit >= 0; --bit) {
+        int index = bit + shift;
+        std::uint32_t limb = m_limbs[static_cast<size_t>(index / 32)];
+        top = (top << 1) | ((limb >> (index % 32)) & 1u);
+    }
+    double value = std::ldexp(static_cast<double>(top), shift);
+    return m_negative ? -value : value;
+}
+
+std::string BigInteger::toString() const {
+    if (m_limbs.empty()) {
+        std::uint64_t value = absoluteValue(m_small);
+        char buffer[24];
+        int pos = sizeof(buffer);
+        do {
+            buffer[--pos] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value != 0);
+        if (m_small < 0) {
+            buffer[--pos] = '-';
+        }
+        return std::string(buffer + pos, sizeof(buffer) - pos);
+    }
+
+    // 反复除以 10^9 得到十进制分段
+    Magnitude work = m_limbs;
+    std::vector<std::uint32_t> chunks;
+    while (!work.empty()) {
+        chunks.push_back(divideBySmall(work, DECIMAL_CHUNK));
+    }
+
+    std::string text;
+    text.reserve(chunks.size() * DECIMAL_CHUNK_DIGITS + 1);
+    if (m_negative) {
+        text += '-';
+    }
+    text += std::to_string(chunks.back());
+    for (size_t i = chunks.size() - 1; i-- > 0;) {
+        char digits[DECIMAL_CHUNK_DIGITS];
+        std::uint32_t chunk = chunks[i];
+        for (int d = DECIMAL_CHUNK_DIGITS; d-- > 0;) {
+            digits[d] = static_cast<char>('0' + chunk % 10);
+            chunk /= 10;
+        }
+        text.append(digits, DECIMAL_CHUNK_DIGITS);
+    }
+    return text;
+}
+
+BigInteger BigInteger::operator-() const {
+    if (m_limbs.empty() && m_small != std::numeric_limits<long long>::min()) {
+        return BigInteger(-m_small);
+    }
+    return fromMagnitude(magnitude(), !isNegative());
+}
+
+BigInteger BigInteger::abs() const {
+    return isNegative() ? -*this : *this;
+}
+
+BigInteger BigInteger::shiftedLeft(int bits) const {
+    if (isZero() || bits <= 0) {
+        return *this;
+    }
+    if (m_limbs.empty() && bits < 62) {
+        long long limit = std::numeric_limits<long long>::max() >> bits;
+        if (m_small <= limit && m_small >= -limit) {
+            return BigInteger(static_cast<long long>(static_cast<unsigned long long>(m_small) << bits));
+        }
+    }
+    Magnitude source = magnitude();
+    const size_t limbShift = static_cast<size_t>(bits / 32);
+    const int bitShift = bits % 32;
+    Magnitude result(source.size() + limbShift + 1, 0);
+    for (size_t i = 0; i < source.size(); ++i) {
+        std::uint64_t value = static_cast<std::uint64_t>(source[i]) << bitShift;
+        result[i + limbShift] |= static_cast<std::uint32_t>(value);
+        result[i + limbShift + 1] |= static_cast<std::uint32_t>(value >> 32);
+    }
+    return fromMagnitude(std::move(result), isNegative());
+}
+
+BigInteger operator+(const BigInteger &a, const BigInteger &b) {
+    long long sum;
+    if (a.m_limbs.empty() && b.m_limbs.empty() && !addOverflows(a.m_small, b.m_small, sum)) {
+        return BigInteger(sum);
+    }
+
+    BigInteger::Magnitude ma = a.magnitude();
+    BigInteger::Magnitude mb = b.magnitude();
+    const bool negativeA = a.isNegative();
+    const bool negativeB = b.isNegative();
+    if (negativeA == negativeB) {
+        BigInteger::Magnitude result;
+        addMagnitude(ma.data(), ma.size(), mb.data(), mb.size(), result);
+        return BigInteger::fromMagnitude(std::move(result), negativeA);
+    }
+
+    // 异号：大绝对值减小绝对值，符号随大者
+    int cmp = compareMagnitude(ma, mb);
+    if (cmp == 0) {
+        return BigInteger();
+    }
+    if (cmp > 0) {
+        subtractInPlace(ma, mb.data(), mb.size());
+        return BigInteger::fromMagnitude(std::move(ma), negativeA);
+    }
+    subtractInPlace(mb, ma.data(), ma.size());
+    return BigInteger::fromMagnitude(std::move(mb), negativeB);
+}
+
+BigInteger operator-(const BigInteger &a, const BigInteger &b) {
+    long long difference;
+    if (a.m_limbs.empty() && b.m_limbs.empty() && !subOverflows(a.m_small, b.m_small, difference)) {
+        return BigInteger(difference);
+    }
+    return a + (-b);
+}
+
+BigInteger operator*(const BigInteger &a, const BigInteger &b) {
+    long long product;
+    if (a.m_limbs.empty() && b.m_limbs.empty() && !mulOverflows(a.m_small, b.m_small, product)) {
+        return BigInteger(product);
+    }
+    if (a.isZero() || b.isZero()) {
+        return BigInteger();
+    }
+
+    BigInteger::Magnitude ma = a.magnitude();
+    BigInteger::Magnitude mb = b.magnitude();
+    BigInteger::Magnitude result;
+    multiplyMagnitude(ma.data(), ma.size(), mb.data(), mb.size(), result);
+    return BigInteger::fromMagnitude(std::move(result), a.isNegative() != b.isNegative());
+}
+
+void BigInteger::divide(const BigInteger &dividend, const BigInteger &divisor,
+                        BigInteger &quotient, BigInteger &remainder) {
+    if (dividend.m_limbs.empty() && divisor.m_limbs.empty() &&
+        !(dividend.m_small == std::numeric_limits<long long>::min() && divisor.m_small == -1)) {
+        long long q = dividend.m_small / divisor.m_small;
+        long long r = dividend.m_small % divisor.m_small;
+        quotient = BigInteger(q);
+        remainder = BigInteger(r);
+        return;
+    }
+
+    Magnitude ma = dividend.magnitude();
+    Magnitude mb = divisor.magnitude();
+    const bool negativeQuotient = dividend.isNegative() != divisor.isNegative();
+    const bool negativeRemainder = dividend.isNegative();
+
+    if (compareMagnitude(ma, mb) < 0) {
+        remainder = dividend;
+        quotient = BigInteger();
+        return;
+    }
+
+    Magnitude q, r;
+    if (mb.size() == 1) {
+        q = ma;
+        std::uint32_t rest = divideBySmall(q, mb[0]);
+        if (rest != 0) {
+            r.push_back(rest);
+        }
+    } else {
+        divideMagnitude(ma, mb, q, r);
+    }
+    quotient = fromMagnitude(std::move(q), negativeQuotient);
+    remainder = fromMagnitude(std::move(r), negativeRemainder);
+}
+
+BigInteger BigInteger::gcd(const BigInteger &a, const BigInteger &b) {
+    BigInteger x = a.abs();
+    BigInteger y = b.abs();
+    BigInteger quotient, remainder;
+    while (!y.isZero()) {
+        if (x.m_limbs.empty() && y.m_limbs.empty()) {
+            // 两者都回到机器字后改用无符号欧几里得算法
+            std::uint64_t u = absoluteValue(x.m_small);
+            std::uint64_t v = absoluteValue(y.m_small);
+            while (v != 0) {
+                std::uint64_t t = u % v;
+                u = v;
+                v = t;
+            }
+            if (u > static_cast<std::uint64_t>(std::numeric_limits<long long>::max())) {
+                Magnitude m;
+                m.push_back(static_cast<std::uint32_t>(u));
+                m.push_back(static_cast<std::uint32_t>(u >> 32));
+                return fromMagnitude(std::move(m), false);
+            }
+            return BigInteger(static_cast<long long>(u));
+        }
+        divide(x, y, quotient, remainder);
+        x = std::move(y);
+        y = remainder.abs();
+    }
+    return x;
+}
+
+int BigInteger::compare(const BigInteger &a, const BigInteger &b) {
+    if (a.m_limbs.empty() && b.m_limbs.empty()) {
+        return a.m_small < b.m_small ? -1 : (a.m_small > b.m_small ? 1 : 0);
+    }
+    const bool negativeA = a.isNegative();
+    const bool negativeB = b.isNegative();
+    if (negativeA != negativeB) {
+        return negativeA ? -1 : 1;
+    }
+    int cmp = compareMagnitude(a.magnitude(), b.magnitude());
+    return negativeA ? -cmp : cmp;
+}
+
+} // namespace Calculator
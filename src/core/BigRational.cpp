@@ -0,0 +1,259 @@
+/**
+ * @file BigRational.cpp
+ * @brief 任意精度有理数实现
+ */
+
+#include "../../inc/core/BigRational.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Calculator {
+
+namespace {
+
+const int MAX_DECIMAL_EXPONENT = 100000;   // 解析时允许的最大十进制指数
+
+// 四舍五入的非负整数除法
+BigInteger roundedDivide(const BigInteger &dividend, const BigInteger &divisor) {
+    BigInteger quotient, remainder;
+    BigInteger::divide(dividend + dividend + divisor, divisor + divisor, quotient, remainder);
+    return quotient;
+}
+
+// 在倒数第 fractionDigits 位前插入小数点并移除末尾零
+std::string insertDecimalPoint(std::string digits, int fractionDigits) {
+    if (fractionDigits <= 0) {
+        return digits;
+    }
+    if (static_cast<int>(digits.size()) <= fractionDigits) {
+        digits.insert(0, static_cast<size_t>(fractionDigits + 1) - digits.size(), '0');
+    }
+    digits.insert(digits.size() - static_cast<size_t>(fractionDigits), 1, '.');
+    while (digits.back() == '0') {
+        digits.pop_back();
+    }
+    if (digits.back() == '.') {
+        digits.pop_back();
+    }
+    return digits;
+}
+
+} // namespace
+
+BigRational::BigRational()
+    : m_numerator(0)
+    , m_denominator(1)
+{
+}
+
+BigRational::BigRational(const BigInteger &integer)
+    : m_numerator(integer)
+    , m_denominator(1)
+{
+}
+
+BigRational::BigRational(const BigInteger &numerator, const BigInteger &denominator)
+    : m_numerator(numerator)
+    , m_denominator(denominator)
+{
+    normalize();
+}
+
+void BigRational::normalize() {
+    if (m_numerator.isZero()) {
+        m_denominator = BigInteger(1);
+        return;
+    }
+    if (m_denominator.isNegative()) {
+        m_numerator = -m_numerator;
+        m_denominator = -m_denominator;
+    }
+    if (m_denominator == BigInteger(1)) {
+        return;
+    }
+    BigInteger divisor = BigInteger::gcd(m_numerator, m_denominator);
+    if (divisor != BigInteger(1)) {
+        BigInteger remainder;
+        BigInteger::divide(m_numerator, divisor, m_numerator, remainder);
+        BigInteger::divide(m_denominator, divisor, m_denominator, remainder);
+    }
+}
+
+bool BigRational::fromDecimal(const char *text, int length, BigRational &out) {
+    int pos = 0;
+    bool negative = false;
+    if (pos < length && (text[pos] == '-' || text[pos] == '+')) {
+        negative = text[pos] == '-';
+        ++pos;
+    }
+
+    // 收集整数与小数部分的数字（跳过前导零）
+    std::string digits;
+    int fractionDigits = 0;
+    bool seenDigit = false;
+    for (; pos < length && text[pos] >= '0' && text[pos] <= '9'; ++pos) {
+        seenDigit = true;
+        if (!digits.empty() || text[pos] != '0') {
+            digits += text[pos];
+        }
+    }
+    if (pos < length && text[pos] == '.') {
+        for (++pos; pos < length && text[pos] >= '0' && text[pos] <= '9'; ++pos) {
+            seenDigit = true;
+            ++fractionDigits;
+            if (!digits.empty() || text[pos] != '0') {
+                digits += text[pos];
+            }
+        }
+    }
+    if (!seenDigit) {
+        return false;
+    }
+
+    int exponent = 0;
+    if (pos < length && (text[pos] == 'e' || text[pos] == 'E')) {
+        ++pos;
+        bool negativeExponent = false;
+        if (pos < length && (text[pos] == '-' || text[pos] == '+')) {
+            negativeExponent = text[pos] == '-';
+            ++pos;
+        }
+        if (pos >= length) {
+            return false;
+        }
+        for (; pos < length && text[pos] >= '0' && text[pos] <= '9'; ++pos) {
+            exponent = exponent * 10 + (text[pos] - '0');
+            if (exponent > MAX_DECIMAL_EXPONENT) {
+                return false;
+            }
+        }
+        if (negativeExponent) {
+            exponent = -exponent;
+        }
+    }
+    if (pos != length) {
+        return false;
+    }
+
+    if (digits.empty()) {
+        out = BigRational();
+        return true;
+    }
+
+    BigInteger mantissa;
+    BigInteger::fromString(digits.data(), static_cast<int>(digits.size()), mantissa);
+    if (negative) {
+        mantissa = -mantissa;
+    }
+
+    int scale = fractionDigits - exponent;
+    if (scale > 0) {
+        out = BigRational(mantissa, BigInteger::powerOfTen(scale));
+    } else {
+        out = BigRational(mantissa * BigInteger::powerOfTen(-scale));
+    }
+    return true;
+}
+
+double BigRational::toDouble() const {
+    const long long exactLimit = 1LL << 53;
+    if (m_numerator.isSmall() && m_denominator.isSmall() &&
+        m_numerator.smallValue() <= exactLimit && m_numerator.smallValue() >= -exactLimit &&
+        m_denominator.smallValue() <= exactLimit) {
+        // 分子分母都能精确表示为双精度，一次除法即可
+        return static_cast<double>(m_numerator.smallValue()) /
+               static_cast<double>(m_denominator.smallValue());
+    }
+
+    // 先缩放使商约有 64 位有效位，再按 2 的幂还原
+    BigInteger magnitude = m_numerator.abs();
+    int shift = m_denominator.bitLength() - magnitude.bitLength() + 64;
+    BigInteger quotient, remainder;
+    if (shift >= 0) {
+        BigInteger::divide(magnitude.shiftedLeft(shift), m_denominator, quotient, remainder);
+    } else {
+        BigInteger::divide(magnitude, m_denominator.shiftedLeft(-shift), quotient, remainder);
+    }
+    double value = std::ldexp(quotient.toDouble(), -shift);
+    return m_numerator.isNegative() ? -value : value;
+}
+
+std::string BigRational::toDecimalString(int significantDigits) const {
+    if (isInteger()) {
+        return m_numerator.toString();
+    }
+
+    const std::string sign = m_numerator.isNegative() ? "-" : "";
+    const BigInteger magnitude = m_numerator.abs();
+    BigInteger integerPart, remainder;
+    BigInteger::divide(magnitude, m_denominator, integerPart, remainder);
+
+    // 绝对值不小于 1：整数部分完整保留，剩余位数给小数部分
+    if (!integerPart.isZero()) {
+        int integerDigits = static_cast<int>(integerPart.toString().size());
+        int fractionDigits = std::max(0, significantDigits - integerDigits);
+        BigInteger scaled = roundedDivide(magnitude * BigInteger::powerOfTen(fractionDigits), m_denominator);
+        return sign + insertDecimalPoint(scaled.toString(), fractionDigits);
+    }
+
+    // 绝对值小于 1：统计小数点后的前导零个数
+    int leadingZeros = 0;
+    BigInteger probe = remainder * BigInteger(10);
+    while (probe < m_denominator) {
+        probe = probe * BigInteger(10);
+        ++leadingZeros;
+    }
+
+    if (leadingZeros < 4) {
+        int fractionDigits = leadingZeros + significantDigits;
+        BigInteger scaled = roundedDivide(magnitude * BigInteger::powerOfTen(fractionDigits), m_denominator);
+        return sign + insertDecimalPoint(scaled.toString(), fractionDigits);
+    }
+
+    // 科学计数法：d.ddd…e-XX
+    int exponent = -(leadingZeros + 1);
+    BigInteger scaled = roundedDivide(
+        magnitude * BigInteger::powerOfTen(leadingZeros + significantDigits), m_denominator);
+    std::string digits = scaled.toString();
+    if (static_cast<int>(digits.size()) > significantDigits) {
+        // 进位到下一个数量级（如 9.99…95 → 10）
+        digits.resize(static_cast<size_t>(significantDigits));
+        ++exponent;
+    }
+    std::string mantissa = insertDecimalPoint(digits, significantDigits - 1);
+
+    std::string exponentText = std::to_string(-exponent);
+    if (exponentText.size() < 2) {
+        exponentText.insert(0, 1, '0');
+    }
+    return sign + mantissa + "e-" + exponentText;
+}
+
+BigRational BigRational::operator-() const {
+    BigRational result;
+    result.m_numerator = -m_numerator;
+    result.m_denominator = m_denominator;
+    return result;
+}
+
+BigRational operator+(const BigRational &a, const BigRational &b) {
+    if (a.m_denominator == b.m_denominator) {
+        return BigRational(a.m_numerator + b.m_numerator, a.m_denominator);
+    }
+    return BigRational(a.m_numerator * b.m_denominator + b.m_numerator * a.m_denominator,
+                       a.m_denominator * b.m_denominator);
+}
+
+BigRational operator-(const BigRational &a, const BigRational &b) {
+    return a + (-b);
+}
+
+BigRational operator*(const BigRational &a, const BigRational &b) {
+    return BigRational(a.m_numerator * b.m_numerator, a.m_denominator * b.m_denominator);
+}
+
+BigRational operator/(const BigRational &a, const BigRational &b) {
+    return BigRational(a.m_numerator * b.m_denominator, a.m_denominator * b.m_numerator);
+}
+
+} // namespace Calculator
@@ -4,236 +4,324 @@
  */
 
 #include "../../inc/core/CalculatorEngine.h"
+#include "../../inc/core/Arithmetic.h"
+#include "../../inc/core/HistoryLog.h"
+#include "../../inc/core/ResultCache.h"
 #include "../../inc/utils/Constants.h"
-#include <cmath>
-#include <limits>
+#include "../../inc/utils/Metrics.h"
+#include "../../inc/utils/NumberFormatter.h"
+#include "../../inc/utils/TraceRecorder.h"
+#include <QMetaMethod>
 
 namespace Calculator {
 
 CalculatorEngine::CalculatorEngine(QObject *parent)
     : QObject(parent)
-    , m_hasDecimal(false)
+    , m_backendOperandSynced(false)
+    , m_history(nullptr)
+    , m_resultCache(nullptr)
 {
     reset();
 }
 
+CalculatorState CalculatorEngine::getState() const {
+    return m_core.currentState();
+}
+
+void CalculatorEngine::setNumericBackend(NumericBackendType type) {
+    setNumericBackend(createNumericBackend(type));
+}
+
+void CalculatorEngine::setNumericBackend(std::unique_ptr<NumericBackend> backend) {
+    m_backend = std::move(backend);
+    reset();
+    notifyDisplayChanged();
+}
+
+NumericBackendType CalculatorEngine::numericBackendType() const {
+    return m_backend ? m_backend->type() : NumericBackendType::Double;
+}
+
 QString CalculatorEngine::getDisplayText() const {
-    if (m_state.error != ErrorType::NoError) {
-        switch (m_state.error) {
-        case ErrorType::DivisionByZero:
-            return tr("错误: 除零");
-        case ErrorType::Overflow:
-            return tr("错误: 溢出");
-        case ErrorType::InvalidInput:
-            return tr("错误: 无效输入");
-        case ErrorType::SyntaxError:
-            return tr("错误: 语法错误");
-        default:
-            return tr("错误");
+    const CalculatorState &state = m_core.state;
+    if (state.error != ErrorType::NoError) {
+        return errorText(state.error);
+    }
+    
+    if (state.waitingForOperand) {
+        if (m_backend) {
+            return QString::fromStdString(m_backend->formatStored());
         }
+        return formatNumber(state.storedValue);
     }
     
-    if (m_state.waitingForOperand) {
-        return formatNumber(m_state.storedValue);
+    // 运算结果在显示时才格式化；后端结果使用后端自己的精确文本
+    if (!m_core.inputTextValid) {
+        if (m_backend && m_backendOperandSynced) {
+            return QString::fromStdString(m_backend->formatOperand());
+        }
+        return formatNumber(m_core.inputValue);
     }
     
-    return m_currentInput.isEmpty() ? "0" : m_currentInput;
+    // 只在显示时才把输入缓冲转换为 QString
+    return m_core.inputLength == 0 ? QString("0") : QString::fromLatin1(m_core.input, m_core.inputLength);
 }
 
 void CalculatorEngine::inputDigit(int digit) {
-    if (m_state.error != ErrorType::NoError) {
-        reset();
-    }
-    
-    if (m_state.waitingForOperand) {
-        m_currentInput = QString::number(digit);
-        m_state.waitingForOperand = false;
-        m_hasDecimal = false;
-    } else {
-        if (m_currentInput == "0") {
-            m_currentInput = QString::number(digit);
-        } else {
-            m_currentInput += QString::number(digit);
-        }
-    }
-    
-    m_state.currentValue = m_currentInput.toDouble();
-    emit displayChanged(getDisplayText());
+    CALCULATOR_TRACE_SCOPE("engine", "CalculatorEngine::inputDigit");
+    CALCULATOR_METRIC_SCOPE(MetricOperation::InputDigit);
+    prepareBackendEdit();
+    const unsigned effects = m_core.inputDigit(digit);
+    m_backendOperandSynced = false;
+    applyEffects(effects);
 }
 
 void CalculatorEngine::inputOperator(Operator op) {
-    if (m_state.error != ErrorType::NoError) {
+    CALCULATOR_TRACE_SCOPE("engine", "CalculatorEngine::inputOperator");
+    CALCULATOR_METRIC_SCOPE(MetricOperation::InputOperator);
+    // 后端先解析正在输入的操作数，文本无效时状态保持不变
+    if (m_backend && !m_core.hasError() && !syncBackendOperand()) {
+        setError(ErrorType::InvalidInput);
         return;
     }
     
-    if (!m_state.waitingForOperand) {
-        calculate();
-    }
+    const unsigned effects = m_core.inputOperator(op, Arithmetic{this});
     
-    if (m_state.error == ErrorType::NoError) {
-        m_state.pendingOperator = op;
-        m_state.storedValue = m_state.currentValue;
-        m_state.waitingForOperand = true;
-        m_hasDecimal = false;
-        emit stateUpdated(m_state);
+    // 后端保存左操作数（刚完成运算时后端的操作数已是结果）
+    if (m_backend && (effects & EngineCore::StateChanged)) {
+        m_backend->storeOperand();
     }
+    applyEffects(effects);
 }
 
 void CalculatorEngine::inputEquals(){
-    if (m_state.error != ErrorType::NoError || 
-        m_state.pendingOperator == Operator::None) {
-        return;
-    }
-    
-    if (!m_state.waitingForOperand) {
-        calculate();
-    }
-    
-    if (m_state.error == ErrorType::NoError) {
-        m_state.pendingOperator = Operator::None;
-        m_state.waitingForOperand = false;
-        emit stateUpdated(m_state);
-    }
+    CALCULATOR_TRACE_SCOPE("engine", "CalculatorEngine::inputEquals");
+    applyEffects(m_core.inputEquals(Arithmetic{this}));
 }
 
 void CalculatorEngine::inputDecimal() {
-    if (m_state.error != ErrorType::NoError) {
-        reset();
-    }
-    
-    if (m_state.waitingForOperand) {
-        m_currentInput = "0";
-        m_state.waitingForOperand = false;
-        m_hasDecimal = false;
-    }
-    
-    if (!m_hasDecimal) {
-        m_currentInput += ".";
-        m_hasDecimal = true;
-        emit displayChanged(getDisplayText());
+    CALCULATOR_TRACE_SCOPE("engine", "CalculatorEngine::inputDecimal");
+    prepareBackendEdit();
+    const unsigned effects = m_core.inputDecimal();
+    if (effects & EngineCore::DisplayChanged) {
+        m_backendOperandSynced = false;
     }
+    applyEffects(effects);
 }
 
 void CalculatorEngine::clearEntry() {
-    m_currentInput.clear();
-    m_state.currentValue = 0.0;
-    m_hasDecimal = false;
-    m_state.waitingForOperand = true;
-    emit displayChanged(getDisplayText());
+    CALCULATOR_TRACE_SCOPE("engine", "CalculatorEngine::clearEntry");
+    const unsigned effects = m_core.clearEntry();
+    m_backendOperandSynced = false;
+    applyEffects(effects);
 }
 
 void CalculatorEngine::clearAll() {
-    reset();
-    emit stateUpdated(m_state);
-    emit displayChanged(getDisplayText());
+    CALCULATOR_TRACE_SCOPE("engine", "CalculatorEngine::clearAll");
+    applyEffects(m_core.clearAll());
 }
 
 void CalculatorEngine::backspace() {
-    if (m_state.waitingForOperand || m_state.error != ErrorType::NoError) {
-        return;
+    CALCULATOR_TRACE_SCOPE("engine", "CalculatorEngine::backspace");
+    prepareBackendEdit();
+    const unsigned effects = m_core.backspace();
+    if (effects & EngineCore::DisplayChanged) {
+        m_backendOperandSynced = false;
     }
-    
-    // 删除最后一个字符
-    if (m_currentInput.length() > 1) {
-        if (m_currentInput.endsWith('.')) {
-            m_hasDecimal = false;
-        }
-        m_currentInput.chop(1);
-        m_state.currentValue = m_currentInput.toDouble();
-    } else {
-        m_currentInput.clear();
-        m_state.currentValue = 0.0;
-        m_state.waitingForOperand = true;
-    }
-    
-    emit displayChanged(getDisplayText());
+    applyEffects(effects);
 }
 
 void CalculatorEngine::changeSign() {
-    if (m_state.error != ErrorType::NoError) {
+    CALCULATOR_TRACE_SCOPE("engine", "CalculatorEngine::changeSign");
+    if (!m_backend) {
+        applyEffects(m_core.changeSign());
+        return;
+    }
+    
+    CalculatorState &state = m_core.state;
+    if (state.error != ErrorType::NoError) {
         return;
     }
     
-    if (m_state.waitingForOperand) {
-        m_state.storedValue = -m_state.storedValue;
-        m_state.currentValue = m_state.storedValue;
+    if (state.waitingForOperand) {
+        // 后端的操作数将被存储值覆盖，先保留结果的文本
+        prepareBackendEdit();
+        m_backend->negateStored();
+        m_backend->loadStored();
+        state.storedValue = m_backend->storedValue();
+        state.currentValue = state.storedValue;
     } else {
-        m_state.currentValue = -m_state.currentValue;
-        m_currentInput = formatNumber(m_state.currentValue);
-    }
-    
-    emit displayChanged(getDisplayText());
-}
-
-void CalculatorEngine::calculate() {
-    double result = m_state.storedValue;
-    double operand = m_state.currentValue;
-    
-    switch (m_state.pendingOperator) {
-    case Operator::Add:
-        result += operand;
-        break;
-    case Operator::Subtract:
-        result -= operand;
-        break;
-    case Operator::Multiply:
-        result *= operand;
-        break;
-    case Operator::Divide:
-        if (std::abs(operand) < std::numeric_limits<double>::epsilon()) {
-            setError(ErrorType::DivisionByZero);
+        if (!syncBackendOperand()) {
+            setError(ErrorType::InvalidInput);
             return;
         }
-        result /= operand;
-        break;
-    default:
+        m_backend->negateOperand();
+        state.currentValue = m_backend->operandValue();
+        m_core.assignResult(state.currentValue);
+    }
+    m_backendOperandSynced = true;
+    notifyDisplayChanged();
+}
+
+void CalculatorEngine::evaluateExpression(const QString &expression) {
+    reset();
+    
+    QByteArray utf8 = expression.toUtf8();
+    if (!m_parser.parse(utf8.constData(), utf8.size(), m_expression)) {
+        setError(m_parser.error());
+        return;
+    }
+    
+    // 含未赋值变量的表达式无法在引擎中求值
+    if (m_expression.variableCount() > 0) {
+        setError(ErrorType::InvalidInput);
         return;
     }
     
-    if (checkOverflow(result)) {
-        setError(ErrorType::Overflow);
+    ErrorType error = ErrorType::NoError;
+    double result = m_expression.evaluate(nullptr, error, m_resultCache);
+    if (error != ErrorType::NoError) {
+        setError(error);
         return;
     }
     
-    // 思考：如果storedValue = result会发生什么情况？
-    m_state.currentValue = result;
-    m_state.storedValue = 0.0;
-    m_currentInput = formatNumber(result);
-    m_state.waitingForOperand = true;
+    applyEffects(m_core.loadResult(result));
+}
+
+double CalculatorEngine::applyArithmetic(Operator op, double lhs, double rhs, ErrorType &error) {
+    CALCULATOR_TRACE_SCOPE("engine", "CalculatorEngine::calculate");
+    CALCULATOR_METRIC_SCOPE(MetricOperation::Calculate);
+    if (m_backend) {
+        return applyBackend(op, error);
+    }
+    
+    double result = m_resultCache
+        ? m_resultCache->apply(op, lhs, rhs, error)
+        : applyOperator(op, lhs, rhs, error);
+    if (m_history) {
+        m_history->append(lhs, op, rhs, error == ErrorType::NoError ? result : 0.0, error);
+        emit historyAppended();
+    }
+    return result;
+}
+
+double CalculatorEngine::applyBackend(Operator op, ErrorType &error) {
+    if (!syncBackendOperand()) {
+        error = ErrorType::InvalidInput;
+        return 0.0;
+    }
+    
+    // 后端按自己的数值类型计算，不做 MAX_CALCULATION_VALUE 限制
+    const double left = m_history ? m_backend->storedValue() : 0.0;
+    const double right = m_history ? m_backend->operandValue() : 0.0;
+    const ErrorType backendError = m_backend->apply(op);
+    if (m_history) {
+        m_history->append(left, op, right,
+                          backendError == ErrorType::NoError ? m_backend->operandValue() : 0.0, backendError);
+        emit historyAppended();
+    }
+    if (backendError != ErrorType::NoError) {
+        error = backendError;
+        return 0.0;
+    }
+    
+    // 引擎只保存双精度近似值，显示时使用后端的文本
+    m_backendOperandSynced = true;
+    return m_backend->operandValue();
+}
+
+bool CalculatorEngine::syncBackendOperand() {
+    if (m_backendOperandSynced) {
+        return true;
+    }
+    
+    // 结果文本可能被舍入，因此只在用户修改输入后才重新解析
+    m_core.ensureInputText();
+    if (!m_backend->setOperand(m_core.input, m_core.inputLength)) {
+        return false;
+    }
+    m_backendOperandSynced = true;
+    return true;
+}
+
+void CalculatorEngine::prepareBackendEdit() {
+    // 继续编辑后端结果时以后端的精确文本为准；超出输入缓冲的文本退回双精度近似值
+    if (m_backend && m_backendOperandSynced && !m_core.inputTextValid && !m_core.hasError()) {
+        const std::string text = m_backend->formatOperand();
+        m_core.assignText(text.data(), static_cast<int>(text.size()), m_backend->operandValue());
+    }
 }
 
 void CalculatorEngine::reset() {
-    m_state = CalculatorState();
-    m_currentInput.clear();
-    m_hasDecimal = false;
-    emit stateUpdated(m_state);
+    m_core.reset();
+    m_backendOperandSynced = false;
+    if (m_backend) {
+        m_backend->reset();
+    }
+    emit stateUpdated(m_core.state);
 }
 
 void CalculatorEngine::setError(ErrorType error) {
-    m_state.error = error;
-    emit errorOccurred(error);
-    emit displayChanged(getDisplayText());
+    m_core.state.error = error;
+    applyEffects(EngineCore::ErrorRaised);
 }
 
-QString CalculatorEngine::formatNumber(double value) const {
-    QString text = QString::number(value, 'g', Constants::MAX_DISPLAY_LENGTH);
-    
-    // 移除不必要的尾随零和小数点
-    if (text.contains('.')) {
-        while (text.endsWith('0')) {
-            text.chop(1);
-        }
-        if (text.endsWith('.')) {
-            text.chop(1);
+void CalculatorEngine::applyEffects(unsigned effects) {
+    if (effects & EngineCore::Reset) {
+        m_backendOperandSynced = false;
+        if (m_backend) {
+            m_backend->reset();
         }
     }
+    if (effects & EngineCore::StateChanged) {
+        emit stateUpdated(m_core.state);
+    }
+    if (effects & EngineCore::ErrorRaised) {
+        CALCULATOR_METRIC_ERROR(m_core.state.error);
+        emit errorOccurred(m_core.state.error);
+    }
+    if (effects & (EngineCore::DisplayChanged | EngineCore::ErrorRaised)) {
+        notifyDisplayChanged();
+    }
+}
+
+void CalculatorEngine::notifyDisplayChanged() {
+    CALCULATOR_TRACE_SCOPE("engine", "CalculatorEngine::notifyDisplayChanged");
+    // 信号被屏蔽（如无界面批处理）时跳过显示文本的格式化
+    if (signalsBlocked()) {
+        return;
+    }
+    emit displayInvalidated();
     
-    return text;
+    // 界面通过 displayInvalidated 合并刷新时，不必为每次按键格式化文本
+    static const QMetaMethod displayChangedSignal =
+        QMetaMethod::fromSignal(&CalculatorEngine::displayChanged);
+    if (isSignalConnected(displayChangedSignal)) {
+        emit displayChanged(getDisplayText());
+    }
+}
+
+QString CalculatorEngine::errorText(ErrorType error) {
+    switch (error) {
+    case ErrorType::DivisionByZero:
+        return tr("错误: 除零");
+    case ErrorType::Overflow:
+        return tr("错误: 溢出");
+    case ErrorType::InvalidInput:
+        return tr("错误: 无效输入");
+    case ErrorType::SyntaxError:
+        return tr("错误: 语法错误");
+    default:
+        return tr("错误");
+    }
 }
 
-bool CalculatorEngine::checkOverflow(double value) const{
-    return std::isinf(value) || std::isnan(value) ||
-           std::abs(value) > Constants::MAX_CALCULATION_VALUE;
+QString CalculatorEngine::formatNumber(double value) {
+    CALCULATOR_METRIC_SCOPE(MetricOperation::FormatNumber);
+    // 格式化到栈缓冲（已去除尾随零），只在构造 QString 时分配一次
+    char text[NumberFormatter::BUFFER_SIZE];
+    int length = NumberFormatter::format(value, text, Constants::MAX_DISPLAY_LENGTH);
+    return QString::fromLatin1(text, length);
 }
 
 } // namespace Calculator
\ No newline at end of file
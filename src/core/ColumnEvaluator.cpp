@@ -0,0 +1,335 @@
+/**
+ * @file ColumnEvaluator.cpp
+ * @brief 公式的按列向量化求值实现
+ */
+
+#include "../../inc/core/ColumnEvaluator.h"
+#include "../../inc/core/Arithmetic.h"
+#include "../../inc/core/ExpressionParser.h"
+#include "../../inc/utils/Constants.h"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define CALCULATOR_X86_KERNELS 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define CALCULATOR_TARGET(isa)
+#else
+#define CALCULATOR_TARGET(isa) __attribute__((target(isa)))
+#endif
+#endif
+
+namespace Calculator {
+
+namespace {
+
+const std::uint8_t OPCODE_ADD = static_cast<std::uint8_t>(Operator::Add);
+const std::uint8_t OPCODE_SUBTRACT = static_cast<std::uint8_t>(Operator::Subtract);
+const std::uint8_t OPCODE_MULTIPLY = static_cast<std::uint8_t>(Operator::Multiply);
+const std::uint8_t OPCODE_DIVIDE = static_cast<std::uint8_t>(Operator::Divide);
+
+/**
+ * @brief 列内核：对 count 个元素执行一条指令
+ * 出错的元素只在其错误列仍为 NoError 时登记，保证记录的是该行第一个错误。
+ */
+typedef void (*ColumnKernel)(std::uint8_t op, const double *lhs, const double *rhs,
+                             double *dst, ErrorType *errors, std::size_t count);
+
+inline void markError(ErrorType &slot, ErrorType error) {
+    if (slot == ErrorType::NoError) {
+        slot = error;
+    }
+}
+
+// 按掩码位登记错误（错误很少见，逐位处理即可）
+inline void markErrors(int mask, int lanes, ErrorType error, ErrorType *errors) {
+    for (int lane = 0; lane < lanes; ++lane) {
+        if (mask & (1 << lane)) {
+            markError(errors[lane], error);
+        }
+    }
+}
+
+void scalarKernel(std::uint8_t op, const double *lhs, const double *rhs,
+                  double *dst, ErrorType *errors, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        const double a = lhs[i];
+        const double b = rhs[i];
+        double r;
+        switch (op) {
+        case OPCODE_ADD:
+            r = a + b;
+            break;
+        case OPCODE_SUBTRACT:
+            r = a - b;
+            break;
+        case OPCODE_MULTIPLY:
+            r = a * b;
+            break;
+        case OPCODE_DIVIDE:
+            if (isZeroDivisor(b)) {
+                markError(errors[i], ErrorType::DivisionByZero);
+            }
+            r = a / b;
+            break;
+        default:
+            dst[i] = -a;
+            continue;
+        }
+        if (checkOverflow(r)) {
+            markError(errors[i], ErrorType::Overflow);
+        }
+        dst[i] = r;
+    }
+}
+
+#ifdef CALCULATOR_X86_KERNELS
+
+CALCULATOR_TARGET("sse2")
+void sse2Kernel(std::uint8_t op, const double *lhs, const double *rhs,
+                double *dst, ErrorType *errors, std::size_t count) {
+    const __m128d signMask = _mm_set1_pd(-0.0);
+    const __m128d maxValue = _mm_set1_pd(Constants::MAX_CALCULATION_VALUE);
+    const __m128d epsilon = _mm_set1_pd(std::numeric_limits<double>::epsilon());
+
+    std::size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        const __m128d a = _mm_loadu_pd(lhs + i);
+        const __m128d b = _mm_loadu_pd(rhs + i);
+        __m128d r;
+        switch (op) {
+        case OPCODE_ADD:
+            r = _mm_add_pd(a, b);
+            break;
+        case OPCODE_SUBTRACT:
+            r = _mm_sub_pd(a, b);
+            break;
+        case OPCODE_MULTIPLY:
+            r = _mm_mul_pd(a, b);
+            break;
+        case OPCODE_DIVIDE: {
+            const int zero = _mm_movemask_pd(_mm_cmplt_pd(_mm_andnot_pd(signMask, b), epsilon));
+            if (zero) {
+                markErrors(zero, 2, ErrorType::DivisionByZero, errors + i);
+            }
+            r = _mm_div_pd(a, b);
+            break;
+        }
+        default:
+            _mm_storeu_pd(dst + i, _mm_xor_pd(a, signMask));
+            continue;
+        }
+        // !(|r| <= MAX)：非数同样被判为溢出
+        const int overflow = _mm_movemask_pd(_mm_cmpnle_pd(_mm_andnot_pd(signMask, r), maxValue));
+        if (overflow) {
+            markErrors(overflow, 2, ErrorType::Overflow, errors + i);
+        }
+        _mm_storeu_pd(dst + i, r);
+    }
+    scalarKernel(op, lhs + i, rhs + i, dst + i, errors + i, count - i);
+}
+
+CALCULATOR_TARGET("avx2")
+void avx2Kernel(std::uint8_t op, const double *lhs, const double *rhs,
+                double *dst, ErrorType *errors, std::size_t count) {
+    const __m256d signMask = _mm256_set1_pd(-0.0);
+    const __m256d maxValue = _mm256_set1_pd(Constants::MAX_CALCULATION_VALUE);
+    const __m256d epsilon = _mm256_set1_pd(std::numeric_limits<double>::epsilon());
+
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m256d a = _mm256_loadu_pd(lhs + i);
+        const __m256d b = _mm256_loadu_pd(rhs + i);
+        __m256d r;
+        switch (op) {
+        case OPCODE_ADD:
+            r = _mm256_add_pd(a, b);
+            break;
+        case OPCODE_SUBTRACT:
+            r = _mm256_sub_pd(a, b);
+            break;
+        case OPCODE_MULTIPLY:
+            r = _mm256_mul_pd(a, b);
+            break;
+        case OPCODE_DIVIDE: {
+            const int zero = _mm256_movemask_pd(
+                _mm256_cmp_pd(_mm256_andnot_pd(signMask, b), epsilon, _CMP_LT_OQ));
+            if (zero) {
+                markErrors(zero, 4, ErrorType::DivisionByZero, errors + i);
+            }
+            r = _mm256_div_pd(a, b);
+            break;
+        }
+        default:
+            _mm256_storeu_pd(dst + i, _mm256_xor_pd(a, signMask));
+            continue;
+        }
+        const int overflow = _mm256_movemask_pd(
+            _mm256_cmp_pd(_mm256_andnot_pd(signMask, r), maxValue, _CMP_NLE_UQ));
+        if (overflow) {
+            markErrors(overflow, 4, ErrorType::Overflow, errors + i);
+        }
+        _mm256_storeu_pd(dst + i, r);
+    }
+    scalarKernel(op, lhs + i, rhs + i, dst + i, errors + i, count - i);
+}
+
+bool cpuSupportsAvx2() {
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) {
+        return false;  // 操作系统未保存 YMM 寄存器状态
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+bool cpuSupportsSse2() {
+#if defined(__x86_64__) || defined(_M_X64)
+    return true;  // x86-64 基线指令集
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[3] & (1 << 26)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse2");
+#endif
+}
+
+#endif // CALCULATOR_X86_KERNELS
+
+struct KernelSelection {
+    ColumnKernel kernel;
+    const char *name;
+};
+
+KernelSelection detectKernel() {
+#ifdef CALCULATOR_X86_KERNELS
+    if (cpuSupportsAvx2()) {
+        KernelSelection selection = { avx2Kernel, "avx2" };
+        return selection;
+    }
+    if (cpuSupportsSse2()) {
+        KernelSelection selection = { sse2Kernel, "sse2" };
+        return selection;
+    }
+#endif
+    KernelSelection selection = { scalarKernel, "scalar" };
+    return selection;
+}
+
+// 首次使用时检测 CPU，结果在进程内复用
+const KernelSelection &activeKernel() {
+    static const KernelSelection selection = detectKernel();
+    return selection;
+}
+
+} // namespace
+
+const std::size_t ColumnEvaluator::BLOCK_SIZE;
+
+ColumnEvaluator::ColumnEvaluator() {}
+
+bool ColumnEvaluator::compile(const char *formula, int length) {
+    ExpressionParser parser;
+    if (!parser.parse(formula, length, m_expression)) {
+        return false;
+    }
+    return m_program.compile(m_expression);
+}
+
+void ColumnEvaluator::evaluate(const double *const *columns, std::size_t rows,
+                               double *results, ErrorType *errors) const {
+    std::fill(errors, errors + rows, ErrorType::NoError);
+    if (!m_program.isValid()) {
+        std::fill(errors, errors + rows, ErrorType::SyntaxError);
+        std::fill(results, results + rows, 0.0);
+        return;
+    }
+
+    const int variableCount = m_program.variableCount();
+    const std::vector<double> &constants = m_program.constants();
+    const int registerCount = m_program.registerCount();
+    const std::vector<Instruction> &code = m_program.instructions();
+
+    // 工作区：常量广播块 + 临时值块，每个寄存器占 BLOCK_SIZE 个元素
+    std::vector<double> workspace(static_cast<std::size_t>(registerCount - variableCount) * BLOCK_SIZE);
+    for (std::size_t c = 0; c < constants.size(); ++c) {
+        std::fill(workspace.begin() + c * BLOCK_SIZE,
+                  workspace.begin() + (c + 1) * BLOCK_SIZE, constants[c]);
+    }
+
+    std::vector<const double *> sources(registerCount);
+    for (int reg = variableCount; reg < registerCount; ++reg) {
+        sources[reg] = workspace.data() + (reg - variableCount) * BLOCK_SIZE;
+    }
+
+    const ColumnKernel kernel = activeKernel().kernel;
+    for (std::size_t start = 0; start < rows; start += BLOCK_SIZE) {
+        const std::size_t count = std::min(BLOCK_SIZE, rows - start);
+        for (int v = 0; v < variableCount; ++v) {
+            sources[v] = columns[v] + start;
+        }
+
+        ErrorType *blockErrors = errors + start;
+        for (std::size_t i = 0; i < code.size(); ++i) {
+            const Instruction &instruction = code[i];
+            double *dst = workspace.data() + (instruction.dst - variableCount) * BLOCK_SIZE;
+            kernel(instruction.op, sources[instruction.lhs], sources[instruction.rhs],
+                   dst, blockErrors, count);
+        }
+
+        // 结果寄存器可能直接是输入列或常量（没有经过内核的检查），在这里统一检查范围
+        const double *result = sources[m_program.resultRegister()];
+        for (std::size_t i = 0; i < count; ++i) {
+            if (blockErrors[i] == ErrorType::NoError && checkOverflow(result[i])) {
+                blockErrors[i] = ErrorType::Overflow;
+            }
+            results[start + i] = blockErrors[i] == ErrorType::NoError ? result[i] : 0.0;
+        }
+    }
+}
+
+bool ColumnEvaluator::evaluate(const std::vector<std::vector<double> > &columns,
+                               std::vector<double> &results, std::vector<ErrorType> &errors) const {
+    const std::size_t rows = columns.empty() ? 0 : columns.front().size();
+    bool valid = columns.size() >= static_cast<std::size_t>(variableCount());
+    for (std::size_t i = 1; valid && i < columns.size(); ++i) {
+        valid = columns[i].size() == rows;
+    }
+    if (!valid) {
+        results.clear();
+        errors.clear();
+        return false;
+    }
+
+    std::vector<const double *> pointers(columns.size());
+    for (std::size_t i = 0; i < columns.size(); ++i) {
+        pointers[i] = columns[i].data();
+    }
+    results.resize(rows);
+    errors.resize(rows);
+    evaluate(pointers.data(), rows, results.data(), errors.data());
+    return true;
+}
+
+const char *ColumnEvaluator::kernelName() {
+    return activeKernel().name;
+}
+
+} // namespace Calculator
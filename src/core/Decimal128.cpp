@@ -0,0 +1,739 @@
+/**
+ * @file Decimal128.cpp
+ * @brief 128 位十进制定点数实现
+ */
+
+#include "../../inc/core/Decimal128.h"
+#include <cmath>
+#include <cstring>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+#if defined(__SIZEOF_INT128__) && !defined(CALCULATOR_NO_INT128)
+#define CALCULATOR_HAS_INT128 1
+// __extension__ 避免 -Wpedantic 对非标准整数类型的警告
+__extension__ typedef unsigned __int128 NativeUInt128;
+#endif
+
+namespace Calculator {
+
+const int DecimalContext::DEFAULT_SCALE;
+const int DecimalContext::MAX_SCALE;
+const int Decimal128::MAX_DIGITS;
+const int Decimal128::MAX_TEXT_LENGTH;
+
+namespace {
+
+// 128 位无符号整数（双字）
+struct UInt128 {
+    std::uint64_t low;
+    std::uint64_t high;
+};
+
+// 最大绝对值 10^38 - 1
+const UInt128 MAX_MAGNITUDE = { 0x098A223FFFFFFFFFull, 0x4B3B4CA85A86C47Aull };
+
+const std::uint64_t POWERS_OF_TEN[20] = {
+    1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull,
+    100000000ull, 1000000000ull, 10000000000ull, 100000000000ull, 1000000000000ull,
+    10000000000000ull, 100000000000000ull, 1000000000000000ull, 10000000000000000ull,
+    100000000000000000ull, 1000000000000000000ull, 10000000000000000000ull
+};
+
+/**
+ * @brief 预先求逆的除数
+ * 除以 10 的幂时用乘法代替硬件除法（Möller–Granlund 2011，算法 4）：
+ * normalized 为左移到最高位为 1 的除数，inverse = floor((2^128 - 1) / normalized) - 2^64。
+ */
+struct PreinvertedDivisor {
+    std::uint64_t normalized;
+    std::uint64_t inverse;
+    int shift;
+};
+
+const PreinvertedDivisor POWER_OF_TEN_DIVISORS[20] = {
+    { 0x8000000000000000ull, 0xFFFFFFFFFFFFFFFFull, 63 },   // 10^0
+    { 0xA000000000000000ull, 0x9999999999999999ull, 60 },   // 10^1
+    { 0xC800000000000000ull, 0x47AE147AE147AE14ull, 57 },   // 10^2
+    { 0xFA00000000000000ull, 0x0624DD2F1A9FBE76ull, 54 },   // 10^3
+    { 0x9C40000000000000ull, 0xA36E2EB1C432CA57ull, 50 },   // 10^4
+    { 0xC350000000000000ull, 0x4F8B588E368F0846ull, 47 },   // 10^5
+    { 0xF424000000000000ull, 0x0C6F7A0B5ED8D36Bull, 44 },   // 10^6
+    { 0x9896800000000000ull, 0xAD7F29ABCAF48578ull, 40 },   // 10^7
+    { 0xBEBC200000000000ull, 0x5798EE2308C39DF9ull, 37 },   // 10^8
+    { 0xEE6B280000000000ull, 0x12E0BE826D694B2Eull, 34 },   // 10^9
+    { 0x9502F90000000000ull, 0xB7CDFD9D7BDBAB7Dull, 30 },   // 10^10
+    { 0xBA43B74000000000ull, 0x5FD7FE17964955FDull, 27 },   // 10^11
+    { 0xE8D4A51000000000ull, 0x19799812DEA11197ull, 24 },   // 10^12
+    { 0x9184E72A00000000ull, 0xC25C268497681C26ull, 20 },   // 10^13
+    { 0xB5E620F480000000ull, 0x6849B86A12B9B01Eull, 17 },   // 10^14
+    { 0xE35FA931A0000000ull, 0x203AF9EE756159B2ull, 14 },   // 10^15
+    { 0x8E1BC9BF04000000ull, 0xCD2B297D889BC2B6ull, 10 },   // 10^16
+    { 0xB1A2BC2EC5000000ull, 0x70EF54646D496892ull, 7 },    // 10^17
+    { 0xDE0B6B3A76400000ull, 0x2725DD1D243ABA0Eull, 4 },    // 10^18
+    { 0x8AC7230489E80000ull, 0xD83C94FB6D2AC34Aull, 0 },    // 10^19
+};
+
+const int MAX_EXPONENT = 100000;    // 解析时允许的最大十进制指数
+
+inline int compare128(const UInt128 &a, const UInt128 &b) {
+    if (a.high != b.high) {
+        return a.high < b.high ? -1 : 1;
+    }
+    if (a.low != b.low) {
+        return a.low < b.low ? -1 : 1;
+    }
+    return 0;
+}
+
+inline bool exceedsMax(const UInt128 &value) {
+    return compare128(value, MAX_MAGNITUDE) > 0;
+}
+
+// a + b，返回是否产生进位
+inline bool add128(const UInt128 &a, const UInt128 &b, UInt128 &out) {
+    out.low = a.low + b.low;
+    std::uint64_t carry = out.low < a.low ? 1 : 0;
+    out.high = a.high + b.high + carry;
+    return out.high < a.high || (carry != 0 && out.high == a.high);
+}
+
+// a - b（要求 a >= b）
+inline UInt128 subtract128(const UInt128 &a, const UInt128 &b) {
+    UInt128 out;
+    out.low = a.low - b.low;
+    out.high = a.high - b.high - (a.low < b.low ? 1 : 0);
+    return out;
+}
+
+inline void increment128(UInt128 &value) {
+    if (++value.low == 0) {
+        ++value.high;
+    }
+}
+
+// 64 × 64 → 128
+inline std::uint64_t multiply64(std::uint64_t a, std::uint64_t b, std::uint64_t &high) {
+#ifdef CALCULATOR_HAS_INT128
+    NativeUInt128 product = static_cast<NativeUInt128>(a) * b;
+    high = static_cast<std::uint64_t>(product >> 64);
+    return static_cast<std::uint64_t>(product);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned __int64 productHigh;
+    std::uint64_t low = _umul128(a, b, &productHigh);
+    high = productHigh;
+    return low;
+#else
+    const std::uint64_t a0 = a & 0xFFFFFFFFu, a1 = a >> 32;
+    const std::uint64_t b0 = b & 0xFFFFFFFFu, b1 = b >> 32;
+    const std::uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+    const std::uint64_t middle = (p00 >> 32) + (p01 & 0xFFFFFFFFu) + (p10 & 0xFFFFFFFFu);
+    high = p11 + (p01 >> 32) + (p10 >> 32) + (middle >> 32);
+    return (middle << 32) | (p00 & 0xFFFFFFFFu);
+#endif
+}
+
+#if !defined(CALCULATOR_HAS_INT128) && !(defined(_MSC_VER) && defined(_M_X64) && _MSC_VER >= 1920)
+inline int leadingZeros64(std::uint64_t value) {
+    int count = 0;
+    while ((value & 0x8000000000000000ull) == 0) {
+        value <<= 1;
+        ++count;
+    }
+    return count;
+}
+#endif
+
+// (high:low) / divisor，要求 high < divisor
+inline std::uint64_t divide128(std::uint64_t high, std::uint64_t low, std::uint64_t divisor,
+                               std::uint64_t &remainder) {
+#if defined(CALCULATOR_HAS_INT128) && defined(__x86_64__)
+    // 编译器对 __int128 除法会调用库函数，x86-64 直接用一条 divq
+    std::uint64_t quotient;
+    __asm__("divq %4" : "=a"(quotient), "=d"(remainder) : "a"(low), "d"(high), "rm"(divisor));
+    return quotient;
+#elif defined(CALCULATOR_HAS_INT128)
+    NativeUInt128 dividend = (static_cast<NativeUInt128>(high) << 64) | low;
+    remainder = static_cast<std::uint64_t>(dividend % divisor);
+    return static_cast<std::uint64_t>(dividend / divisor);
+#elif defined(_MSC_VER) && defined(_M_X64) && _MSC_VER >= 1920
+    unsigned __int64 rest;
+    std::uint64_t quotient = _udiv128(high, low, divisor, &rest);
+    remainder = rest;
+    return quotient;
+#else
+    // 以 2^32 为基数的两步试商（Hacker's Delight divlu）
+    const std::uint64_t base = 1ull << 32;
+    const int shift = leadingZeros64(divisor);
+    divisor <<= shift;
+    const std::uint64_t vn1 = divisor >> 32, vn0 = divisor & 0xFFFFFFFFu;
+    const std::uint64_t un32 = shift != 0 ? (high << shift) | (low >> (64 - shift)) : high;
+    const std::uint64_t un10 = low << shift;
+    const std::uint64_t un1 = un10 >> 32, un0 = un10 & 0xFFFFFFFFu;
+
+    std::uint64_t q1 = un32 / vn1;
+    std::uint64_t rhat = un32 - q1 * vn1;
+    while (q1 >= base || q1 * vn0 > ((rhat << 32) | un1)) {
+        --q1;
+        rhat += vn1;
+        if (rhat >= base) {
+            break;
+        }
+    }
+
+    const std::uint64_t un21 = (un32 << 32) + un1 - q1 * divisor;
+    std::uint64_t q0 = un21 / vn1;
+    rhat = un21 - q0 * vn1;
+    while (q0 >= base || q0 * vn0 > ((rhat << 32) | un0)) {
+        --q0;
+        rhat += vn1;
+        if (rhat >= base) {
+            break;
+        }
+    }
+
+    remainder = ((un21 << 32) + un0 - q0 * divisor) >> shift;
+    return (q1 << 32) + q0;
+#endif
+}
+
+// (high:low) / divisor，要求 high 小于除数
+inline std::uint64_t divide128(std::uint64_t high, std::uint64_t low, const PreinvertedDivisor &divisor,
+                               std::uint64_t &remainder) {
+    const std::uint64_t u1 = divisor.shift != 0 ? (high << divisor.shift) | (low >> (64 - divisor.shift)) : high;
+    const std::uint64_t u0 = low << divisor.shift;
+
+    std::uint64_t qHigh;
+    std::uint64_t qLow = multiply64(divisor.inverse, u1, qHigh);
+    qLow += u0;
+    qHigh += u1 + (qLow < u0 ? 1 : 0);
+
+    std::uint64_t quotient = qHigh + 1;
+    std::uint64_t rest = u0 - quotient * divisor.normalized;
+    if (rest > qLow) {
+        --quotient;
+        rest += divisor.normalized;
+    }
+    if (rest >= divisor.normalized) {
+        ++quotient;
+        rest -= divisor.normalized;
+    }
+    remainder = rest >> divisor.shift;
+    return quotient;
+}
+
+// 多字（低位在前）原地除以 64 位除数，返回余数
+std::uint64_t divideWords(std::uint64_t *words, int count, std::uint64_t divisor) {
+    std::uint64_t remainder = 0;
+    for (int i = count - 1; i >= 0; --i) {
+        if (remainder == 0 && words[i] < divisor) {
+            // 商为零的高位字只需把它移入余数
+            remainder = words[i];
+            words[i] = 0;
+        } else if (remainder == 0) {
+            // 高位为零时只需普通的 64 位除法
+            std::uint64_t word = words[i];
+            words[i] = word / divisor;
+            remainder = word % divisor;
+        } else {
+            words[i] = divide128(remainder, words[i], divisor, remainder);
+        }
+    }
+    return remainder;
+}
+
+// 多字原地除以 10^exponent（exponent <= 19），返回余数
+std::uint64_t divideWordsByPowerOfTen(std::uint64_t *words, int count, int exponent) {
+    const PreinvertedDivisor &divisor = POWER_OF_TEN_DIVISORS[exponent];
+    const std::uint64_t value = POWERS_OF_TEN[exponent];
+    std::uint64_t remainder = 0;
+    for (int i = count - 1; i >= 0; --i) {
+        if (remainder == 0 && words[i] < value) {
+            remainder = words[i];
+            words[i] = 0;
+        } else {
+            words[i] = divide128(remainder, words[i], divisor, remainder);
+        }
+    }
+    return remainder;
+}
+
+// value = value * factor + addend，结果超出最大值时返回false
+bool multiplyAdd(UInt128 &value, std::uint64_t factor, std::uint64_t addend) {
+    std::uint64_t lowCarry, highCarry;
+    std::uint64_t low = multiply64(value.low, factor, lowCarry);
+    std::uint64_t high = multiply64(value.high, factor, highCarry);
+    high += lowCarry;
+    if (high < lowCarry) {
+        ++highCarry;
+    }
+    low += addend;
+    if (low < addend && ++high == 0) {
+        ++highCarry;
+    }
+    if (highCarry != 0) {
+        return false;
+    }
+    value.low = low;
+    value.high = high;
+    return !exceedsMax(value);
+}
+
+/**
+ * @brief 多段除法（Knuth 算法 D，32 位分段）
+ * dividend 有 m 段、divisor 有 n 段（n >= 2，最高段非零，m >= n），
+ * 商写入 quotient[0..m-n]，余数写入 remainder[0..n-1]。
+ */
+void divideLimbs(const std::uint32_t *dividend, int m, const std::uint32_t *divisor, int n,
+                 std::uint32_t *quotient, std::uint32_t *remainder) {
+    std::uint32_t u[9], v[4];
+    int shift = 0;
+    for (std::uint32_t top = divisor[n - 1]; (top & 0x80000000u) == 0; top <<= 1) {
+        ++shift;
+    }
+    for (int i = n - 1; i >= 0; --i) {
+        v[i] = (divisor[i] << shift) | (shift != 0 && i > 0 ? divisor[i - 1] >> (32 - shift) : 0);
+    }
+    u[m] = shift != 0 ? dividend[m - 1] >> (32 - shift) : 0;
+    for (int i = m - 1; i >= 0; --i) {
+        u[i] = (dividend[i] << shift) | (shift != 0 && i > 0 ? dividend[i - 1] >> (32 - shift) : 0);
+    }
+
+    const std::uint64_t base = 1ull << 32;
+    for (int j = m - n; j >= 0; --j) {
+        std::uint64_t numerator = (static_cast<std::uint64_t>(u[j + n]) << 32) | u[j + n - 1];
+        std::uint64_t qhat = numerator / v[n - 1];
+        std::uint64_t rhat = numerator % v[n - 1];
+        while (qhat >= base || qhat * v[n - 2] > ((rhat << 32) | u[j + n - 2])) {
+            --qhat;
+            rhat += v[n - 1];
+            if (rhat >= base) {
+                break;
+            }
+        }
+
+        std::int64_t borrow = 0;
+        std::uint64_t carry = 0;
+        for (int i = 0; i < n; ++i) {
+            std::uint64_t product = qhat * v[i] + carry;
+            carry = product >> 32;
+            std::int64_t diff = static_cast<std::int64_t>(u[i + j]) - borrow -
+                                static_cast<std::int64_t>(product & 0xFFFFFFFFu);
+            borrow = diff < 0 ? 1 : 0;
+            u[i + j] = static_cast<std::uint32_t>(diff + (borrow << 32));
+        }
+        std::int64_t diff = static_cast<std::int64_t>(u[j + n]) - borrow - static_cast<std::int64_t>(carry);
+        u[j + n] = static_cast<std::uint32_t>(diff);
+
+        if (diff < 0) {
+            --qhat;
+            std::uint64_t sum = 0;
+            for (int i = 0; i < n; ++i) {
+                sum += static_cast<std::uint64_t>(u[i + j]) + v[i];
+                u[i + j] = static_cast<std::uint32_t>(sum);
+                sum >>= 32;
+            }
+            u[j + n] += static_cast<std::uint32_t>(sum);
+        }
+        quotient[j] = static_cast<std::uint32_t>(qhat);
+    }
+
+    for (int i = 0; i < n; ++i) {
+        remainder[i] = (u[i] >> shift) | (shift != 0 ? u[i + 1] << (32 - shift) : 0);
+    }
+}
+
+// 余数与除数一半的比较：-1 小于一半，0 恰为一半，1 大于一半
+inline int compareHalf(std::uint64_t remainder, std::uint64_t divisor) {
+    std::uint64_t rest = divisor - remainder;
+    return remainder < rest ? -1 : (remainder == rest ? 0 : 1);
+}
+
+inline int compareHalf(const UInt128 &remainder, const UInt128 &divisor) {
+    return compare128(remainder, subtract128(divisor, remainder));
+}
+
+// 按舍入模式判断被舍去的部分是否需要进位
+bool shouldRoundUp(RoundingMode mode, bool negative, bool odd, int half, bool inexact) {
+    if (!inexact) {
+        return false;
+    }
+    switch (mode) {
+    case RoundingMode::HalfEven:
+        return half > 0 || (half == 0 && odd);
+    case RoundingMode::HalfUp:
+        return half >= 0;
+    case RoundingMode::Down:
+        return false;
+    case RoundingMode::Up:
+        return true;
+    case RoundingMode::Ceiling:
+        return !negative;
+    case RoundingMode::Floor:
+        return negative;
+    }
+    return false;
+}
+
+} // namespace
+
+bool Decimal128::parse(const char *text, int length, const DecimalContext &context, Decimal128 &out) {
+    int pos = 0;
+    bool negative = false;
+    if (pos < length && (text[pos] == '-' || text[pos] == '+')) {
+        negative = text[pos] == '-';
+        ++pos;
+    }
+
+    // 定位整数部分与小数部分
+    const int integerStart = pos;
+    while (pos < length && text[pos] >= '0' && text[pos] <= '9') {
+        ++pos;
+    }
+    const int integerEnd = pos;
+    int fractionStart = pos, fractionEnd = pos;
+    if (pos < length && text[pos] == '.') {
+        fractionStart = ++pos;
+        while (pos < length && text[pos] >= '0' && text[pos] <= '9') {
+            ++pos;
+        }
+        fractionEnd = pos;
+    }
+    const int integerDigits = integerEnd - integerStart;
+    const int totalDigits = integerDigits + (fractionEnd - fractionStart);
+    if (totalDigits == 0) {
+        return false;
+    }
+
+    int exponent = 0;
+    if (pos < length && (text[pos] == 'e' || text[pos] == 'E')) {
+        ++pos;
+        bool negativeExponent = false;
+        if (pos < length && (text[pos] == '-' || text[pos] == '+')) {
+            negativeExponent = text[pos] == '-';
+            ++pos;
+        }
+        if (pos >= length) {
+            return false;
+        }
+        for (; pos < length && text[pos] >= '0' && text[pos] <= '9'; ++pos) {
+            exponent = exponent * 10 + (text[pos] - '0');
+            if (exponent > MAX_EXPONENT) {
+                return false;
+            }
+        }
+        if (negativeExponent) {
+            exponent = -exponent;
+        }
+    }
+    if (pos != length) {
+        return false;
+    }
+
+    // 第 k 个数字（整数部分与小数部分连续编号）
+    auto digitAt = [&](int k) -> int {
+        return k < integerDigits ? text[integerStart + k] - '0'
+                                 : text[fractionStart + k - integerDigits] - '0';
+    };
+
+    // 保留到小数点后 scale 位的数字个数，其余位参与舍入
+    const int kept = integerDigits + exponent + context.scale;
+    UInt128 magnitude = { 0, 0 };
+    const int accumulated = kept < totalDigits ? kept : totalDigits;
+    for (int k = 0; k < accumulated; ++k) {
+        if (!multiplyAdd(magnitude, 10, static_cast<std::uint64_t>(digitAt(k)))) {
+            return false;
+        }
+    }
+    if (kept > totalDigits && (magnitude.low != 0 || magnitude.high != 0)) {
+        for (int k = totalDigits; k < kept; ++k) {
+            if (!multiplyAdd(magnitude, 10, 0)) {
+                return false;
+            }
+        }
+    }
+
+    if (kept < totalDigits) {
+        int first = 0;
+        bool sticky = false;
+        for (int k = kept < 0 ? 0 : kept; k < totalDigits; ++k) {
+            int digit = digitAt(k);
+            if (k == kept) {
+                first = digit;
+            } else if (digit != 0) {
+                sticky = true;
+            }
+        }
+        const int half = first > 5 ? 1 : (first == 5 ? (sticky ? 1 : 0) : -1);
+        if (shouldRoundUp(context.rounding, negative, (magnitude.low & 1) != 0, half,
+                          first != 0 || sticky)) {
+            increment128(magnitude);
+            if (exceedsMax(magnitude)) {
+                return false;
+            }
+        }
+    }
+
+    out.m_low = magnitude.low;
+    out.m_high = magnitude.high;
+    out.m_negative = negative && !out.isZero();
+    return true;
+}
+
+Decimal128 Decimal128::fromInteger(long long value, const DecimalContext &context) {
+    Decimal128 result;
+    std::uint64_t magnitude = value < 0 ? 0 - static_cast<std::uint64_t>(value)
+                                        : static_cast<std::uint64_t>(value);
+    result.m_low = multiply64(magnitude, POWERS_OF_TEN[context.scale], result.m_high);
+    result.m_negative = value < 0;
+    return result;
+}
+
+ErrorType Decimal128::add(const Decimal128 &lhs, const Decimal128 &rhs, Decimal128 &result) {
+    const UInt128 a = { lhs.m_low, lhs.m_high };
+    const UInt128 b = { rhs.m_low, rhs.m_high };
+    UInt128 magnitude;
+    bool negative;
+
+    if (lhs.m_negative == rhs.m_negative) {
+        if (add128(a, b, magnitude) || exceedsMax(magnitude)) {
+            return ErrorType::Overflow;
+        }
+        negative = lhs.m_negative;
+    } else if (compare128(a, b) >= 0) {
+        magnitude = subtract128(a, b);
+        negative = lhs.m_negative;
+    } else {
+        magnitude = subtract128(b, a);
+        negative = rhs.m_negative;
+    }
+
+    result.m_low = magnitude.low;
+    result.m_high = magnitude.high;
+    result.m_negative = negative && !result.isZero();
+    return ErrorType::NoError;
+}
+
+ErrorType Decimal128::subtract(const Decimal128 &lhs, const Decimal128 &rhs, Decimal128 &result) {
+    return add(lhs, -rhs, result);
+}
+
+ErrorType Decimal128::multiply(const Decimal128 &lhs, const Decimal128 &rhs,
+                               const DecimalContext &context, Decimal128 &result) {
+    const bool negative = lhs.m_negative != rhs.m_negative;
+    const std::uint64_t divisor = POWERS_OF_TEN[context.scale];
+
+    // 常见情况：两个操作数都只有一个字，乘积的高字小于 10^scale，一次预求逆除法即可
+    if (lhs.m_high == 0 && rhs.m_high == 0) {
+        std::uint64_t high;
+        std::uint64_t low = multiply64(lhs.m_low, rhs.m_low, high);
+        if (high < divisor) {
+            std::uint64_t remainder;
+            std::uint64_t quotient = divide128(high, low, POWER_OF_TEN_DIVISORS[context.scale], remainder);
+            UInt128 magnitude = { quotient, 0 };
+            if (remainder != 0 &&
+                shouldRoundUp(context.rounding, negative, (quotient & 1) != 0,
+                              compareHalf(remainder, divisor), true)) {
+                increment128(magnitude);
+            }
+            result.m_low = magnitude.low;
+            result.m_high = magnitude.high;
+            result.m_negative = negative && !result.isZero();
+            return ErrorType::NoError;
+        }
+    }
+
+    // 256 位乘积
+    std::uint64_t product[4] = { 0, 0, 0, 0 };
+    product[0] = multiply64(lhs.m_low, rhs.m_low, product[1]);
+    if (lhs.m_high != 0 || rhs.m_high != 0) {
+        std::uint64_t high, carry;
+        std::uint64_t low = multiply64(lhs.m_low, rhs.m_high, high);
+        product[1] += low;
+        carry = product[1] < low ? 1 : 0;
+        product[2] = high + carry;
+        product[3] = product[2] < high ? 1 : 0;
+
+        low = multiply64(lhs.m_high, rhs.m_low, high);
+        product[1] += low;
+        carry = product[1] < low ? 1 : 0;
+        product[2] += carry;
+        product[3] += product[2] < carry ? 1 : 0;
+        product[2] += high;
+        product[3] += product[2] < high ? 1 : 0;
+
+        low = multiply64(lhs.m_high, rhs.m_high, high);
+        product[2] += low;
+        product[3] += (product[2] < low ? 1 : 0) + high;
+    }
+
+    // 除以 10^scale 并舍入
+    const std::uint64_t remainder = divisor > 1 ? divideWordsByPowerOfTen(product, 4, context.scale) : 0;
+    if (product[2] != 0 || product[3] != 0) {
+        return ErrorType::Overflow;
+    }
+
+    UInt128 magnitude = { product[0], product[1] };
+    if (remainder != 0 &&
+        shouldRoundUp(context.rounding, negative, (magnitude.low & 1) != 0,
+                      compareHalf(remainder, divisor), true)) {
+        increment128(magnitude);
+    }
+    if (exceedsMax(magnitude)) {
+        return ErrorType::Overflow;
+    }
+
+    result.m_low = magnitude.low;
+    result.m_high = magnitude.high;
+    result.m_negative = negative && !result.isZero();
+    return ErrorType::NoError;
+}
+
+ErrorType Decimal128::divide(const Decimal128 &lhs, const Decimal128 &rhs,
+                             const DecimalContext &context, Decimal128 &result) {
+    if (rhs.isZero()) {
+        return ErrorType::DivisionByZero;
+    }
+
+    // 被除数放大 10^scale 得到 192 位中间值
+    const std::uint64_t factor = POWERS_OF_TEN[context.scale];
+    std::uint64_t numerator[3];
+    std::uint64_t lowCarry;
+    numerator[0] = multiply64(lhs.m_low, factor, lowCarry);
+    numerator[1] = multiply64(lhs.m_high, factor, numerator[2]);
+    numerator[1] += lowCarry;
+    numerator[2] += numerator[1] < lowCarry ? 1 : 0;
+
+    const bool negative = lhs.m_negative != rhs.m_negative;
+    UInt128 magnitude;
+    bool odd;
+    int half;
+    bool inexact;
+
+    if (rhs.m_high == 0) {
+        // 除数只有一个字：逐字长除法
+        const std::uint64_t remainder = divideWords(numerator, 3, rhs.m_low);
+        if (numerator[2] != 0) {
+            return ErrorType::Overflow;
+        }
+        magnitude.low = numerator[0];
+        magnitude.high = numerator[1];
+        inexact = remainder != 0;
+        half = inexact ? compareHalf(remainder, rhs.m_low) : -1;
+    } else {
+        // 通用路径：按 32 位分段做 Knuth 除法
+        std::uint32_t dividend[6], divisor[4], quotient[6] = { 0, 0, 0, 0, 0, 0 }, remainder[4];
+        for (int i = 0; i < 3; ++i) {
+            dividend[2 * i] = static_cast<std::uint32_t>(numerator[i]);
+            dividend[2 * i + 1] = static_cast<std::uint32_t>(numerator[i] >> 32);
+        }
+        divisor[0] = static_cast<std::uint32_t>(rhs.m_low);
+        divisor[1] = static_cast<std::uint32_t>(rhs.m_low >> 32);
+        divisor[2] = static_cast<std::uint32_t>(rhs.m_high);
+        divisor[3] = static_cast<std::uint32_t>(rhs.m_high >> 32);
+        const int divisorLimbs = divisor[3] != 0 ? 4 : 3;
+        int dividendLimbs = 6;
+        while (dividendLimbs > 0 && dividend[dividendLimbs - 1] == 0) {
+            --dividendLimbs;
+        }
+
+        UInt128 rest = { numerator[0], numerator[1] };
+        if (dividendLimbs < divisorLimbs) {
+            magnitude.low = 0;
+            magnitude.high = 0;
+        } else {
+            divideLimbs(dividend, dividendLimbs, divisor, divisorLimbs, quotient, remainder);
+            for (int i = divisorLimbs; i < 4; ++i) {
+                remainder[i] = 0;
+            }
+            if (quotient[4] != 0 || quotient[5] != 0) {
+                return ErrorType::Overflow;
+            }
+            magnitude.low = quotient[0] | (static_cast<std::uint64_t>(quotient[1]) << 32);
+            magnitude.high = quotient[2] | (static_cast<std::uint64_t>(quotient[3]) << 32);
+            rest.low = remainder[0] | (static_cast<std::uint64_t>(remainder[1]) << 32);
+            rest.high = remainder[2] | (static_cast<std::uint64_t>(remainder[3]) << 32);
+        }
+        const UInt128 divisorValue = { rhs.m_low, rhs.m_high };
+        inexact = rest.low != 0 || rest.high != 0;
+        half = inexact ? compareHalf(rest, divisorValue) : -1;
+    }
+
+    odd = (magnitude.low & 1) != 0;
+    if (shouldRoundUp(context.rounding, negative, odd, half, inexact)) {
+        increment128(magnitude);
+    }
+    if (exceedsMax(magnitude)) {
+        return ErrorType::Overflow;
+    }
+
+    result.m_low = magnitude.low;
+    result.m_high = magnitude.high;
+    result.m_negative = negative && !result.isZero();
+    return ErrorType::NoError;
+}
+
+int Decimal128::compare(const Decimal128 &lhs, const Decimal128 &rhs) {
+    if (lhs.m_negative != rhs.m_negative) {
+        return lhs.m_negative ? -1 : 1;
+    }
+    const UInt128 a = { lhs.m_low, lhs.m_high };
+    const UInt128 b = { rhs.m_low, rhs.m_high };
+    int cmp = compare128(a, b);
+    return lhs.m_negative ? -cmp : cmp;
+}
+
+double Decimal128::toDouble(int scale) const {
+    double magnitude = std::ldexp(static_cast<double>(m_high), 64) + static_cast<double>(m_low);
+    double value = magnitude / static_cast<double>(POWERS_OF_TEN[scale]);
+    return m_negative ? -value : value;
+}
+
+int Decimal128::format(int scale, char *buffer) const {
+    // 以 10^19 为基数拆出十进制数字（从低位向高位写）
+    char digits[MAX_DIGITS + 2];
+    int count = 0;
+    std::uint64_t words[2] = { m_low, m_high };
+    while (words[0] != 0 || words[1] != 0) {
+        std::uint64_t chunk = divideWordsByPowerOfTen(words, 2, 19);
+        const bool last = words[0] == 0 && words[1] == 0;
+        for (int i = 0; i < 19 && (chunk != 0 || !last); ++i) {
+            digits[count++] = static_cast<char>('0' + chunk % 10);
+            chunk /= 10;
+        }
+    }
+
+    // 补足到至少 scale + 1 位，保证小数点前有数字
+    while (count < scale + 1) {
+        digits[count++] = '0';
+    }
+
+    // 去掉小数部分的末尾零
+    int fraction = scale;
+    int lowest = 0;
+    while (fraction > 0 && digits[lowest] == '0') {
+        ++lowest;
+        --fraction;
+    }
+
+    int length = 0;
+    if (m_negative) {
+        buffer[length++] = '-';
+    }
+    for (int i = count - 1; i >= lowest; --i) {
+        if (i == lowest + fraction - 1) {
+            buffer[length++] = '.';
+        }
+        buffer[length++] = digits[i];
+    }
+    return length;
+}
+
+std::string Decimal128::toString(int scale) const {
+    char buffer[MAX_TEXT_LENGTH];
+    return std::string(buffer, static_cast<size_t>(format(scale, buffer)));
+}
+
+} // namespace Calculator
@@ -0,0 +1,126 @@
+/**
+ * @file Expression.cpp
+ * @brief 已编译的中缀表达式实现
+ */
+
+#include "../../inc/core/Expression.h"
+#include "../../inc/core/Arithmetic.h"
+#include "../../inc/core/ResultCache.h"
+
+namespace Calculator {
+
+constexpr int Expression::MAX_STACK_DEPTH;
+
+Expression::Expression()
+    : m_stackDepth(0)
+    , m_maxStackDepth(0)
+{
+}
+
+namespace {
+
+// 后序数组顺序扫描即为逆波兰求值；apply 执行一次二元运算
+template <typename Apply>
+double evaluateNodes(const std::vector<ExpressionNode> &nodes, const double *variables,
+                     ErrorType &error, Apply apply) {
+    double stack[Expression::MAX_STACK_DEPTH];
+    int top = 0;
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+        const ExpressionNode &node = nodes[i];
+        switch (node.kind) {
+        case NodeKind::Constant:
+            stack[top++] = node.value;
+            break;
+        case NodeKind::Variable:
+            stack[top++] = variables[node.lhs];
+            break;
+        case NodeKind::Negate:
+            stack[top - 1] = -stack[top - 1];
+            break;
+        case NodeKind::Binary:
+            --top;
+            stack[top - 1] = apply(node.op, stack[top - 1], stack[top], error);
+            if (error != ErrorType::NoError) {
+                return 0.0;
+            }
+            break;
+        }
+    }
+    // 常量、变量与取负不经过 apply，结果在这里统一检查范围
+    if (checkOverflow(stack[0])) {
+        error = ErrorType::Overflow;
+        return 0.0;
+    }
+    return stack[0];
+}
+
+} // namespace
+
+double Expression::evaluate(const double *variables, ErrorType &error) const {
+    error = ErrorType::NoError;
+    if (m_nodes.empty()) {
+        error = ErrorType::SyntaxError;
+        return 0.0;
+    }
+    return evaluateNodes(m_nodes, variables, error,
+                         [](Operator op, double lhs, double rhs, ErrorType &failure) {
+                             return applyOperator(op, lhs, rhs, failure);
+                         });
+}
+
+double Expression::evaluate(const double *variables, ErrorType &error, ResultCache *cache) const {
+    if (!cache) {
+        return evaluate(variables, error);
+    }
+    error = ErrorType::NoError;
+    if (m_nodes.empty()) {
+        error = ErrorType::SyntaxError;
+        return 0.0;
+    }
+    return evaluateNodes(m_nodes, variables, error,
+                         [cache](Operator op, double lhs, double rhs, ErrorType &failure) {
+                             return cache->apply(op, lhs, rhs, failure);
+                         });
+}
+
+int Expression::variableIndex(const std::string &name) const {
+    for (std::size_t i = 0; i < m_variables.size(); ++i) {
+        if (m_variables[i] == name) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+void Expression::clear() {
+    m_nodes.clear();
+    m_variables.clear();
+    m_stackDepth = 0;
+    m_maxStackDepth = 0;
+}
+
+int Expression::addNode(const ExpressionNode &node) {
+    // 跟踪逆波兰求值时的栈深度
+    if (node.kind == NodeKind::Constant || node.kind == NodeKind::Variable) {
+        ++m_stackDepth;
+    } else if (node.kind == NodeKind::Binary) {
+        --m_stackDepth;
+    }
+    if (m_stackDepth > m_maxStackDepth) {
+        m_maxStackDepth = m_stackDepth;
+    }
+    m_nodes.push_back(node);
+    return static_cast<int>(m_nodes.size()) - 1;
+}
+
+int Expression::internVariable(const char *name, int length) {
+    for (std::size_t i = 0; i < m_variables.size(); ++i) {
+        if (m_variables[i].compare(0, std::string::npos, name, length) == 0) {
+            return static_cast<int>(i);
+        }
+    }
+    m_variables.push_back(std::string(name, length));
+    return static_cast<int>(m_variables.size()) - 1;
+}
+
+} // namespace Calculator
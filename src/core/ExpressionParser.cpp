@@ -0,0 +1,223 @@
+/**
+ * @file ExpressionParser.cpp
+ * @brief 中缀表达式解析器实现
+ */
+
+#include "../../inc/core/ExpressionParser.h"
+#include "../../inc/utils/NumberParser.h"
+
+namespace Calculator {
+
+namespace {
+
+// UTF-8 编码的 × 与 ÷
+const unsigned char UTF8_LEAD = 0xC3;
+const unsigned char UTF8_TIMES = 0x97;
+const unsigned char UTF8_DIVIDE = 0xB7;
+
+inline bool isIdentifierStart(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+}
+
+inline bool isIdentifierChar(char c) {
+    return isIdentifierStart(c) || (c >= '0' && c <= '9');
+}
+
+} // namespace
+
+constexpr int ExpressionParser::MAX_NESTING_DEPTH;
+
+ExpressionParser::ExpressionParser()
+    : m_text(nullptr)
+    , m_length(0)
+    , m_pos(0)
+    , m_depth(0)
+    , m_expression(nullptr)
+    , m_error(ErrorType::NoError)
+    , m_errorPosition(-1)
+{
+}
+
+bool ExpressionParser::parse(const char *text, int length, Expression &expression) {
+    m_text = text;
+    m_length = length;
+    m_pos = 0;
+    m_depth = 0;
+    m_expression = &expression;
+    m_error = ErrorType::NoError;
+    m_errorPosition = -1;
+    expression.clear();
+
+    int root = parseExpression();
+    if (root >= 0) {
+        skipWhitespace();
+        if (m_pos != m_length) {
+            root = fail();  // 表达式后有多余字符
+        } else if (expression.stackDepth() > Expression::MAX_STACK_DEPTH) {
+            root = fail();
+        }
+    }
+
+    if (root < 0) {
+        expression.clear();
+        return false;
+    }
+    return true;
+}
+
+int ExpressionParser::parseExpression() {
+    int lhs = parseTerm();
+    Operator op;
+    while (lhs >= 0 && matchAdditive(op)) {
+        int rhs = parseTerm();
+        if (rhs < 0) {
+            return -1;
+        }
+        ExpressionNode node = { NodeKind::Binary, op, lhs, rhs, 0.0 };
+        lhs = m_expression->addNode(node);
+    }
+    return lhs;
+}
+
+int ExpressionParser::parseTerm() {
+    int lhs = parseUnary();
+    Operator op;
+    while (lhs >= 0 && matchMultiplicative(op)) {
+        int rhs = parseUnary();
+        if (rhs < 0) {
+            return -1;
+        }
+        ExpressionNode node = { NodeKind::Binary, op, lhs, rhs, 0.0 };
+        lhs = m_expression->addNode(node);
+    }
+    return lhs;
+}
+
+int ExpressionParser::parseUnary() {
+    skipWhitespace();
+    if (m_pos < m_length && (m_text[m_pos] == '-' || m_text[m_pos] == '+')) {
+        bool negate = m_text[m_pos] == '-';
+        ++m_pos;
+        if (++m_depth > MAX_NESTING_DEPTH) {
+            return fail();
+        }
+        int operand = parseUnary();
+        --m_depth;
+        if (operand < 0 || !negate) {
+            return operand;
+        }
+        ExpressionNode node = { NodeKind::Negate, Operator::None, operand, -1, 0.0 };
+        return m_expression->addNode(node);
+    }
+    return parsePrimary();
+}
+
+int ExpressionParser::parsePrimary() {
+    skipWhitespace();
+    if (m_pos >= m_length) {
+        return fail();
+    }
+
+    char c = m_text[m_pos];
+
+    // 括号
+    if (c == '(') {
+        ++m_pos;
+        if (++m_depth > MAX_NESTING_DEPTH) {
+            return fail();
+        }
+        int inner = parseExpression();
+        --m_depth;
+        if (inner < 0) {
+            return -1;
+        }
+        skipWhitespace();
+        if (m_pos >= m_length || m_text[m_pos] != ')') {
+            return fail();
+        }
+        ++m_pos;
+        return inner;
+    }
+
+    // 变量
+    if (isIdentifierStart(c)) {
+        int start = m_pos;
+        while (m_pos < m_length && isIdentifierChar(m_text[m_pos])) {
+            ++m_pos;
+        }
+        int variable = m_expression->internVariable(m_text + start, m_pos - start);
+        ExpressionNode node = { NodeKind::Variable, Operator::None, variable, -1, 0.0 };
+        return m_expression->addNode(node);
+    }
+
+    // 数字常量
+    double value = 0.0;
+    int consumed = NumberParser::parse(m_text + m_pos, m_length - m_pos, value);
+    if (consumed == 0) {
+        return fail();
+    }
+    m_pos += consumed;
+    ExpressionNode node = { NodeKind::Constant, Operator::None, -1, -1, value };
+    return m_expression->addNode(node);
+}
+
+void ExpressionParser::skipWhitespace() {
+    while (m_pos < m_length &&
+           (m_text[m_pos] == ' ' || m_text[m_pos] == '\t' ||
+            m_text[m_pos] == '\r' || m_text[m_pos] == '\n')) {
+        ++m_pos;
+    }
+}
+
+bool ExpressionParser::matchAdditive(Operator &op) {
+    skipWhitespace();
+    if (m_pos >= m_length) {
+        return false;
+    }
+    if (m_text[m_pos] == '+') {
+        op = Operator::Add;
+    } else if (m_text[m_pos] == '-') {
+        op = Operator::Subtract;
+    } else {
+        return false;
+    }
+    ++m_pos;
+    return true;
+}
+
+bool ExpressionParser::matchMultiplicative(Operator &op) {
+    skipWhitespace();
+    if (m_pos >= m_length) {
+        return false;
+    }
+    char c = m_text[m_pos];
+    if (c == '*') {
+        op = Operator::Multiply;
+        ++m_pos;
+        return true;
+    }
+    if (c == '/') {
+        op = Operator::Divide;
+        ++m_pos;
+        return true;
+    }
+    if (static_cast<unsigned char>(c) == UTF8_LEAD && m_pos + 1 < m_length) {
+        unsigned char next = static_cast<unsigned char>(m_text[m_pos + 1]);
+        if (next == UTF8_TIMES || next == UTF8_DIVIDE) {
+            op = next == UTF8_TIMES ? Operator::Multiply : Operator::Divide;
+            m_pos += 2;
+            return true;
+        }
+    }
+    return false;
+}
+
+int ExpressionParser::fail() {
+    if (m_error == ErrorType::NoError) {
+        m_error = ErrorType::SyntaxError;
+        m_errorPosition = m_pos;
+    }
+    return -1;
+}
+
+} // namespace Calculator
@@ -0,0 +1,251 @@
+/**
+ * @file ExpressionProgram.cpp
+ * @brief 表达式字节码与寄存器虚拟机实现
+ */
+
+#include "../../inc/core/ExpressionProgram.h"
+#include "../../inc/core/Arithmetic.h"
+#include <cstring>
+
+namespace Calculator {
+
+namespace {
+
+const std::uint8_t OPCODE_ADD = static_cast<std::uint8_t>(Operator::Add);
+const std::uint8_t OPCODE_SUBTRACT = static_cast<std::uint8_t>(Operator::Subtract);
+const std::uint8_t OPCODE_MULTIPLY = static_cast<std::uint8_t>(Operator::Multiply);
+const std::uint8_t OPCODE_DIVIDE = static_cast<std::uint8_t>(Operator::Divide);
+
+/**
+ * @brief 编译期的操作数
+ * 寄存器编号要等常量与临时值的数量确定后才能分配，编译时先记录操作数种类。
+ */
+struct Operand {
+    enum Kind { Variable, Constant, Temporary };
+    Kind kind;
+    int index;      // 变量下标 / 常量池下标 / 临时值所在的栈位置
+    double value;   // 常量值（仅 Constant 有效）
+};
+
+struct PendingInstruction {
+    std::uint8_t op;
+    int dst;        // 目标临时值的栈位置
+    Operand lhs;
+    Operand rhs;
+};
+
+} // namespace
+
+const std::uint8_t ExpressionProgram::OPCODE_NEGATE;
+constexpr int ExpressionProgram::MAX_REGISTERS;
+
+ExpressionProgram::ExpressionProgram()
+    : m_variableCount(0)
+    , m_registerCount(0)
+    , m_resultRegister(0)
+    , m_valid(false)
+{
+}
+
+bool ExpressionProgram::compile(const Expression &expression) {
+    m_code.clear();
+    m_constants.clear();
+    m_variableCount = expression.variableCount();
+    m_registerCount = 0;
+    m_resultRegister = 0;
+    m_valid = false;
+
+    if (!expression.isValid()) {
+        return false;
+    }
+
+    const std::vector<ExpressionNode> &nodes = expression.nodes();
+    std::vector<Operand> stack;
+    std::vector<PendingInstruction> pending;
+    stack.reserve(expression.stackDepth());
+    pending.reserve(nodes.size());
+    int temporaryCount = 0;
+
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+        const ExpressionNode &node = nodes[i];
+        switch (node.kind) {
+        case NodeKind::Constant: {
+            Operand operand = { Operand::Constant, -1, node.value };
+            stack.push_back(operand);
+            break;
+        }
+        case NodeKind::Variable: {
+            Operand operand = { Operand::Variable, node.lhs, 0.0 };
+            stack.push_back(operand);
+            break;
+        }
+        case NodeKind::Negate: {
+            Operand &top = stack.back();
+            if (top.kind == Operand::Constant) {
+                top.value = -top.value;  // 常量折叠
+                break;
+            }
+            int slot = static_cast<int>(stack.size()) - 1;
+            PendingInstruction instruction = { OPCODE_NEGATE, slot, top, top };
+            pending.push_back(instruction);
+            Operand result = { Operand::Temporary, slot, 0.0 };
+            top = result;
+            if (slot + 1 > temporaryCount) {
+                temporaryCount = slot + 1;
+            }
+            break;
+        }
+        case NodeKind::Binary: {
+            Operand rhs = stack.back();
+            stack.pop_back();
+            Operand &lhs = stack.back();
+            if (lhs.kind == Operand::Constant && rhs.kind == Operand::Constant) {
+                // 常量折叠：出错的子表达式保留到运行时报告
+                ErrorType error = ErrorType::NoError;
+                double value = applyOperator(node.op, lhs.value, rhs.value, error);
+                if (error == ErrorType::NoError) {
+                    lhs.value = value;
+                    break;
+                }
+            }
+            int slot = static_cast<int>(stack.size()) - 1;
+            PendingInstruction instruction = { static_cast<std::uint8_t>(node.op), slot, lhs, rhs };
+            pending.push_back(instruction);
+            Operand result = { Operand::Temporary, slot, 0.0 };
+            lhs = result;
+            if (slot + 1 > temporaryCount) {
+                temporaryCount = slot + 1;
+            }
+            break;
+        }
+        }
+    }
+
+    // 合并相同常量并登记到常量池
+    Operand &result = stack.back();
+    for (std::size_t i = 0; i < pending.size(); ++i) {
+        Operand *operands[2] = { &pending[i].lhs, &pending[i].rhs };
+        for (int k = 0; k < 2; ++k) {
+            Operand &operand = *operands[k];
+            if (operand.kind != Operand::Constant) {
+                continue;
+            }
+            std::size_t j = 0;
+            while (j < m_constants.size() &&
+                   std::memcmp(&m_constants[j], &operand.value, sizeof(double)) != 0) {
+                ++j;
+            }
+            if (j == m_constants.size()) {
+                m_constants.push_back(operand.value);
+            }
+            operand.index = static_cast<int>(j);
+        }
+    }
+    if (result.kind == Operand::Constant) {
+        result.index = static_cast<int>(m_constants.size());
+        m_constants.push_back(result.value);
+    }
+
+    const int constantBase = m_variableCount;
+    const int temporaryBase = constantBase + static_cast<int>(m_constants.size());
+    m_registerCount = temporaryBase + temporaryCount;
+    if (m_registerCount > MAX_REGISTERS) {
+        m_constants.clear();
+        return false;
+    }
+
+    // 分配寄存器编号
+    struct Resolver {
+        int constantBase;
+        int temporaryBase;
+        std::uint8_t operator()(const Operand &operand) const {
+            switch (operand.kind) {
+            case Operand::Variable:
+                return static_cast<std::uint8_t>(operand.index);
+            case Operand::Constant:
+                return static_cast<std::uint8_t>(constantBase + operand.index);
+            default:
+                return static_cast<std::uint8_t>(temporaryBase + operand.index);
+            }
+        }
+    };
+    const Resolver resolve = { constantBase, temporaryBase };
+
+    m_code.reserve(pending.size());
+    for (std::size_t i = 0; i < pending.size(); ++i) {
+        const PendingInstruction &p = pending[i];
+        Instruction instruction = {
+            p.op,
+            static_cast<std::uint8_t>(temporaryBase + p.dst),
+            resolve(p.lhs),
+            resolve(p.rhs)
+        };
+        m_code.push_back(instruction);
+    }
+    m_resultRegister = resolve(result);
+    m_valid = true;
+    return true;
+}
+
+double ExpressionProgram::evaluate(const double *variables, ErrorType &error) const {
+    error = ErrorType::NoError;
+    if (!m_valid) {
+        error = ErrorType::SyntaxError;
+        return 0.0;
+    }
+
+    // 变量与常量通常只有几个，逐个拷贝比调用 memcpy 更快
+    double registers[MAX_REGISTERS];
+    for (int i = 0; i < m_variableCount; ++i) {
+        registers[i] = variables[i];
+    }
+    const double *constants = m_constants.data();
+    const int constantCount = static_cast<int>(m_constants.size());
+    for (int i = 0; i < constantCount; ++i) {
+        registers[m_variableCount + i] = constants[i];
+    }
+
+    const Instruction *ip = m_code.data();
+    const Instruction *end = ip + m_code.size();
+    for (; ip != end; ++ip) {
+        const double lhs = registers[ip->lhs];
+        const double rhs = registers[ip->rhs];
+        double result;
+        switch (ip->op) {
+        case OPCODE_ADD:
+            result = lhs + rhs;
+            break;
+        case OPCODE_SUBTRACT:
+            result = lhs - rhs;
+            break;
+        case OPCODE_MULTIPLY:
+            result = lhs * rhs;
+            break;
+        case OPCODE_DIVIDE:
+            if (isZeroDivisor(rhs)) {
+                error = ErrorType::DivisionByZero;
+                return 0.0;
+            }
+            result = lhs / rhs;
+            break;
+        default:
+            // 取负不会改变绝对值，无需溢出检查
+            registers[ip->dst] = -lhs;
+            continue;
+        }
+        if (checkOverflow(result)) {
+            error = ErrorType::Overflow;
+            return 0.0;
+        }
+        registers[ip->dst] = result;
+    }
+    // 只加载常量、变量或只取负的程序不经过上面的检查
+    const double value = registers[m_resultRegister];
+    if (checkOverflow(value)) {
+        error = ErrorType::Overflow;
+        return 0.0;
+    }
+    return value;
+}
+
+} // namespace Calculator
@@ -0,0 +1,474 @@
+/**
+ * @file HistoryIndex.cpp
+ * @brief 计算历史的检索索引实现
+ */
+
+#include "../../inc/core/HistoryIndex.h"
+#include "../../inc/utils/NumberFormatter.h"
+#include <QRegularExpression>
+#include <QStringList>
+#include <QTime>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+namespace Calculator {
+
+namespace {
+
+const double APPROXIMATE_TOLERANCE = 0.01;          // "~" 的相对误差
+const qint64 TIME_WINDOW_MS = 30 * 60 * 1000;       // "10:30" 前后的时间窗口
+const int MAX_PREFIX_RANGES = 24;                   // 整数前缀展开到 10^22，另加一个小数值区间
+const double MIN_FIXED_MAGNITUDE = 1e-4;            // 绝对值更小的结果以科学计数法显示
+const size_t SMALL_TAIL = 64;                       // 逐条插入的新增记录数上限
+
+// 把新增的一段排序后与已有部分归并；排序时先取出键值，避免比较时反复访问日志
+template <typename ValueOf>
+void mergeTail(std::vector<quint32> &keys, size_t start, ValueOf valueOf) {
+    typedef decltype(valueOf(0u)) Value;
+    // 值相同时按键排序，保证结果确定
+    auto less = [&valueOf](quint32 a, quint32 b) {
+        const Value left = valueOf(a);
+        const Value right = valueOf(b);
+        return left < right || (left == right && a < b);
+    };
+
+    // 每次计算后只新增几条：逐条二分插入，避免整段归并
+    if (keys.size() - start <= SMALL_TAIL) {
+        const std::vector<quint32> tail(keys.begin() + start, keys.end());
+        keys.resize(start);
+        for (quint32 key : tail) {
+            keys.insert(std::upper_bound(keys.begin(), keys.end(), key, less), key);
+        }
+        return;
+    }
+
+    std::vector<std::pair<Value, quint32> > tail;
+    tail.reserve(keys.size() - start);
+    for (size_t i = start; i < keys.size(); ++i) {
+        tail.push_back(std::make_pair(valueOf(keys[i]), keys[i]));
+    }
+    std::sort(tail.begin(), tail.end());
+    for (size_t i = 0; i < tail.size(); ++i) {
+        keys[start + i] = tail[i].second;
+    }
+    std::inplace_merge(keys.begin(), keys.begin() + start, keys.end(), less);
+}
+
+void intersectRange(bool *active, double *low, double *high, double newLow, double newHigh) {
+    if (newLow > newHigh) {
+        std::swap(newLow, newHigh);
+    }
+    if (*active) {
+        *low = std::max(*low, newLow);
+        *high = std::min(*high, newHigh);
+    } else {
+        *active = true;
+        *low = newLow;
+        *high = newHigh;
+    }
+}
+
+bool parseNumber(QString text, double *value) {
+    text.remove(',');
+    bool ok = false;
+    *value = text.toDouble(&ok);
+    return ok;
+}
+
+} // namespace
+
+const int HistoryIndex::DEFAULT_LIMIT;
+
+HistoryQuery::HistoryQuery()
+    : hasResultRange(false)
+    , resultLow(0.0)
+    , resultHigh(0.0)
+    , hasTimeRange(false)
+    , timeFrom(0)
+    , timeTo(0)
+    , hasOperandRange(false)
+    , operandLow(0.0)
+    , operandHigh(0.0)
+{
+}
+
+bool HistoryQuery::isEmpty() const {
+    return !hasResultRange && resultPrefix.isEmpty() && !hasTimeRange && !hasOperandRange;
+}
+
+bool HistoryQuery::parse(const QString &text, const QDateTime &now, HistoryQuery *query) {
+    static const QRegularExpression prefixPattern("^-?\\d+(\\.\\d*)?$");
+
+    *query = HistoryQuery();
+    const QString simplified = text.simplified();
+    if (simplified.isEmpty()) {
+        return true;
+    }
+
+    const QStringList tokens = simplified.split(' ');
+    for (const QString &token : tokens) {
+        double value = 0.0;
+        if (token.contains(':')) {
+            const QTime time = QTime::fromString(token, "H:mm");
+            if (!time.isValid()) {
+                return false;
+            }
+            const qint64 center = QDateTime(now.date(), time).toMSecsSinceEpoch();
+            const qint64 from = center - TIME_WINDOW_MS;
+            const qint64 to = center + TIME_WINDOW_MS;
+            if (query->hasTimeRange) {
+                query->timeFrom = std::max(query->timeFrom, from);
+                query->timeTo = std::min(query->timeTo, to);
+            } else {
+                query->hasTimeRange = true;
+                query->timeFrom = from;
+                query->timeTo = to;
+            }
+        } else if (token.startsWith("x~") || token.startsWith("x=")) {
+            if (!parseNumber(token.mid(2), &value)) {
+                return false;
+            }
+            const double delta = token[1] == '~' ? std::fabs(value) * APPROXIMATE_TOLERANCE : 0.0;
+            intersectRange(&query->hasOperandRange, &query->operandLow, &query->operandHigh,
+                           value - delta, value + delta);
+        } else if (token.startsWith('~')) {
+            if (!parseNumber(token.mid(1), &value)) {
+                return false;
+            }
+            const double delta = std::fabs(value) * APPROXIMATE_TOLERANCE;
+            intersectRange(&query->hasResultRange, &query->resultLow, &query->resultHigh,
+                           value - delta, value + delta);
+        } else if (token.contains("..")) {
+            const int separator = token.indexOf("..");
+            double high = 0.0;
+            if (!parseNumber(token.left(separator), &value)
+                || !parseNumber(token.mid(separator + 2), &high)) {
+                return false;
+            }
+            intersectRange(&query->hasResultRange, &query->resultLow, &query->resultHigh, value, high);
+        } else {
+            QString digits = token;
+            digits.remove(',');
+            if (!prefixPattern.match(digits).hasMatch()) {
+                return false;
+            }
+            query->resultPrefix = digits.toLatin1();
+        }
+    }
+    return true;
+}
+
+HistoryIndex::HistoryIndex(const HistoryLog *log)
+    : m_log(log)
+    , m_indexed(0)
+    , m_generation(0)
+{
+}
+
+void HistoryIndex::update() {
+    const quint64 count = m_log->count();
+    // 清空后即使又追加了同样多的记录，已排序的下标也不再对应原来的值
+    if (m_log->generation() != m_generation || count < m_indexed) {
+        m_byResult.clear();
+        m_byTime.clear();
+        m_byOperand.clear();
+        m_indexed = 0;
+        m_generation = m_log->generation();
+    }
+    if (count == m_indexed) {
+        return;
+    }
+    // 操作数索引的键为下标 * 2，记录数须小于 2^31
+    Q_ASSERT(count < (quint64(1) << 31));
+
+    const size_t resultStart = m_byResult.size();
+    const size_t timeStart = m_byTime.size();
+    const size_t operandStart = m_byOperand.size();
+    for (quint64 i = m_indexed; i < count; ++i) {
+        const quint32 index = static_cast<quint32>(i);
+        if (m_log->at(i).errorType() == ErrorType::NoError) {
+            m_byResult.push_back(index);
+        }
+        m_byTime.push_back(index);
+        m_byOperand.push_back(index * 2);
+        m_byOperand.push_back(index * 2 + 1);
+    }
+
+    mergeTail(m_byResult, resultStart, [this](quint32 index) { return resultOf(index); });
+    mergeTail(m_byTime, timeStart, [this](quint32 index) { return timeOf(index); });
+    mergeTail(m_byOperand, operandStart, [this](quint32 key) { return operandOf(key); });
+    m_indexed = count;
+}
+
+QVector<quint64> HistoryIndex::findResults(double low, double high, int limit) {
+    HistoryQuery query;
+    intersectRange(&query.hasResultRange, &query.resultLow, &query.resultHigh, low, high);
+    return search(query, limit);
+}
+
+QVector<quint64> HistoryIndex::findResultPrefix(const QByteArray &prefix, int limit) {
+    HistoryQuery query;
+    query.resultPrefix = prefix;
+    return search(query, limit);
+}
+
+QVector<quint64> HistoryIndex::findNearestResults(double value, int count) {
+    update();
+    QVector<quint64> records;
+    const size_t size = m_byResult.size();
+    size_t right = std::lower_bound(m_byResult.begin(), m_byResult.end(), value,
+                                    [this](quint32 index, double v) { return resultOf(index) < v; })
+                   - m_byResult.begin();
+    size_t left = right;
+    while (records.size() < count && (left > 0 || right < size)) {
+        bool takeLeft;
+        if (left == 0) {
+            takeLeft = false;
+        } else if (right == size) {
+            takeLeft = true;
+        } else {
+            takeLeft = value - resultOf(m_byResult[left - 1]) <= resultOf(m_byResult[right]) - value;
+        }
+        records.append(takeLeft ? m_byResult[--left] : m_byResult[right++]);
+    }
+    return records;
+}
+
+QVector<quint64> HistoryIndex::findByTime(qint64 from, qint64 to, int limit) {
+    HistoryQuery query;
+    query.hasTimeRange = true;
+    query.timeFrom = from;
+    query.timeTo = to;
+    return search(query, limit);
+}
+
+QVector<quint64> HistoryIndex::findOperands(double low, double high, int limit) {
+    HistoryQuery query;
+    intersectRange(&query.hasOperandRange, &query.operandLow, &query.operandHigh, low, high);
+    return search(query, limit);
+}
+
+QVector<quint64> HistoryIndex::search(const HistoryQuery &query, int limit) {
+    update();
+    if (query.isEmpty() || limit <= 0) {
+        return QVector<quint64>();
+    }
+
+    // 每个条件对应的候选区间，选候选总数最少的条件驱动查询
+    Span best[MAX_PREFIX_RANGES];
+    double bestOuter[MAX_PREFIX_RANGES];
+    bool bestIsPrefix = false;
+    int bestCount = 0;
+    size_t bestSize = 0;
+    auto consider = [&](const Span *spans, const double *outer, int count) {
+        size_t total = 0;
+        for (int i = 0; i < count; ++i) {
+            total += spans[i].size();
+        }
+        if (bestCount == 0 || total < bestSize) {
+            std::copy(spans, spans + count, best);
+            if (outer) {
+                std::copy(outer, outer + count, bestOuter);
+            }
+            bestIsPrefix = outer != nullptr;
+            bestCount = count;
+            bestSize = total;
+        }
+    };
+
+    if (query.hasResultRange) {
+        const Span span = resultSpan(query.resultLow, query.resultHigh);
+        consider(&span, nullptr, 1);
+    }
+    if (!query.resultPrefix.isEmpty()) {
+        double lows[MAX_PREFIX_RANGES];
+        double highs[MAX_PREFIX_RANGES];
+        const int ranges = prefixRanges(query.resultPrefix, lows, highs, MAX_PREFIX_RANGES);
+        if (ranges == 0) {
+            return QVector<quint64>();
+        }
+        Span spans[MAX_PREFIX_RANGES];
+        double outer[MAX_PREFIX_RANGES];
+        for (int i = 0; i < ranges; ++i) {
+            spans[i] = resultSpan(lows[i], highs[i]);
+            outer[i] = highs[i] > 0.0 ? highs[i] : lows[i];
+        }
+        consider(spans, outer, ranges);
+    }
+    if (query.hasTimeRange) {
+        const Span span = timeSpan(query.timeFrom, query.timeTo);
+        consider(&span, nullptr, 1);
+    }
+    if (query.hasOperandRange) {
+        const Span span = operandSpan(query.operandLow, query.operandHigh);
+        consider(&span, nullptr, 1);
+    }
+    return collect(best, bestIsPrefix ? bestOuter : nullptr, bestCount, query, limit);
+}
+
+HistoryIndex::Span HistoryIndex::resultSpan(double low, double high) const {
+    const auto begin = std::lower_bound(m_byResult.begin(), m_byResult.end(), low,
+                                        [this](quint32 index, double v) { return resultOf(index) < v; });
+    const auto end = std::upper_bound(begin, m_byResult.end(), high,
+                                      [this](double v, quint32 index) { return v < resultOf(index); });
+    Span span = { &m_byResult, size_t(begin - m_byResult.begin()), size_t(end - m_byResult.begin()) };
+    return span;
+}
+
+HistoryIndex::Span HistoryIndex::timeSpan(qint64 from, qint64 to) const {
+    auto before = [this](quint32 index, qint64 t) { return timeOf(index) < t; };
+    const auto begin = std::lower_bound(m_byTime.begin(), m_byTime.end(), from, before);
+    const auto end = std::lower_bound(begin, m_byTime.end(), to, before);
+    Span span = { &m_byTime, size_t(begin - m_byTime.begin()), size_t(end - m_byTime.begin()) };
+    return span;
+}
+
+HistoryIndex::Span HistoryIndex::operandSpan(double low, double high) const {
+    const auto begin = std::lower_bound(m_byOperand.begin(), m_byOperand.end(), low,
+                                        [this](quint32 key, double v) { return operandOf(key) < v; });
+    const auto end = std::upper_bound(begin, m_byOperand.end(), high,
+                                      [this](double v, quint32 key) { return v < operandOf(key); });
+    Span span = { &m_byOperand, size_t(begin - m_byOperand.begin()), size_t(end - m_byOperand.begin()) };
+    return span;
+}
+
+int HistoryIndex::prefixRanges(const QByteArray &prefix, double *lows, double *highs, int capacity) {
+    const bool negative = prefix.startsWith('-');
+    const QByteArray digits = negative ? prefix.mid(1) : prefix;
+    if (digits.isEmpty() || digits[0] == '.') {
+        return 0;
+    }
+
+    int count = 0;
+    const int dot = digits.indexOf('.');
+
+    // 单个非零整数位（如 "4"、"4.5"）还可能是小数值科学计数法的尾数（"4e-05"、"4.5e-07"）。
+    // 这些值按数量级分散在几百个十进制区间中，合为一个区间 (0, 1e-4]，由显示文本校验
+    if (digits[0] != '0' && (digits.size() == 1 || dot == 1)) {
+        lows[count] = std::numeric_limits<double>::denorm_min();
+        highs[count] = MIN_FIXED_MAGNITUDE;
+        ++count;
+    }
+
+    if (dot >= 0) {
+        // 整数部分已确定，如 "4.2" 对应 [4.2, 4.3)
+        const double low = std::strtod(digits.constData(), nullptr);
+        lows[count] = low;
+        highs[count] = low + std::pow(10.0, -(digits.size() - dot - 1));
+        ++count;
+    } else if (digits == "0") {
+        // "0" 与 "0.xxx"
+        lows[count] = 0.0;
+        highs[count] = 1.0;
+        ++count;
+    } else if (digits[0] != '0') {
+        // 整数前缀 p 对应 [p·10^k, (p+1)·10^k)，较大的值以科学计数法显示，同样以 p 的首位开头
+        const double value = std::strtod(digits.constData(), nullptr);
+        double scale = 1.0;
+        for (; count < capacity; ++count) {
+            lows[count] = value * scale;
+            highs[count] = (value + 1.0) * scale;
+            scale *= 10.0;
+        }
+    }
+
+    if (negative) {
+        for (int i = 0; i < count; ++i) {
+            const double low = lows[i];
+            lows[i] = -highs[i];
+            highs[i] = -low;
+        }
+    }
+    return count;
+}
+
+bool HistoryIndex::prefixImpliedByRange(double value, double outer) {
+    // 定点显示（1e-4 <= |value| < 1e15）时，区间内的值只有舍入到区间外端才会改变前缀
+    const double magnitude = std::fabs(value);
+    return magnitude >= MIN_FIXED_MAGNITUDE && magnitude < 1e15
+        && std::fabs(outer - value) > std::fabs(outer) * 1e-13;
+}
+
+bool HistoryIndex::resultHasPrefix(double value, const QByteArray &prefix) {
+
+    char text[NumberFormatter::BUFFER_SIZE];
+    const int length = NumberFormatter::format(value, text);
+    return length >= prefix.size() && std::memcmp(text, prefix.constData(), prefix.size()) == 0;
+}
+
+bool HistoryIndex::matches(const HistoryRecord &record, const HistoryQuery &query,
+                           bool prefixChecked) const {
+    if (query.hasResultRange || !query.resultPrefix.isEmpty()) {
+        if (record.errorType() != ErrorType::NoError) {
+            return false;
+        }
+        if (query.hasResultRange
+            && !(record.result >= query.resultLow && record.result <= query.resultHigh)) {
+            return false;
+        }
+        if (!prefixChecked && !query.resultPrefix.isEmpty()
+            && !resultHasPrefix(record.result, query.resultPrefix)) {
+            return false;
+        }
+    }
+    if (query.hasTimeRange
+        && !(record.timestamp >= query.timeFrom && record.timestamp < query.timeTo)) {
+        return false;
+    }
+    if (query.hasOperandRange) {
+        const bool left = record.leftOperand >= query.operandLow && record.leftOperand <= query.operandHigh;
+        const bool right = record.rightOperand >= query.operandLow && record.rightOperand <= query.operandHigh;
+        if (!left && !right) {
+            return false;
+        }
+    }
+    return true;
+}
+
+QVector<quint64> HistoryIndex::collect(const Span *spans, const double *prefixOuter, int spanCount,
+                                       const HistoryQuery &query, int limit) const {
+    QVector<quint64> records;
+    const bool operandKeys = spanCount > 0 && spans[0].keys == &m_byOperand;
+    const bool byTime = spanCount > 0 && spans[0].keys == &m_byTime;
+
+    for (int s = 0; s < spanCount; ++s) {
+        const Span &span = spans[s];
+        if (byTime) {
+            // 时间索引从新到旧遍历，凑够 limit 条即可停止
+            for (size_t i = span.end; i > span.begin && records.size() < limit; --i) {
+                const quint32 index = (*span.keys)[i - 1];
+                if (matches(m_log->at(index), query, false)) {
+                    records.append(index);
+                }
+            }
+            continue;
+        }
+        for (size_t i = span.begin; i < span.end; ++i) {
+            const quint32 key = (*span.keys)[i];
+            const quint32 index = operandKeys ? key / 2 : key;
+            const HistoryRecord &record = m_log->at(index);
+            // 由前缀区间取出的候选多数无需格式化校验
+            const bool prefixChecked = prefixOuter && prefixImpliedByRange(record.result, prefixOuter[s]);
+            if (matches(record, query, prefixChecked)) {
+                records.append(index);
+            }
+        }
+    }
+
+    std::sort(records.begin(), records.end(), [](quint64 a, quint64 b) { return a > b; });
+    records.erase(std::unique(records.begin(), records.end()), records.end());
+    if (records.size() > limit) {
+        records.resize(limit);
+    }
+    return records;
+}
+
+double HistoryIndex::operandOf(quint32 key) const {
+    const HistoryRecord &record = m_log->at(key / 2);
+    return (key & 1) ? record.rightOperand : record.leftOperand;
+}
+
+} // namespace Calculator
@@ -0,0 +1,180 @@
+/**
+ * @file HistoryLog.cpp
+ * @brief 计算历史记录实现
+ */
+
+#include "../../inc/core/HistoryLog.h"
+#include <QDateTime>
+#include <cstring>
+
+namespace Calculator {
+
+namespace {
+
+const char MAGIC[8] = { 'C', 'A', 'L', 'C', 'H', 'I', 'S', 'T' };
+
+} // namespace
+
+// 文件头（64 字节，位于文件开头）
+struct HistoryLog::Header {
+    char magic[8];          // "CALCHIST"
+    quint32 version;        // FORMAT_VERSION
+    quint32 recordSize;     // sizeof(HistoryRecord)
+    quint64 count;          // 已提交的记录数
+    quint8 reserved[40];
+};
+
+const quint32 HistoryLog::FORMAT_VERSION;
+const quint64 HistoryLog::INITIAL_CAPACITY;
+const quint64 HistoryLog::GROWTH_LIMIT;
+
+HistoryLog::HistoryLog()
+    : m_map(nullptr)
+    , m_header(nullptr)
+    , m_records(nullptr)
+    , m_capacity(0)
+    , m_generation(0)
+{
+    static_assert(sizeof(Header) == 64, "history file header must stay 64 bytes");
+}
+
+HistoryLog::~HistoryLog() {
+    close();
+}
+
+bool HistoryLog::open(const QString &path) {
+    close();
+    m_errorString.clear();
+    ++m_generation;
+
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadWrite)) {
+        return fail(m_file.errorString());
+    }
+
+    const qint64 size = m_file.size();
+    if (size == 0) {
+        if (!remap(INITIAL_CAPACITY)) {
+            return false;
+        }
+        std::memcpy(m_header->magic, MAGIC, sizeof(MAGIC));
+        m_header->version = FORMAT_VERSION;
+        m_header->recordSize = sizeof(HistoryRecord);
+        m_header->count = 0;
+        return true;
+    }
+
+    // 映射前先校验文件头，避免改动不是历史记录的文件
+    Header header;
+    if (size < static_cast<qint64>(sizeof(Header))
+        || m_file.read(reinterpret_cast<char *>(&header), sizeof(Header)) != static_cast<qint64>(sizeof(Header))
+        || std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        return fail(QString("不是历史记录文件: %1").arg(path));
+    }
+    if (header.version != FORMAT_VERSION || header.recordSize != sizeof(HistoryRecord)) {
+        return fail(QString("历史记录文件版本不符: %1").arg(path));
+    }
+    if (!remap((size - sizeof(Header)) / sizeof(HistoryRecord))) {
+        return false;
+    }
+
+    // 文件被截断时以实际容纳的记录数为准
+    if (m_header->count > m_capacity) {
+        m_header->count = m_capacity;
+    }
+    return true;
+}
+
+void HistoryLog::close() {
+    if (!m_file.isOpen()) {
+        return;
+    }
+    if (m_header) {
+        const quint64 used = m_header->count;
+        unmap();
+        m_file.resize(sizeof(Header) + used * sizeof(HistoryRecord));
+    }
+    m_file.close();
+}
+
+quint64 HistoryLog::count() const {
+    return m_header ? m_header->count : 0;
+}
+
+const HistoryRecord &HistoryLog::at(quint64 index) const {
+    Q_ASSERT(index < count());
+    return m_records[index];
+}
+
+bool HistoryLog::append(const HistoryRecord &record) {
+    if (!m_header) {
+        return false;
+    }
+    const quint64 index = m_header->count;
+    if (index == m_capacity) {
+        const quint64 growth = qBound(INITIAL_CAPACITY, m_capacity, GROWTH_LIMIT);
+        if (!remap(m_capacity + growth)) {
+            return false;
+        }
+    }
+    // 先写记录再提交计数
+    m_records[index] = record;
+    m_header->count = index + 1;
+    return true;
+}
+
+bool HistoryLog::append(double left, Operator op, double right, double result, ErrorType error) {
+    HistoryRecord record;
+    std::memset(&record, 0, sizeof(record));
+    record.leftOperand = left;
+    record.rightOperand = right;
+    record.result = result;
+    record.timestamp = QDateTime::currentMSecsSinceEpoch();
+    record.op = static_cast<quint8>(op);
+    record.error = static_cast<quint8>(error);
+    return append(record);
+}
+
+bool HistoryLog::clear() {
+    if (!m_header) {
+        return false;
+    }
+    m_header->count = 0;
+    ++m_generation;
+    return remap(INITIAL_CAPACITY);
+}
+
+bool HistoryLog::remap(quint64 capacity) {
+    unmap();
+    const qint64 size = sizeof(Header) + capacity * sizeof(HistoryRecord);
+    if (m_file.size() != size && !m_file.resize(size)) {
+        return fail(m_file.errorString());
+    }
+    m_map = m_file.map(0, size);
+    if (!m_map) {
+        return fail(m_file.errorString());
+    }
+    m_header = reinterpret_cast<Header *>(m_map);
+    m_records = reinterpret_cast<HistoryRecord *>(m_map + sizeof(Header));
+    m_capacity = capacity;
+    return true;
+}
+
+void HistoryLog::unmap() {
+    if (m_map) {
+        m_file.unmap(m_map);
+    }
+    m_map = nullptr;
+    m_header = nullptr;
+    m_records = nullptr;
+    m_capacity = 0;
+}
+
+bool HistoryLog::fail(const QString &message) {
+    m_errorString = message;
+    unmap();
+    m_file.close();
+    return false;
+}
+
+} // namespace Calculator
@@ -0,0 +1,35 @@
+/**
+ * @file KeystrokeReplay.cpp
+ * @brief 按键序列重放实现
+ */
+
+#include "../../inc/core/KeystrokeReplay.h"
+#include "../../inc/core/CalculatorEngine.h"
+
+namespace Calculator {
+
+// 编译期折叠的按键序列必须与运行时的四则运算结果一致
+static_assert(foldKeystrokes("12*3=").currentState().currentValue == 36.0, "integer chain");
+static_assert(foldKeystrokes("12*2.54=").currentState().currentValue == 12 * 2.54, "unit conversion");
+static_assert(foldKeystrokes("19.99*1.08=").currentState().currentValue == 19.99 * 1.08, "tax");
+static_assert(foldKeystrokes("100-1.5~=").currentState().currentValue == 100 - -1.5, "change sign");
+static_assert(foldKeystrokes("1.259<<5+1=").currentState().currentValue == 1.25 + 1, "backspace");
+static_assert(foldKeystrokes("2+3=4").currentState().currentValue == 54.0, "editing an integer result");
+static_assert(foldKeystrokes("1/0=").currentState().error == ErrorType::DivisionByZero, "division by zero");
+static_assert(foldKeystrokes("99999999*99999999=").currentState().error == ErrorType::Overflow, "overflow");
+
+bool replayKeystroke(CalculatorEngine &engine, char key) {
+    return applyKeystroke(engine, key);
+}
+
+int replayKeystrokes(CalculatorEngine &engine, const char *keys, int length) {
+    int unknown = 0;
+    for (int i = 0; i < length; ++i) {
+        if (!replayKeystroke(engine, keys[i])) {
+            ++unknown;
+        }
+    }
+    return unknown;
+}
+
+} // namespace Calculator
@@ -0,0 +1,79 @@
+/**
+ * @file NumericBackend.cpp
+ * @brief 数值后端实现
+ */
+
+#include "../../inc/core/NumericBackend.h"
+
+namespace Calculator {
+
+const NumericBackendType RationalPolicy::TYPE;
+const NumericBackendType DecimalPolicy::TYPE;
+
+bool RationalPolicy::parse(const char *text, int length, Value &value) const {
+    // 空文本对应显示的 "0"
+    if (length == 0) {
+        value = Value();
+        return true;
+    }
+    return BigRational::fromDecimal(text, length, value);
+}
+
+ErrorType RationalPolicy::apply(Operator op, const Value &lhs, const Value &rhs, Value &result) const {
+    switch (op) {
+    case Operator::Add:
+        result = lhs + rhs;
+        break;
+    case Operator::Subtract:
+        result = lhs - rhs;
+        break;
+    case Operator::Multiply:
+        result = lhs * rhs;
+        break;
+    case Operator::Divide:
+        if (rhs.isZero()) {
+            return ErrorType::DivisionByZero;
+        }
+        result = lhs / rhs;
+        break;
+    default:
+        return ErrorType::SyntaxError;
+    }
+    return ErrorType::NoError;
+}
+
+bool DecimalPolicy::parse(const char *text, int length, Value &value) const {
+    if (length == 0) {
+        value = Value();
+        return true;
+    }
+    return Decimal128::parse(text, length, context, value);
+}
+
+ErrorType DecimalPolicy::apply(Operator op, const Value &lhs, const Value &rhs, Value &result) const {
+    switch (op) {
+    case Operator::Add:
+        return Decimal128::add(lhs, rhs, result);
+    case Operator::Subtract:
+        return Decimal128::subtract(lhs, rhs, result);
+    case Operator::Multiply:
+        return Decimal128::multiply(lhs, rhs, context, result);
+    case Operator::Divide:
+        return Decimal128::divide(lhs, rhs, context, result);
+    default:
+        return ErrorType::SyntaxError;
+    }
+}
+
+std::unique_ptr<NumericBackend> createNumericBackend(NumericBackendType type) {
+    switch (type) {
+    case NumericBackendType::Rational:
+        return std::unique_ptr<NumericBackend>(new RationalBackend());
+    case NumericBackendType::Decimal:
+        return std::unique_ptr<NumericBackend>(new DecimalBackend());
+    default:
+        return std::unique_ptr<NumericBackend>();
+    }
+}
+
+} // namespace Calculator
@@ -0,0 +1,227 @@
+/**
+ * @file ResultCache.cpp
+ * @brief 二元运算结果缓存实现
+ */
+
+#include "../../inc/core/ResultCache.h"
+#include "../../inc/core/Arithmetic.h"
+#include <cstring>
+#include <new>
+
+namespace Calculator {
+
+const int ResultCache::DEFAULT_CAPACITY;
+const int ResultCache::PROBE_SLOTS;
+const int ResultCache::COUNTER_SHARDS;
+
+namespace {
+
+const std::size_t CACHE_LINE = 64;
+const quint32 OCCUPIED = 1u << 16;
+const quint32 ERROR_MASK = 0xffu << 8;
+
+inline quint64 bitsOf(double value) {
+    quint64 bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+inline double valueOf(quint64 bits) {
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// 64 位整数的雪崩混合（MurmurHash3 fmix64）
+inline quint64 mix(quint64 h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+// 计数分片通常只有一个线程写入，不用带锁前缀的原子加；
+// 线程数超过分片数时共用分片的线程之间可能丢失少量计数
+inline void bump(std::atomic<quint64> &counter) {
+    counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+inline quint32 makeTag(Operator op, ErrorType error) {
+    return static_cast<quint32>(op) | (static_cast<quint32>(error) << 8) | OCCUPIED;
+}
+
+} // namespace
+
+ResultCache::ResultCache(int capacity)
+    : m_slots(nullptr)
+    , m_mask(0)
+    , m_counters(nullptr)
+{
+    static_assert(sizeof(Slot) * 2 == CACHE_LINE, "two slots per cache line");
+    static_assert(sizeof(Counter) == CACHE_LINE && alignof(Counter) == CACHE_LINE,
+                  "one counter shard per cache line");
+
+    quint64 slots = PROBE_SLOTS;
+    while (slots < static_cast<quint64>(capacity)) {
+        slots <<= 1;
+    }
+    m_slots = static_cast<Slot*>(qMallocAligned(slots * sizeof(Slot), CACHE_LINE));
+    Q_CHECK_PTR(m_slots);
+    for (quint64 i = 0; i < slots; ++i) {
+        new (&m_slots[i]) Slot;
+    }
+    m_mask = slots - 1;
+
+    // 成员数组只有对象本身的默认对齐，计数分片单独按缓存行分配
+    m_counters = static_cast<Counter*>(qMallocAligned(COUNTER_SHARDS * sizeof(Counter), CACHE_LINE));
+    Q_CHECK_PTR(m_counters);
+    for (int i = 0; i < COUNTER_SHARDS; ++i) {
+        new (&m_counters[i]) Counter;
+    }
+    clear();
+    resetStats();
+}
+
+ResultCache::~ResultCache() {
+    qFreeAligned(m_slots);
+    qFreeAligned(m_counters);
+}
+
+quint64 ResultCache::hashKey(Operator op, quint64 lhs, quint64 rhs) {
+    return mix(lhs ^ ((rhs ^ static_cast<quint64>(op)) * 0x9e3779b97f4a7c15ULL));
+}
+
+int ResultCache::shardIndex() {
+    static std::atomic<int> nextShard(0);
+    thread_local int shard = nextShard.fetch_add(1, std::memory_order_relaxed) % COUNTER_SHARDS;
+    return shard;
+}
+
+bool ResultCache::lookup(Operator op, double lhs, double rhs, double &result, ErrorType &error) {
+    const quint64 left = bitsOf(lhs);
+    const quint64 right = bitsOf(rhs);
+    const quint32 opTag = static_cast<quint32>(op) | OCCUPIED;
+    // 探测从缓存行起点开始：两个槽一行，探测窗口恰好覆盖两条缓存行
+    const quint64 base = hashKey(op, left, right) & m_mask & ~quint64(1);
+    Counter &counter = m_counters[shardIndex()];
+
+    for (int i = 0; i < PROBE_SLOTS; ++i) {
+        Slot &slot = m_slots[(base + i) & m_mask];
+        const quint32 before = slot.sequence.load(std::memory_order_acquire);
+        if (before & 1u) {
+            continue;
+        }
+        const quint32 tag = slot.tag.load(std::memory_order_relaxed);
+        if ((tag & ~ERROR_MASK) != opTag
+            || slot.lhs.load(std::memory_order_relaxed) != left
+            || slot.rhs.load(std::memory_order_relaxed) != right) {
+            continue;
+        }
+        const quint64 value = slot.result.load(std::memory_order_relaxed);
+
+        // 读取期间槽被改写过则结果不可信
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != before) {
+            break;
+        }
+        result = valueOf(value);
+        error = static_cast<ErrorType>((tag & ERROR_MASK) >> 8);
+        bump(counter.hits);
+        return true;
+    }
+    bump(counter.misses);
+    return false;
+}
+
+void ResultCache::insert(Operator op, double lhs, double rhs, double result, ErrorType error) {
+    const quint64 left = bitsOf(lhs);
+    const quint64 right = bitsOf(rhs);
+    const quint32 opTag = static_cast<quint32>(op) | OCCUPIED;
+    const quint64 hash = hashKey(op, left, right);
+    const quint64 base = hash & m_mask & ~quint64(1);
+
+    // 优先复用同键的槽，其次是空槽，都没有时按哈希的高位选一个覆盖
+    quint64 target = base + ((hash >> 32) % PROBE_SLOTS);
+    bool foundEmpty = false;
+    for (int i = 0; i < PROBE_SLOTS; ++i) {
+        const Slot &slot = m_slots[(base + i) & m_mask];
+        const quint32 tag = slot.tag.load(std::memory_order_relaxed);
+        if (tag == 0) {
+            if (!foundEmpty) {
+                target = base + i;
+                foundEmpty = true;
+            }
+            continue;
+        }
+        if ((tag & ~ERROR_MASK) == opTag
+            && slot.lhs.load(std::memory_order_relaxed) == left
+            && slot.rhs.load(std::memory_order_relaxed) == right) {
+            target = base + i;
+            break;
+        }
+    }
+
+    Slot &slot = m_slots[target & m_mask];
+    quint32 sequence = slot.sequence.load(std::memory_order_relaxed);
+    if ((sequence & 1u)
+        || !slot.sequence.compare_exchange_strong(sequence, sequence + 1, std::memory_order_acquire)) {
+        return;
+    }
+    // 奇数序列号先于字段的写入对读者可见
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.tag.store(makeTag(op, error), std::memory_order_relaxed);
+    slot.lhs.store(left, std::memory_order_relaxed);
+    slot.rhs.store(right, std::memory_order_relaxed);
+    slot.result.store(bitsOf(result), std::memory_order_relaxed);
+    slot.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+double ResultCache::apply(Operator op, double lhs, double rhs, ErrorType &error) {
+    double result;
+    ErrorType cachedError;
+    if (lookup(op, lhs, rhs, result, cachedError)) {
+        if (cachedError != ErrorType::NoError) {
+            error = cachedError;
+        }
+        return result;
+    }
+
+    ErrorType computedError = ErrorType::NoError;
+    result = applyOperator(op, lhs, rhs, computedError);
+    insert(op, lhs, rhs, result, computedError);
+    if (computedError != ErrorType::NoError) {
+        error = computedError;
+    }
+    return result;
+}
+
+ResultCache::Stats ResultCache::stats() const {
+    Stats total = { 0, 0 };
+    for (int i = 0; i < COUNTER_SHARDS; ++i) {
+        total.hits += m_counters[i].hits.load(std::memory_order_relaxed);
+        total.misses += m_counters[i].misses.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void ResultCache::resetStats() {
+    for (int i = 0; i < COUNTER_SHARDS; ++i) {
+        m_counters[i].hits.store(0, std::memory_order_relaxed);
+        m_counters[i].misses.store(0, std::memory_order_relaxed);
+    }
+}
+
+void ResultCache::clear() {
+    for (quint64 i = 0; i <= m_mask; ++i) {
+        Slot &slot = m_slots[i];
+        slot.sequence.store(0, std::memory_order_relaxed);
+        slot.tag.store(0, std::memory_order_relaxed);
+        slot.lhs.store(0, std::memory_order_relaxed);
+        slot.rhs.store(0, std::memory_order_relaxed);
+        slot.result.store(0, std::memory_order_relaxed);
+    }
+}
+
+} // namespace Calculator
@@ -7,7 +7,12 @@
  */
 
 #include "../inc/ui/MainWindow.h"
+#include "../inc/utils/Metrics.h"
+#include "../inc/utils/SettingsManager.h"
+#include "../inc/utils/StartupProfiler.h"
+#include "../inc/utils/TraceRecorder.h"
 #include <QApplication>
+#include <QCommandLineParser>
 #include <QTranslator>
 #include <QLibraryInfo>
 #include <QDebug>
@@ -27,6 +32,10 @@ void setupApplication(QApplication &app)
 
 int main(int argc, char *argv[])
 {
+    // 启动计时从 main() 入口开始，--startup-profile 时在首帧后输出各阶段耗时
+    Calculator::StartupProfiler &profiler = Calculator::StartupProfiler::instance();
+    profiler.start();
+
     // 在创建 QApplication 之前设置高DPI属性
     QApplication::setAttribute(Qt::AA_EnableHighDpiScaling);
     QApplication::setAttribute(Qt::AA_UseHighDpiPixmaps);
@@ -36,14 +45,59 @@ int main(int argc, char *argv[])
     
     // 设置应用程序
     setupApplication(app);
+    profiler.mark("QApplication");
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    parser.addVersionOption();
+    QCommandLineOption profileOption("startup-profile", "首帧显示后向标准错误输出启动各阶段耗时");
+    parser.addOption(profileOption);
+    QCommandLineOption metricsFileOption("metrics-file", "定时把引擎指标以 Prometheus 文本格式写入文件", "file");
+    QCommandLineOption metricsIntervalOption("metrics-interval", "指标导出间隔（秒，默认 10）", "seconds", "10");
+    parser.addOption(metricsFileOption);
+    parser.addOption(metricsIntervalOption);
+    QCommandLineOption traceFileOption("trace-file", "记录输入到绘制的追踪事件，退出时写入 Chrome trace JSON 文件", "file");
+    parser.addOption(traceFileOption);
+    parser.process(app);
+    profiler.setEnabled(parser.isSet(profileOption));
+
+    const QString traceFile = parser.value(traceFileOption);
+    if (!traceFile.isEmpty()) {
+        Calculator::TraceRecorder::instance().enable();
+    }
+
+    const bool dumpMetrics = parser.isSet(metricsFileOption);
+    if (dumpMetrics) {
+        if (!Calculator::Metrics::isEnabled()) {
+            qWarning() << "未编入指标（构建时需 CONFIG+=metrics），导出的计数全为零";
+        }
+        Calculator::Metrics::startPeriodicDump(parser.value(metricsFileOption),
+                                               parser.value(metricsIntervalOption).toInt() * 1000);
+    }
     
     try {
         // 创建并显示主窗口
         Calculator::MainWindow window;
+        profiler.mark("MainWindow");
         window.show();
+        profiler.mark("MainWindow::show");
         
         // 执行应用程序主循环
-        return app.exec();
+        const int result = app.exec();
+
+        // 窗口关闭后等待后台线程写完设置
+        Calculator::SettingsManager::instance().waitForWrites();
+        if (dumpMetrics) {
+            Calculator::Metrics::stopPeriodicDump();
+        }
+        if (!traceFile.isEmpty()) {
+            Calculator::TraceRecorder &recorder = Calculator::TraceRecorder::instance();
+            recorder.disable();
+            if (!recorder.writeChromeTrace(traceFile)) {
+                qWarning() << "无法写入追踪文件:" << traceFile;
+            }
+        }
+        return result;
         
     } catch (const std::exception &e) {
         qCritical() << "应用程序异常:" << e.what();
@@ -0,0 +1,459 @@
+/**
+ * @file EngineServer.cpp
+ * @brief 多会话计算引擎服务实现
+ */
+
+#include "../../inc/server/EngineServer.h"
+#include "../../inc/core/CalculatorEngine.h"
+#include "../../inc/core/EngineCore.h"
+#include "../../inc/core/Expression.h"
+#include "../../inc/core/ExpressionParser.h"
+#include "../../inc/core/KeystrokeReplay.h"
+#include "../../inc/utils/NumberFormatter.h"
+#include <QFile>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#ifndef EPOLLEXCLUSIVE
+#define EPOLLEXCLUSIVE 0    // 旧内核头文件：退化为普通注册，多个线程可能同时被唤醒
+#endif
+
+namespace Calculator {
+
+const int EngineServer::READ_CHUNK;
+const int EngineServer::MAX_EVENTS;
+const int EngineServer::ERROR_TYPE_COUNT;
+
+namespace {
+
+// 读缓冲：上次剩下的不完整帧（不超过一个最大帧）加上一次读取
+const int READ_BUFFER_SIZE = EngineServer::READ_CHUNK + REQUEST_HEADER_SIZE + MAX_PAYLOAD_SIZE;
+
+bool isKnownRequest(RequestType type) {
+    return type == RequestType::Keys || type == RequestType::Expression
+        || type == RequestType::Reset || type == RequestType::Close;
+}
+
+// 与 CalculatorEngine::evaluateExpression() 相同：先清除，再以表达式的值作为当前值
+void evaluateExpression(ExpressionParser &parser, Expression &expression, EngineCore &core,
+                        const char *text, int length) {
+    core.reset();
+    if (!parser.parse(text, length, expression)) {
+        core.state.error = parser.error();
+        return;
+    }
+    if (expression.variableCount() > 0) {
+        core.state.error = ErrorType::InvalidInput;
+        return;
+    }
+
+    ErrorType error = ErrorType::NoError;
+    const double result = expression.evaluate(error);
+    if (error != ErrorType::NoError) {
+        core.state.error = error;
+        return;
+    }
+    core.loadResult(result);
+}
+
+void appendResponse(std::vector<char> &output, const ResponseHeader &header, const char *text) {
+    const std::size_t offset = output.size();
+    output.resize(offset + RESPONSE_HEADER_SIZE + header.length);
+    writeResponseHeader(reinterpret_cast<uchar*>(&output[offset]), header);
+    if (header.length > 0) {
+        std::memcpy(&output[offset + RESPONSE_HEADER_SIZE], text, header.length);
+    }
+}
+
+} // namespace
+
+/**
+ * @brief 一个客户端连接及其全部会话
+ */
+struct EngineServer::Connection {
+    int fd;
+    bool writing;                   // 输出积压，暂停读取，等待可写
+    std::vector<char> pending;      // 尚不完整的请求帧
+    std::vector<char> output;       // 尚未写出的响应 [outputBegin, size)
+    std::size_t outputBegin;
+    std::unordered_map<quint32, EngineCore> sessions;
+
+    explicit Connection(int socket)
+        : fd(socket)
+        , writing(false)
+        , outputBegin(0) {}
+};
+
+/**
+ * @brief 一个事件循环线程的私有状态
+ */
+struct EngineServer::Worker {
+    int epollFd;
+    std::unique_ptr<char[]> readBuffer;
+    ExpressionParser parser;
+    Expression expression;
+    WorkerReport report;
+
+    // 连接的所有权：接受连接的线程加入，本线程关闭时移除（只在建立与关闭连接时加锁）
+    std::mutex mutex;
+    std::unordered_map<int, std::unique_ptr<Connection>> connections;
+
+    Worker()
+        : epollFd(-1)
+        , readBuffer(new char[READ_BUFFER_SIZE])
+        , report() {}
+};
+
+EngineServer::EngineServer(const ServerOptions &options)
+    : m_options(options)
+    , m_listenFd(-1)
+    , m_stopFd(-1)
+    , m_bound(false)
+    , m_nextWorker(0)
+{
+    for (int i = 0; i < ERROR_TYPE_COUNT; ++i) {
+        m_errorTexts[i] = CalculatorEngine::errorText(static_cast<ErrorType>(i)).toUtf8();
+    }
+}
+
+EngineServer::~EngineServer() {
+    stop();
+}
+
+bool EngineServer::start() {
+    if (isRunning()) {
+        return true;
+    }
+    m_errorString.clear();
+    m_workers.clear();
+
+    const QByteArray path = QFile::encodeName(m_options.socketPath);
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.isEmpty() || path.size() >= static_cast<int>(sizeof(address.sun_path))) {
+        m_errorString = QString("套接字路径为空或过长: %1").arg(m_options.socketPath);
+        return false;
+    }
+    std::memcpy(address.sun_path, path.constData(), path.size());
+
+    // 替换上次运行遗留的套接字文件，其他类型的文件保持不变（bind 会失败）
+    struct stat status;
+    if (::lstat(path.constData(), &status) == 0 && S_ISSOCK(status.st_mode)) {
+        ::unlink(path.constData());
+    }
+
+    m_listenFd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (m_listenFd < 0) {
+        return fail("socket");
+    }
+    if (::bind(m_listenFd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        return fail("bind");
+    }
+    m_bound = true;
+    if (::listen(m_listenFd, SOMAXCONN) != 0) {
+        return fail("listen");
+    }
+    m_stopFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (m_stopFd < 0) {
+        return fail("eventfd");
+    }
+
+    int threads = m_options.threads;
+    if (threads <= 0) {
+        threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+    for (int i = 0; i < threads; ++i) {
+        std::unique_ptr<Worker> worker(new Worker);
+        worker->epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+        m_workers.push_back(std::move(worker));
+        const int epollFd = m_workers.back()->epollFd;
+        if (epollFd < 0) {
+            return fail("epoll_create1");
+        }
+
+        // 事件的 data.ptr 指向监听套接字或停止事件的成员时表示对应事件，否则是连接
+        epoll_event event;
+        event.events = EPOLLIN | EPOLLEXCLUSIVE;
+        event.data.ptr = &m_listenFd;
+        if (::epoll_ctl(epollFd, EPOLL_CTL_ADD, m_listenFd, &event) != 0) {
+            return fail("epoll_ctl");
+        }
+        // 停止事件不读取，置位后一直可读，所有线程都会看到
+        event.events = EPOLLIN;
+        event.data.ptr = &m_stopFd;
+        if (::epoll_ctl(epollFd, EPOLL_CTL_ADD, m_stopFd, &event) != 0) {
+            return fail("epoll_ctl");
+        }
+    }
+
+    m_threads.reserve(m_workers.size());
+    for (std::size_t i = 0; i < m_workers.size(); ++i) {
+        Worker &worker = *m_workers[i];
+        m_threads.emplace_back([this, &worker]() { workerLoop(worker); });
+    }
+    return true;
+}
+
+void EngineServer::stop() {
+    if (m_stopFd >= 0) {
+        const quint64 one = 1;
+        ssize_t written = ::write(m_stopFd, &one, sizeof(one));
+        Q_UNUSED(written);
+    }
+    for (std::thread &thread : m_threads) {
+        thread.join();
+    }
+    m_threads.clear();
+    release();
+}
+
+std::vector<EngineServer::WorkerReport> EngineServer::workerReports() const {
+    std::vector<WorkerReport> reports;
+    reports.reserve(m_workers.size());
+    for (const std::unique_ptr<Worker> &worker : m_workers) {
+        reports.push_back(worker->report);
+    }
+    return reports;
+}
+
+void EngineServer::workerLoop(Worker &worker) {
+    epoll_event events[MAX_EVENTS];
+    bool running = true;
+    while (running) {
+        const int count = ::epoll_wait(worker.epollFd, events, MAX_EVENTS, -1);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+
+        for (int i = 0; i < count; ++i) {
+            void *source = events[i].data.ptr;
+            if (source == &m_stopFd) {
+                running = false;
+                break;
+            }
+            if (source == &m_listenFd) {
+                acceptConnections();
+                continue;
+            }
+
+            // 同一次 epoll_wait 中每个连接最多出现一次，关闭当前连接不影响后面的事件
+            Connection &connection = *static_cast<Connection*>(source);
+            bool open;
+            if (connection.writing) {
+                open = !(events[i].events & (EPOLLERR | EPOLLHUP)) && flushConnection(worker, connection);
+            } else {
+                open = readConnection(worker, connection);
+            }
+            if (!open) {
+                closeConnection(worker, connection.fd);
+            }
+        }
+    }
+}
+
+void EngineServer::acceptConnections() {
+    for (;;) {
+        const int fd = ::accept4(m_listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            return;     // 已全部接受，或暂时无法接受
+        }
+
+        // 先登记再注册事件，目标线程处理事件时连接已在它的表中
+        Worker &target = *m_workers[m_nextWorker.fetch_add(1, std::memory_order_relaxed) % m_workers.size()];
+        std::unique_ptr<Connection> connection(new Connection(fd));
+        epoll_event event;
+        event.events = EPOLLIN;
+        event.data.ptr = connection.get();
+        {
+            std::lock_guard<std::mutex> lock(target.mutex);
+            target.connections.emplace(fd, std::move(connection));
+            ++target.report.connections;
+        }
+
+        if (::epoll_ctl(target.epollFd, EPOLL_CTL_ADD, fd, &event) != 0) {
+            closeConnection(target, fd);
+        }
+    }
+}
+
+bool EngineServer::readConnection(Worker &worker, Connection &connection) {
+    // 上次剩下的不完整帧放在读缓冲头部，新数据接在后面
+    char *buffer = worker.readBuffer.get();
+    const int pending = static_cast<int>(connection.pending.size());
+    if (pending > 0) {
+        std::memcpy(buffer, connection.pending.data(), pending);
+    }
+
+    const ssize_t received = ::read(connection.fd, buffer + pending, READ_CHUNK);
+    if (received <= 0) {
+        // 0 为对端关闭；EAGAIN 只是虚假唤醒
+        return received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR);
+    }
+    worker.report.bytesIn += received;
+
+    const int end = pending + static_cast<int>(received);
+    int offset = 0;
+    while (end - offset >= REQUEST_HEADER_SIZE) {
+        const RequestHeader request = readRequestHeader(reinterpret_cast<const uchar*>(buffer + offset));
+        const int frameSize = REQUEST_HEADER_SIZE + request.length;
+        if (end - offset < frameSize) {
+            break;
+        }
+        handleRequest(worker, connection, request, buffer + offset + REQUEST_HEADER_SIZE);
+        offset += frameSize;
+        ++worker.report.requests;
+    }
+    connection.pending.assign(buffer + offset, buffer + end);
+
+    return flushConnection(worker, connection);
+}
+
+void EngineServer::handleRequest(Worker &worker, Connection &connection,
+                                 const RequestHeader &request, const char *payload) {
+    ResponseHeader response;
+    response.tag = request.tag;
+    response.status = ResponseStatus::Ok;
+    response.error = 0;
+    response.length = 0;
+
+    if (!isKnownRequest(request.type)) {
+        response.status = ResponseStatus::BadRequest;
+        appendResponse(connection.output, response, nullptr);
+        return;
+    }
+    if (request.type == RequestType::Close) {
+        connection.sessions.erase(request.session);
+        appendResponse(connection.output, response, nullptr);
+        return;
+    }
+
+    auto session = connection.sessions.find(request.session);
+    if (session == connection.sessions.end()) {
+        if (static_cast<int>(connection.sessions.size()) >= m_options.maxSessions) {
+            response.status = ResponseStatus::SessionLimit;
+            appendResponse(connection.output, response, nullptr);
+            return;
+        }
+        session = connection.sessions.emplace(request.session, EngineCore()).first;
+    }
+    EngineCore &core = session->second;
+
+    switch (request.type) {
+    case RequestType::Keys:
+        for (int i = 0; i < request.length; ++i) {
+            applyKeystroke(core, payload[i]);
+        }
+        break;
+    case RequestType::Expression:
+        evaluateExpression(worker.parser, worker.expression, core, payload, request.length);
+        break;
+    default:
+        core.clearAll();
+        break;
+    }
+
+    char text[NumberFormatter::BUFFER_SIZE];
+    const char *display = text;
+    if (core.hasError()) {
+        const QByteArray &errorText = m_errorTexts[static_cast<int>(core.state.error)];
+        display = errorText.constData();
+        response.length = static_cast<quint16>(errorText.size());
+    } else {
+        response.length = static_cast<quint16>(core.displayText(text));
+    }
+    response.error = static_cast<quint8>(core.state.error);
+    appendResponse(connection.output, response, display);
+}
+
+bool EngineServer::flushConnection(Worker &worker, Connection &connection) {
+    std::vector<char> &output = connection.output;
+    while (connection.outputBegin < output.size()) {
+        const ssize_t written = ::send(connection.fd, output.data() + connection.outputBegin,
+                                       output.size() - connection.outputBegin, MSG_NOSIGNAL);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                return false;
+            }
+            break;
+        }
+        connection.outputBegin += static_cast<std::size_t>(written);
+        worker.report.bytesOut += written;
+    }
+
+    const bool drained = connection.outputBegin == output.size();
+    if (drained) {
+        output.clear();     // 保留容量，下一批响应不再分配
+        connection.outputBegin = 0;
+    }
+
+    // 有积压时只关注可写，写完后恢复读取
+    if (drained == connection.writing) {
+        epoll_event event;
+        event.events = drained ? EPOLLIN : EPOLLOUT;
+        event.data.ptr = &connection;
+        if (::epoll_ctl(worker.epollFd, EPOLL_CTL_MOD, connection.fd, &event) != 0) {
+            return false;
+        }
+        connection.writing = !drained;
+    }
+    return true;
+}
+
+void EngineServer::closeConnection(Worker &worker, int fd) {
+    ::epoll_ctl(worker.epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    {
+        // 移除后才关闭描述符，避免其他线程接受的新连接复用同一编号时被误删
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.connections.erase(fd);
+    }
+    ::close(fd);
+}
+
+bool EngineServer::fail(const char *what) {
+    m_errorString = QString("%1: %2").arg(what).arg(QString::fromLocal8Bit(std::strerror(errno)));
+    release();
+    return false;
+}
+
+void EngineServer::release() {
+    for (const std::unique_ptr<Worker> &worker : m_workers) {
+        for (auto &entry : worker->connections) {
+            ::close(entry.first);
+        }
+        worker->connections.clear();
+        if (worker->epollFd >= 0) {
+            ::close(worker->epollFd);
+            worker->epollFd = -1;
+        }
+    }
+    if (m_stopFd >= 0) {
+        ::close(m_stopFd);
+        m_stopFd = -1;
+    }
+    if (m_listenFd >= 0) {
+        ::close(m_listenFd);
+        m_listenFd = -1;
+    }
+    if (m_bound) {
+        ::unlink(QFile::encodeName(m_options.socketPath).constData());
+        m_bound = false;
+    }
+}
+
+} // namespace Calculator
@@ -5,6 +5,7 @@
 
 #include "../../inc/ui/DisplayPanel.h"
 #include "../../inc/utils/Constants.h"
+#include "../../inc/utils/TraceRecorder.h"
 #include <QApplication>
 #include <QKeyEvent>
 #include <QPainter>
@@ -14,6 +15,7 @@ namespace Calculator {
 DisplayPanel::DisplayPanel(QWidget *parent)
     : QLineEdit(parent)
     , m_errorState(false)
+    , m_theme(nullptr)
 {
     setObjectName("displayPanel");
     setReadOnly(true);
@@ -26,25 +28,46 @@ DisplayPanel::DisplayPanel(QWidget *parent)
     font.setWeight(QFont::Medium);
     setFont(font);
     
-    // 设置样式
-    setStyleSheet("border: none; background: transparent;");
+    // 边框与背景在 paintEvent 中绘制，不使用样式表
+    setFrame(false);
 }
 
 void DisplayPanel::setErrorState(bool error) {
     if (m_errorState != error) {
         m_errorState = error;
+        updateTextColor();
+        update();
+        emit errorStateChanged(error);
+    }
+}
+
+void DisplayPanel::setTheme(const ThemeData *theme) {
+    m_theme = theme;
+    if (m_theme) {
+        QFont font = this->font();
+        font.setPixelSize(m_theme->panelFontPixelSize);
+        setFont(font);
 
+        // 背景（可能是渐变）由 paintEvent 绘制，QLineEdit 自身只绘制文字
         QPalette palette = this->palette();
-        if (error) {
-            palette.setColor(QPalette::Text, QColor("#e74c3c"));  // 红色文本
-        } else {
-            palette.setColor(QPalette::Text, QApplication::palette().color(QPalette::Text));  // 默认文本
-        }
+        palette.setColor(QPalette::Base, Qt::transparent);
         setPalette(palette);
+    }
+    updateTextColor();
+    update();
+}
 
-        update();
-        emit errorStateChanged(error);
+void DisplayPanel::updateTextColor() {
+    const QPalette base = QApplication::palette();
+    QColor color;
+    if (m_errorState) {
+        color = m_theme ? Theme::color(m_theme->panelErrorText, base) : QColor("#e74c3c");  // 红色文本
+    } else {
+        color = m_theme ? Theme::color(m_theme->panel.text, base) : base.color(QPalette::Text);  // 默认文本
     }
+    QPalette palette = this->palette();
+    palette.setColor(QPalette::Text, color);
+    setPalette(palette);
 }
 
 void DisplayPanel::updateDisplay(const QString &text) {
@@ -58,13 +81,42 @@ void DisplayPanel::clearDisplay() {
 }
 
 void DisplayPanel::paintEvent(QPaintEvent *event) {
+    // 绘制完成后（包括提前返回）结束此前到达的输入的延迟区间
+    struct InputLatencyEnd {
+        ~InputLatencyEnd() { TraceRecorder::instance().endInputs(); }
+    } inputLatencyEnd;
+    CALCULATOR_TRACE_SCOPE("paint", "DisplayPanel::paintEvent");
+
+    QRect rect = this->rect();
+    
+    if (m_theme) {
+        const QPalette base = QApplication::palette();
+        QRect frame = rect.adjusted(1, 1, -1, -1);
+        {
+            QPainter background(this);
+            background.setRenderHint(QPainter::Antialiasing);
+            background.setPen(Qt::NoPen);
+            background.setBrush(Theme::brush(m_theme->panel.background, base, frame));
+            background.drawRoundedRect(frame, m_theme->panelRadius, m_theme->panelRadius);
+        }
+        QLineEdit::paintEvent(event);
+        
+        const ThemeColor &border = m_errorState ? m_theme->panelErrorText
+                                 : hasFocus() ? m_theme->panelFocusBorder : m_theme->panel.border;
+        QPainter painter(this);
+        painter.setRenderHint(QPainter::Antialiasing);
+        painter.setPen(QPen(Theme::color(border, base), 2));
+        painter.setBrush(Qt::NoBrush);
+        painter.drawRoundedRect(frame, m_theme->panelRadius, m_theme->panelRadius);
+        return;
+    }
+    
     QLineEdit::paintEvent(event);
     
     QPainter painter(this);
     painter.setRenderHint(QPainter::Antialiasing);
     
     // 绘制自定义边框
-    QRect rect = this->rect();
     QPen pen;
     
     if (m_errorState) {
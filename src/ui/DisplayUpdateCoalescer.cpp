@@ -0,0 +1,66 @@
+/**
+ * @file DisplayUpdateCoalescer.cpp
+ * @brief 显示刷新合并器实现
+ */
+
+#include "../../inc/ui/DisplayUpdateCoalescer.h"
+#include "../../inc/core/CalculatorEngine.h"
+#include "../../inc/ui/DisplayPanel.h"
+#include "../../inc/utils/TraceRecorder.h"
+
+namespace Calculator {
+
+DisplayUpdateCoalescer::DisplayUpdateCoalescer(CalculatorEngine *engine, DisplayPanel *panel,
+                                               QObject *parent)
+    : QObject(parent)
+    , m_engine(engine)
+    , m_panel(panel)
+    , m_dirty(false)
+{
+    m_flushTimer.setSingleShot(true);
+    m_flushTimer.setInterval(0);
+    connect(&m_flushTimer, &QTimer::timeout, this, &DisplayUpdateCoalescer::flush);
+
+    // 引擎的各类通知都只标记失效，文本在刷新时才格式化
+    connect(m_engine, &CalculatorEngine::displayInvalidated,
+            this, &DisplayUpdateCoalescer::markDirty);
+    connect(m_engine, &CalculatorEngine::stateUpdated,
+            this, &DisplayUpdateCoalescer::markDirty);
+    connect(m_engine, &CalculatorEngine::errorOccurred,
+            this, &DisplayUpdateCoalescer::markDirty);
+}
+
+void DisplayUpdateCoalescer::markDirty() {
+    m_dirty = true;
+    if (!m_flushTimer.isActive()) {
+        m_flushTimer.start();
+    }
+}
+
+void DisplayUpdateCoalescer::flush() {
+    if (!m_dirty) {
+        return;
+    }
+    CALCULATOR_TRACE_SCOPE("ui", "DisplayUpdateCoalescer::flush");
+    m_dirty = false;
+    m_flushTimer.stop();
+
+    // 文本未变化时不调用 setText，避免无效的重绘
+    const QString text = m_engine->getDisplayText();
+    const bool error = m_engine->hasError();
+    const bool textChanged = text != m_panel->text();
+    const bool repaint = textChanged || error != m_panel->errorState();
+    if (textChanged) {
+        m_panel->setText(text);
+    }
+    m_panel->setErrorState(error);
+
+    // 不重绘时面板的 paintEvent 不会结束输入区间，在此以刷新时刻结束
+    if (repaint) {
+        TraceRecorder::instance().markPaintPending();
+    } else {
+        TraceRecorder::instance().endIdleInputs();
+    }
+}
+
+} // namespace Calculator
@@ -0,0 +1,151 @@
+/**
+ * @file HistoryListModel.cpp
+ * @brief 计算历史列表模型实现
+ */
+
+#include "../../inc/ui/HistoryListModel.h"
+#include "../../inc/core/CalculatorEngine.h"
+#include "../../inc/utils/NumberFormatter.h"
+#include <QDateTime>
+#include <cstring>
+
+namespace Calculator {
+
+namespace {
+
+const char *operatorSymbol(Operator op) {
+    switch (op) {
+    case Operator::Add:      return " + ";
+    case Operator::Subtract: return " - ";
+    case Operator::Multiply: return " × ";
+    case Operator::Divide:   return " ÷ ";
+    default:                 return " ? ";
+    }
+}
+
+} // namespace
+
+HistoryListModel::HistoryListModel(const HistoryLog *log, QObject *parent)
+    : QAbstractListModel(parent)
+    , m_log(log)
+    , m_total(log->count())
+    , m_loaded(0)
+    , m_filtered(false)
+{
+}
+
+int HistoryListModel::rowCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : m_loaded;
+}
+
+QVariant HistoryListModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid() || index.row() >= m_loaded || recordIndex(index.row()) >= m_log->count()) {
+        return QVariant();
+    }
+
+    switch (role) {
+    case Qt::DisplayRole:
+        return formatRecord(m_log->at(recordIndex(index.row())));
+    case Qt::ToolTipRole:
+        return QDateTime::fromMSecsSinceEpoch(m_log->at(recordIndex(index.row())).timestamp)
+            .toString("yyyy-MM-dd hh:mm:ss");
+    case Qt::TextAlignmentRole:
+        return int(Qt::AlignRight | Qt::AlignVCenter);
+    default:
+        return QVariant();
+    }
+}
+
+bool HistoryListModel::canFetchMore(const QModelIndex &parent) const {
+    const quint64 available = m_filtered ? static_cast<quint64>(m_filter.size()) : m_total;
+    return !parent.isValid() && static_cast<quint64>(m_loaded) < available;
+}
+
+void HistoryListModel::fetchMore(const QModelIndex &parent) {
+    if (parent.isValid()) {
+        return;
+    }
+    const quint64 available = m_filtered ? static_cast<quint64>(m_filter.size()) : m_total;
+    const quint64 remaining = available - m_loaded;
+    const int batch = static_cast<int>(qMin<quint64>(remaining, FETCH_BATCH));
+    if (batch <= 0) {
+        return;
+    }
+    beginInsertRows(QModelIndex(), m_loaded, m_loaded + batch - 1);
+    m_loaded += batch;
+    endInsertRows();
+}
+
+void HistoryListModel::setFilter(const QVector<quint64> &records) {
+    beginResetModel();
+    m_filter = records;
+    m_filtered = true;
+    m_loaded = 0;
+    endResetModel();
+}
+
+void HistoryListModel::clearFilter() {
+    if (!m_filtered) {
+        return;
+    }
+    beginResetModel();
+    m_filter.clear();
+    m_filtered = false;
+    m_total = m_log->count();
+    m_loaded = 0;
+    endResetModel();
+}
+
+void HistoryListModel::refresh() {
+    if (m_filtered) {
+        // 过滤结果由调用方重新检索后更新
+        return;
+    }
+    const quint64 count = m_log->count();
+    if (count < m_total) {
+        // 日志被清空
+        beginResetModel();
+        m_total = count;
+        m_loaded = 0;
+        endResetModel();
+        return;
+    }
+    if (count == m_total) {
+        return;
+    }
+
+    const int added = static_cast<int>(qMin<quint64>(count - m_total, FETCH_BATCH));
+    if (count - m_total > static_cast<quint64>(added)) {
+        // 一次新增过多时重新分批加载
+        beginResetModel();
+        m_total = count;
+        m_loaded = 0;
+        endResetModel();
+        return;
+    }
+    beginInsertRows(QModelIndex(), 0, added - 1);
+    m_total = count;
+    m_loaded += added;
+    endInsertRows();
+}
+
+QString HistoryListModel::formatRecord(const HistoryRecord &record) {
+    // 在栈上拼接，最后只构造一次 QString
+    char text[NumberFormatter::BUFFER_SIZE * 3 + 16];
+    int length = NumberFormatter::format(record.leftOperand, text);
+    const char *symbol = operatorSymbol(record.operatorType());
+    const int symbolLength = static_cast<int>(std::strlen(symbol));
+    std::memcpy(text + length, symbol, symbolLength);
+    length += symbolLength;
+    length += NumberFormatter::format(record.rightOperand, text + length);
+    std::memcpy(text + length, " = ", 3);
+    length += 3;
+
+    if (record.errorType() != ErrorType::NoError) {
+        return QString::fromUtf8(text, length) + CalculatorEngine::errorText(record.errorType());
+    }
+    length += NumberFormatter::format(record.result, text + length);
+    return QString::fromUtf8(text, length);
+}
+
+} // namespace Calculator
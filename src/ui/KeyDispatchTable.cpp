@@ -0,0 +1,254 @@
+/**
+ * @file KeyDispatchTable.cpp
+ * @brief 键盘按键到命令的分发表实现
+ */
+
+#include "../../inc/ui/KeyDispatchTable.h"
+#include <QStringList>
+#include <cstring>
+
+namespace Calculator {
+
+namespace {
+
+// 没有对应按钮的命令名，按 Command 的顺序排列
+const char *const EXTRA_COMMAND_NAMES[] = {
+    "changeSign",
+    "toggleTheme"
+};
+
+} // namespace
+
+KeyDispatchTable::KeyDispatchTable()
+    : m_pendingLayer(0)
+{
+    loadDefaults();
+}
+
+void KeyDispatchTable::clear() {
+    m_layers.assign(1, Layer());
+    std::memset(&m_layers[0], NO_COMMAND, sizeof(Layer));
+    m_pendingLayer = 0;
+}
+
+void KeyDispatchTable::loadDefaults() {
+    clear();
+    for (int id = 0; id < BUTTON_COUNT; ++id) {
+        bind(QKeySequence(BUTTON_TABLE[id].key), id);
+    }
+
+    // 附加键位：与按钮表中的默认键位等价的其他按键
+    bind(QKeySequence(Qt::Key_Return), commandId("equals"));
+    bind(QKeySequence(Qt::Key_Enter), commandId("equals"));
+    bind(QKeySequence(Qt::Key_Comma), commandId("decimal"));
+    bind(QKeySequence(Qt::Key_F9), ChangeSign);
+    bind(QKeySequence(Qt::CTRL + Qt::Key_T), ToggleTheme);
+}
+
+int KeyDispatchTable::applyOverrides(const QMap<QString, QString> &bindings) {
+    int failures = 0;
+    for (auto it = bindings.constBegin(); it != bindings.constEnd(); ++it) {
+        const int command = commandId(it.key());
+        if (command == NO_COMMAND) {
+            ++failures;
+            continue;
+        }
+        unbindCommand(command);
+        const QList<QKeySequence> sequences =
+            QKeySequence::listFromString(it.value(), QKeySequence::PortableText);
+        for (const QKeySequence &sequence : sequences) {
+            if (!sequence.isEmpty() && !bind(sequence, command)) {
+                ++failures;
+            }
+        }
+    }
+    return failures;
+}
+
+bool KeyDispatchTable::bind(const QKeySequence &sequence, int command) {
+    if (command < 0 || command >= COMMAND_COUNT || sequence.isEmpty() || sequence.count() > 2) {
+        return false;
+    }
+
+    const int first = sequence[0];
+    qint8 *slot = entry(0, first & ~Qt::KeyboardModifierMask,
+                        Qt::KeyboardModifiers(first & Qt::KeyboardModifierMask));
+    if (!slot) {
+        return false;
+    }
+
+    if (sequence.count() == 1) {
+        // 单键不能覆盖和弦前缀
+        if (*slot >= PREFIX_BASE) {
+            return false;
+        }
+        *slot = static_cast<qint8>(command);
+        return true;
+    }
+
+    // 两段和弦：第一段为前缀，不能与单键绑定冲突
+    if (*slot != NO_COMMAND && *slot < PREFIX_BASE) {
+        return false;
+    }
+    // 先检查第二段，避免留下没有任何键位的前缀
+    const int second = sequence[1];
+    const int secondKey = second & ~Qt::KeyboardModifierMask;
+    if (!isTableKey(secondKey)) {
+        return false;
+    }
+    int layer;
+    if (*slot == NO_COMMAND) {
+        layer = freeLayer();
+        if (layer > MAX_CHORD_PREFIXES) {
+            return false;
+        }
+        *slot = static_cast<qint8>(PREFIX_BASE + layer - 1);
+        if (layer == static_cast<int>(m_layers.size())) {
+            // push_back 之后 slot 可能失效，不再使用
+            m_layers.push_back(Layer());
+            std::memset(&m_layers.back(), NO_COMMAND, sizeof(Layer));
+        }
+    } else {
+        layer = *slot - PREFIX_BASE + 1;
+    }
+
+    *entry(layer, secondKey, Qt::KeyboardModifiers(second & Qt::KeyboardModifierMask)) =
+        static_cast<qint8>(command);
+    return true;
+}
+
+void KeyDispatchTable::unbindCommand(int command) {
+    for (Layer &layer : m_layers) {
+        for (int slot = 0; slot < MODIFIER_SLOTS; ++slot) {
+            for (int i = 0; i < PRINTABLE_KEYS; ++i) {
+                if (layer.printable[slot][i] == command) {
+                    layer.printable[slot][i] = NO_COMMAND;
+                }
+            }
+            for (int i = 0; i < SPECIAL_KEYS; ++i) {
+                if (layer.special[slot][i] == command) {
+                    layer.special[slot][i] = NO_COMMAND;
+                }
+            }
+        }
+    }
+    releaseEmptyPrefixes();
+}
+
+int KeyDispatchTable::dispatch(int key, Qt::KeyboardModifiers modifiers) {
+    // 单独按下的修饰键不影响进行中的和弦
+    if (isModifierKey(key)) {
+        return NO_COMMAND;
+    }
+
+    const int layer = m_pendingLayer;
+    m_pendingLayer = 0;
+    const qint8 *slot = entry(layer, key, modifiers);
+    if (!slot || *slot == NO_COMMAND) {
+        return NO_COMMAND;
+    }
+    if (*slot >= PREFIX_BASE) {
+        m_pendingLayer = *slot - PREFIX_BASE + 1;
+        return CHORD_PENDING;
+    }
+    return *slot;
+}
+
+int KeyDispatchTable::commandId(const QString &name) {
+    for (int id = 0; id < BUTTON_COUNT; ++id) {
+        if (name == QLatin1String(BUTTON_TABLE[id].name)) {
+            return id;
+        }
+    }
+    for (int i = BUTTON_COUNT; i < COMMAND_COUNT; ++i) {
+        if (name == QLatin1String(EXTRA_COMMAND_NAMES[i - BUTTON_COUNT])) {
+            return i;
+        }
+    }
+    return NO_COMMAND;
+}
+
+const char *KeyDispatchTable::commandName(int command) {
+    if (command >= 0 && command < BUTTON_COUNT) {
+        return BUTTON_TABLE[command].name;
+    }
+    if (command >= BUTTON_COUNT && command < COMMAND_COUNT) {
+        return EXTRA_COMMAND_NAMES[command - BUTTON_COUNT];
+    }
+    return nullptr;
+}
+
+qint8 *KeyDispatchTable::entry(int layer, int key, Qt::KeyboardModifiers modifiers) {
+    const int slot = modifierSlot(modifiers);
+    if (key >= 0 && key < PRINTABLE_KEYS) {
+        return &m_layers[layer].printable[slot][key];
+    }
+    if (key >= SPECIAL_KEY_BASE && key < SPECIAL_KEY_BASE + SPECIAL_KEYS) {
+        return &m_layers[layer].special[slot][key - SPECIAL_KEY_BASE];
+    }
+    return nullptr;
+}
+
+bool KeyDispatchTable::isTableKey(int key) {
+    return (key >= 0 && key < PRINTABLE_KEYS)
+        || (key >= SPECIAL_KEY_BASE && key < SPECIAL_KEY_BASE + SPECIAL_KEYS);
+}
+
+bool KeyDispatchTable::isEmptyLayer(int layer) const {
+    const qint8 *begin = reinterpret_cast<const qint8*>(&m_layers[layer]);
+    const qint8 *end = begin + sizeof(Layer);
+    for (const qint8 *p = begin; p != end; ++p) {
+        if (*p != NO_COMMAND) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int KeyDispatchTable::freeLayer() const {
+    // 没有前缀指向的层都已被清空（见 releaseEmptyPrefixes），可以直接复用
+    const int count = static_cast<int>(m_layers.size());
+    for (int layer = 1; layer < count; ++layer) {
+        if (isEmptyLayer(layer)) {
+            return layer;
+        }
+    }
+    return count;
+}
+
+void KeyDispatchTable::releaseEmptyPrefixes() {
+    Layer &root = m_layers[0];
+    qint8 *begin = reinterpret_cast<qint8*>(&root);
+    qint8 *end = begin + sizeof(Layer);
+    for (qint8 *p = begin; p != end; ++p) {
+        if (*p >= PREFIX_BASE && isEmptyLayer(*p - PREFIX_BASE + 1)) {
+            if (m_pendingLayer == *p - PREFIX_BASE + 1) {
+                m_pendingLayer = 0;
+            }
+            *p = NO_COMMAND;
+        }
+    }
+}
+
+int KeyDispatchTable::modifierSlot(Qt::KeyboardModifiers modifiers) {
+    return ((modifiers & Qt::ControlModifier) ? 1 : 0)
+         | ((modifiers & Qt::AltModifier) ? 2 : 0)
+         | ((modifiers & Qt::MetaModifier) ? 4 : 0);
+}
+
+bool KeyDispatchTable::isModifierKey(int key) {
+    switch (key) {
+    case Qt::Key_Shift:
+    case Qt::Key_Control:
+    case Qt::Key_Meta:
+    case Qt::Key_Alt:
+    case Qt::Key_AltGr:
+    case Qt::Key_CapsLock:
+    case Qt::Key_NumLock:
+        return true;
+    default:
+        return false;
+    }
+}
+
+} // namespace Calculator
@@ -5,14 +5,21 @@
 
 
 #include "../../inc/ui/MainWindow.h"
+#include "../../inc/utils/Constants.h"
 #include "../../inc/utils/SettingsManager.h"
+#include "../../inc/utils/StartupProfiler.h"
+#include "../../inc/utils/TraceRecorder.h"
 #include <QApplication>
 #include <QGridLayout>
+#include <QHBoxLayout>
 #include <QVBoxLayout>
 #include <QKeyEvent>
-#include <QFile>
 #include <QDebug>
 #include <QCloseEvent>
+#include <QDateTime>
+#include <QDir>
+#include <QStandardPaths>
+#include <QTimer>
 
 namespace Calculator {
 
@@ -21,25 +28,49 @@ MainWindow::MainWindow(QWidget *parent)
     , m_centralWidget(nullptr)
     , m_displayPanel(nullptr)
     , m_engine(new CalculatorEngine(this))
+    , m_displayUpdater(nullptr)
+    , m_historySearch(nullptr)
+    , m_historyView(nullptr)
+    , m_historyModel(nullptr)
+    , m_deferredInitScheduled(false)
+    , m_buttons()
+    , m_historyIndex(&m_history)
 {
+    StartupProfiler &profiler = StartupProfiler::instance();
     setupUI();
+    profiler.mark("MainWindow::setupUI");
     setupConnections();
-    loadStyleSheet();
+    profiler.mark("MainWindow::setupConnections");
+    loadTheme();
+    profiler.mark("MainWindow::loadTheme");
     restoreWindowState();
+    profiler.mark("MainWindow::restoreWindowState");
 
     setWindowTitle("计算器");
+
+    // 显示面板第一次绘制后再执行非必要的初始化
+    m_displayPanel->installEventFilter(this);
 }
 
-MainWindow::~MainWindow() {}
+MainWindow::~MainWindow() {
+    // 模型与引擎引用 m_history，须在其关闭之前断开
+    m_engine->setHistoryLog(nullptr);
+    delete m_historyModel;
+}
 
 void MainWindow::setupUI() {
     m_centralWidget = new QWidget(this);
     m_centralWidget->setObjectName("centralWidget");
     setCentralWidget(m_centralWidget);
 
-    QVBoxLayout *mainLayout = new QVBoxLayout(m_centralWidget);
+    // 左侧为计算器，右侧为历史列表
+    QHBoxLayout *rootLayout = new QHBoxLayout(m_centralWidget);
+    rootLayout->setSpacing(8);
+    rootLayout->setContentsMargins(8, 8, 8, 8);
+
+    QVBoxLayout *mainLayout = new QVBoxLayout();
     mainLayout->setSpacing(8);
-    mainLayout->setContentsMargins(8, 8, 8, 8);
+    rootLayout->addLayout(mainLayout, 1);
 
     // 显示面板
     m_displayPanel = new DisplayPanel();
@@ -60,218 +91,95 @@ void MainWindow::setupUI() {
     QGridLayout *gridLayout = new QGridLayout();
     gridLayout->setSpacing(4);
 
-    // 第一行：功能按钮
-    m_buttons["CE"] = new QPushButton("CE");
-    m_buttons["C"] = new QPushButton("C");
-    m_buttons["backspace"] = new QPushButton("⌫");
-    m_buttons["divide"] = new QPushButton("÷");
-    gridLayout->addWidget(m_buttons["CE"], 0, 0);
-    gridLayout->addWidget(m_buttons["C"], 0, 1);
-    gridLayout->addWidget(m_buttons["backspace"], 0, 2);
-    gridLayout->addWidget(m_buttons["divide"], 0, 3);
-
-    // 第二行：数字7-9和乘号
-    m_buttons["7"] = new QPushButton("7");
-    m_buttons["8"] = new QPushButton("8");
-    m_buttons["9"] = new QPushButton("9");
-    m_buttons["multiply"] = new QPushButton("×");
-    gridLayout->addWidget(m_buttons["7"], 1, 0);
-    gridLayout->addWidget(m_buttons["8"], 1, 1);
-    gridLayout->addWidget(m_buttons["9"], 1, 2);
-    gridLayout->addWidget(m_buttons["multiply"], 1, 3);
-
-    // 第三行：数字4-6和减号
-    m_buttons["4"] = new QPushButton("4");
-    m_buttons["5"] = new QPushButton("5");
-    m_buttons["6"] = new QPushButton("6");
-    m_buttons["subtract"] = new QPushButton("-");
-    gridLayout->addWidget(m_buttons["4"], 2, 0);
-    gridLayout->addWidget(m_buttons["5"], 2, 1);
-    gridLayout->addWidget(m_buttons["6"], 2, 2);
-    gridLayout->addWidget(m_buttons["subtract"], 2, 3);
-
-    // 第四行：数字1-3和加号
-    m_buttons["1"] = new QPushButton("1");
-    m_buttons["2"] = new QPushButton("2");
-    m_buttons["3"] = new QPushButton("3");
-    m_buttons["add"] = new QPushButton("+");
-    gridLayout->addWidget(m_buttons["1"], 3, 0);
-    gridLayout->addWidget(m_buttons["2"], 3, 1);
-    gridLayout->addWidget(m_buttons["3"], 3, 2);
-    gridLayout->addWidget(m_buttons["add"], 3, 3);
-
-    // 第五行：数字0、小数点、等号
-    m_buttons["0"] = new QPushButton("0");
-    m_buttons["decimal"] = new QPushButton(".");
-    m_buttons["equals"] = new QPushButton("=");
-    gridLayout->addWidget(m_buttons["0"], 4, 0, 1, 2); // 跨2列
-    gridLayout->addWidget(m_buttons["decimal"], 4, 2);
-    gridLayout->addWidget(m_buttons["equals"], 4, 3);
+    // 按钮由描述表生成，按钮 id 即表中的下标
+    for (int id = 0; id < BUTTON_COUNT; ++id) {
+        const ButtonDescriptor &descriptor = BUTTON_TABLE[id];
+        NumPadButton *button = new NumPadButton(QString::fromUtf8(descriptor.label));
+        button->setButtonType(descriptor.type);
+        button->setShortcutKey(descriptor.key);
+        button->setMinimumSize(60, 48);
+        gridLayout->addWidget(button, descriptor.row, descriptor.column, 1, descriptor.columnSpan);
+        m_buttons[id] = button;
+    }
 
     mainLayout->addLayout(gridLayout);
 
-    // 设置按钮样式
-    setupButtonStyles();
-}
-
-void MainWindow::setupButtonStyles() {
-    // 为不同类型的按钮设置不同的样式
-    for (auto it = m_buttons.begin(); it != m_buttons.end(); ++it) {
-        QPushButton *button = it.value();
-        QString key = it.key();
-
-        if (key >= "0" && key <= "9") {
-            // 数字按钮
-            button->setStyleSheet(
-                "QPushButton {"
-                "    background-color: #f8f9fa;"
-                "    border: 1px solid #dee2e6;"
-                "    border-radius: 4px;"
-                "    font-size: 16px;"
-                "    font-weight: 500;"
-                "}"
-                "QPushButton:hover {"
-                "    background-color: #e9ecef;"
-                "}"
-                "QPushButton:pressed {"
-                "    background-color: #dee2e6;"
-                "}"
-            );
-        } else if (key == "add" || key == "subtract" || key == "multiply" || key == "divide") {
-            // 运算符按钮
-            button->setStyleSheet(
-                "QPushButton {"
-                "    background-color: #007bff;"
-                "    border: 1px solid #007bff;"
-                "    border-radius: 4px;"
-                "    color: white;"
-                "    font-size: 16px;"
-                "    font-weight: 600;"
-                "}"
-                "QPushButton:hover {"
-                "    background-color: #0056b3;"
-                "}"
-                "QPushButton:pressed {"
-                "    background-color: #004085;"
-                "}"
-            );
-        } else if (key == "equals") {
-            // 等号按钮
-            button->setStyleSheet(
-                "QPushButton {"
-                "    background-color: #28a745;"
-                "    border: 1px solid #28a745;"
-                "    border-radius: 4px;"
-                "    color: white;"
-                "    font-size: 16px;"
-                "    font-weight: 600;"
-                "}"
-                "QPushButton:hover {"
-                "    background-color: #218838;"
-                "}"
-                "QPushButton:pressed {"
-                "    background-color: #1e7e34;"
-                "}"
-            );
-        } else {
-            // 功能按钮
-            button->setStyleSheet(
-                "QPushButton {"
-                "    background-color: #6c757d;"
-                "    border: 1px solid #6c757d;"
-                "    border-radius: 4px;"
-                "    color: white;"
-                "    font-size: 14px;"
-                "    font-weight: 500;"
-                "}"
-                "QPushButton:hover {"
-                "    background-color: #5a6268;"
-                "}"
-                "QPushButton:pressed {"
-                "    background-color: #545b62;"
-                "}"
-            );
-        }
-
-        // 设置按钮大小
-        button->setMinimumSize(60, 48);
-    }
+    // 历史列表：上方为搜索框；行高一致，视图只为可见行取数据
+    QVBoxLayout *historyLayout = new QVBoxLayout();
+    historyLayout->setSpacing(4);
+    rootLayout->addLayout(historyLayout);
+
+    m_historySearch = new QLineEdit();
+    m_historySearch->setObjectName("historySearch");
+    m_historySearch->setPlaceholderText("搜索：4200、~4200、100..200、10:30");
+    m_historySearch->setClearButtonEnabled(true);
+    m_historySearch->setFocusPolicy(Qt::ClickFocus);
+    m_historySearch->setEnabled(false);
+    historyLayout->addWidget(m_historySearch);
+
+    m_historyView = new QListView();
+    m_historyView->setObjectName("historyView");
+    m_historyView->setUniformItemSizes(true);
+    m_historyView->setSelectionMode(QAbstractItemView::SingleSelection);
+    m_historyView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_historyView->setFocusPolicy(Qt::NoFocus);
+    m_historyView->setMinimumWidth(160);
+    historyLayout->addWidget(m_historyView);
 }
 
 void MainWindow::setupConnections() {
-    // 连接计算引擎
-    connect(m_engine, &CalculatorEngine::displayChanged,
-            m_displayPanel, &QLineEdit::setText);
-    connect(m_engine, &CalculatorEngine::errorOccurred,
-            this, &MainWindow::onErrorOccurred);
-    
-    connect(m_engine, &CalculatorEngine::stateUpdated,
-            this, &MainWindow::onEngineStateUpdated);
+    // 连接计算引擎：显示文本与错误状态统一由合并器在事件循环空闲时刷新
+    m_displayUpdater = new DisplayUpdateCoalescer(m_engine, m_displayPanel, this);
     
-    // 连接数字按钮
-    for (int i = 0; i <= 9; ++i) {
-        QString digit = QString::number(i);
-        if (m_buttons.contains(digit)) {
-            connect(m_buttons[digit], &QPushButton::clicked, this, &MainWindow::onDigitClicked);
-        }
+    // 连接按钮：点击只携带按钮 id
+    for (int id = 0; id < BUTTON_COUNT; ++id) {
+        connect(m_buttons[id], &QPushButton::clicked, this, [this, id]() {
+            TraceRecorder::instance().beginInput("click");
+            onButtonClicked(id);
+            endInputIfIdle();
+        });
     }
 
-    // 连接运算符按钮
-    connect(m_buttons["add"], &QPushButton::clicked, this, &MainWindow::onOperatorClicked);
-    connect(m_buttons["subtract"], &QPushButton::clicked, this, &MainWindow::onOperatorClicked);
-    connect(m_buttons["multiply"], &QPushButton::clicked, this, &MainWindow::onOperatorClicked);
-    connect(m_buttons["divide"], &QPushButton::clicked, this, &MainWindow::onOperatorClicked);
-
-    // 连接功能按钮
-    connect(m_buttons["equals"], &QPushButton::clicked, this, &MainWindow::onEqualsClicked);
-    connect(m_buttons["decimal"], &QPushButton::clicked, this, &MainWindow::onDecimalClicked);
-    connect(m_buttons["C"], &QPushButton::clicked, this, &MainWindow::onFunctionClicked);
-    connect(m_buttons["CE"], &QPushButton::clicked, this, &MainWindow::onFunctionClicked);
-    connect(m_buttons["backspace"], &QPushButton::clicked, this, &MainWindow::onFunctionClicked);
+    // 主题切换
+    connect(&SettingsManager::instance(), &SettingsManager::themeChanged,
+            this, &MainWindow::onThemeChanged);
+    connect(&SettingsManager::instance(), &SettingsManager::keyBindingsChanged,
+            this, &MainWindow::loadKeyBindings);
 
     // 初始显示
-    m_displayPanel->setText(m_engine->getDisplayText());
+    m_displayUpdater->markDirty();
+    m_displayUpdater->flush();
 }
 
-void MainWindow::loadStyleSheet() {
+void MainWindow::loadTheme() {
     SettingsManager &settings = SettingsManager::instance();
-    QString stylePath = settings.getStylePreference();
+    onThemeChanged(settings.getStylePreference());
+}
 
-    QFile styleFile(stylePath);
-    if (styleFile.open(QFile::ReadOnly)) {
-        QString styleSheet = QLatin1String(styleFile.readAll());
-        qApp->setStyleSheet(styleSheet);
-        qDebug() << "样式表加载成功:" << stylePath;
-    } else {
-        qDebug() << "无法加载样式表，使用内置样式";
-        // 使用内置的基本样式
-        qApp->setStyleSheet(R"(
-            QMainWindow { background-color: #f0f0f0; }
-            #centralWidget {
-                background-color: white;
-                border: 1px solid #cccccc;
-                border-radius: 8px;
-                padding: 12px;
-            }
-            #displayPanel {
-                background-color: white;
-                border: 2px solid #cccccc;
-                border-radius: 6px;
-                font-size: 24px;
-                padding: 12px 16px;
-            }
-            QPushButton {
-                background-color: #f8f9fa;
-                border: 1px solid #dee2e6;
-                border-radius: 4px;
-                font-size: 16px;
-                min-width: 60px;
-                min-height: 48px;
-            }
-            QPushButton:hover { background-color: #e9ecef; }
-            QPushButton:pressed { background-color: #dee2e6; }
-        )");
+void MainWindow::onThemeChanged(const QString &theme) {
+    const ThemeData *data = Theme::find(theme);
+    if (!data) {
+        qDebug() << "未知主题，使用默认主题:" << theme;
+        data = &Theme::defaultTheme();
     }
+    applyTheme(*data);
+}
+
+void MainWindow::applyTheme(const ThemeData &theme) {
+    // 主题在构建时由样式表生成，这里只设置调色板与字体，不解析样式表
+    const QPalette base = QApplication::palette();
+    setPalette(Theme::palette(theme, base));
+
+    QPalette centralPalette = m_centralWidget->palette();
+    centralPalette.setColor(QPalette::Window, Theme::color(theme.centralBackground, base));
+    m_centralWidget->setPalette(centralPalette);
+    m_centralWidget->setAutoFillBackground(true);
+
+    m_displayPanel->setTheme(&theme);
+    for (int id = 0; id < BUTTON_COUNT; ++id) {
+        m_buttons[id]->setTheme(&theme);
+    }
+    qDebug() << "主题已应用:" << theme.name;
 }
 
 void MainWindow::restoreWindowState() {
@@ -281,8 +189,8 @@ void MainWindow::restoreWindowState() {
         restoreGeometry(geometry);
         qDebug() << "窗口状态恢复成功";
     } else {
-        // 默认大小
-        setFixedSize(300, 400);
+        // 默认大小：计算区加历史面板
+        setFixedSize(Constants::WINDOW_WIDTH + Constants::HISTORY_PANEL_WIDTH, Constants::WINDOW_HEIGHT);
         qDebug() << "使用默认窗口大小";
     }
 }
@@ -293,135 +201,185 @@ void MainWindow::saveWindowState() {
     qDebug() << "窗口状态保存成功";
 }
 
-void MainWindow::closeEvent(QCloseEvent *event) {
-    saveWindowState();
-    QMainWindow::closeEvent(event);
+bool MainWindow::eventFilter(QObject *watched, QEvent *event) {
+    if (watched == m_displayPanel && event->type() == QEvent::Paint && !m_deferredInitScheduled) {
+        m_deferredInitScheduled = true;
+        m_displayPanel->removeEventFilter(this);
+        // 零间隔定时器在本次绘制提交之后才会触发
+        QTimer::singleShot(0, this, &MainWindow::completeInitialization);
+    }
+    return QMainWindow::eventFilter(watched, event);
 }
 
-void MainWindow::keyPressEvent(QKeyEvent *event) {
-    QString keyText = event->text();
-    int key = event->key();
-
-    // 数字键
-    if (key >= Qt::Key_0 && key <= Qt::Key_9) {
-        m_engine->inputDigit(key - Qt::Key_0);
-        m_displayPanel->setText(m_engine->getDisplayText());
-        event->accept();
-        return;
-    }
+void MainWindow::completeInitialization() {
+    StartupProfiler &profiler = StartupProfiler::instance();
+    profiler.mark("first frame");
 
-    // 运算符
-    if (keyText == "+") {
-        m_engine->inputOperator(Operator::Add);
-        m_displayPanel->setText(m_engine->getDisplayText());
-        event->accept();
-    } else if (keyText == "-") {
-        m_engine->inputOperator(Operator::Subtract);
-        m_displayPanel->setText(m_engine->getDisplayText());
-        event->accept();
-    } else if (key == Qt::Key_Asterisk) {
-        m_engine->inputOperator(Operator::Multiply);
-        m_displayPanel->setText(m_engine->getDisplayText());
-        event->accept();
-    } else if (key == Qt::Key_Slash) {
-        m_engine->inputOperator(Operator::Divide);
-        m_displayPanel->setText(m_engine->getDisplayText());
-        event->accept();
-    }
-    // 等号
-    else if (key == Qt::Key_Equal || key == Qt::Key_Enter || key == Qt::Key_Return) {
-        m_engine->inputEquals();
-        m_displayPanel->setText(m_engine->getDisplayText());
-        event->accept();
-    }
-    // 小数点
-    else if (key == Qt::Key_Period || key == Qt::Key_Comma) {
-        m_engine->inputDecimal();
-        m_displayPanel->setText(m_engine->getDisplayText());
-        event->accept();
+    // 首次运行时补写默认设置（QSettings 写入磁盘），不阻塞首帧
+    SettingsManager::instance().writeDefaults();
+    profiler.mark("SettingsManager::writeDefaults");
+
+    // 自定义键位在首帧之后加载，此前按默认键位分发
+    loadKeyBindings();
+    profiler.mark("MainWindow::loadKeyBindings");
+
+    openHistory();
+    profiler.mark("MainWindow::openHistory");
+
+    profiler.report();
+}
+
+void MainWindow::openHistory() {
+    const QString directory = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    if (directory.isEmpty() || !QDir().mkpath(directory)) {
+        qDebug() << "无法创建历史记录目录:" << directory;
+        return;
     }
-    // 退格
-    else if (key == Qt::Key_Backspace) {
-        m_engine->backspace();
-        m_displayPanel->setText(m_engine->getDisplayText());
-        event->accept();
+    if (!m_history.open(directory + "/history.dat")) {
+        qDebug() << "无法打开历史记录:" << m_history.errorString();
+        return;
     }
-    // 清除
-    else if (key == Qt::Key_Escape) {
-        m_engine->clearAll();
-        m_displayPanel->setText(m_engine->getDisplayText());
-        event->accept();
+    m_engine->setHistoryLog(&m_history);
+
+    m_historyModel = new HistoryListModel(&m_history);
+    connect(m_engine, &CalculatorEngine::historyAppended,
+            m_historyModel, &HistoryListModel::refresh);
+    m_historyView->setModel(m_historyModel);
+
+    // 过滤状态下有新记录时重新检索
+    connect(m_historySearch, &QLineEdit::textChanged, this, &MainWindow::applyHistorySearch);
+    connect(m_engine, &CalculatorEngine::historyAppended, this, [this]() {
+        if (m_historyModel->isFiltered()) {
+            applyHistorySearch();
+        }
+    });
+    m_historySearch->setEnabled(true);
+    qDebug() << "历史记录已加载:" << m_history.count() << "条";
+}
+
+void MainWindow::applyHistorySearch() {
+    if (!m_historyModel) {
+        return;
     }
-    else {
-        QMainWindow::keyPressEvent(event);
+    const QString text = m_historySearch->text().trimmed();
+    if (text.isEmpty()) {
+        m_historyModel->clearFilter();
+        return;
     }
-}
 
-void MainWindow::onDigitClicked() {
-    QPushButton *button = qobject_cast<QPushButton*>(sender());
-    if (button) {
-        int digit = button->text().toInt();
-        m_engine->inputDigit(digit);
-        m_displayPanel->setText(m_engine->getDisplayText());
+    // 无法识别的搜索内容不显示任何记录
+    HistoryQuery query;
+    if (!HistoryQuery::parse(text, QDateTime::currentDateTime(), &query) || query.isEmpty()) {
+        m_historyModel->setFilter(QVector<quint64>());
+        return;
     }
+    m_historyModel->setFilter(m_historyIndex.search(query));
 }
 
-void MainWindow::onOperatorClicked() {
-    QPushButton *button = qobject_cast<QPushButton*>(sender());
-    if (button) {
-        QString text = button->text();
-        Operator op = Operator::None;
-
-        if (text == "+") op = Operator::Add;
-        else if (text == "-") op = Operator::Subtract;
-        else if (text == "×") op = Operator::Multiply;
-        else if (text == "÷") op = Operator::Divide;
+void MainWindow::closeEvent(QCloseEvent *event) {
+    saveWindowState();
+    QMainWindow::closeEvent(event);
+}
 
-        if (op != Operator::None) {
-            m_engine->inputOperator(op);
-            m_displayPanel->setText(m_engine->getDisplayText());
+void MainWindow::keyPressEvent(QKeyEvent *event) {
+    CALCULATOR_TRACE_SCOPE("ui", "MainWindow::keyPressEvent");
+
+    // 查表分发，不读取 event->text()，也不分配内存
+    const bool chordPending = m_keyDispatch.isChordPending();
+    const int command = m_keyDispatch.dispatch(event->key(), event->modifiers());
+    if (command == KeyDispatchTable::NO_COMMAND) {
+        if (chordPending) {
+            // 和弦的第二段未绑定：吞掉这次按键，和弦取消
+            event->accept();
+        } else {
+            QMainWindow::keyPressEvent(event);
         }
+        return;
+    }
+
+    event->accept();
+    if (command != KeyDispatchTable::CHORD_PENDING) {
+        // 只有分发为命令的按键才计入输入延迟（不含未绑定键、修饰键与和弦前缀）
+        TraceRecorder::instance().beginInput("key");
+        executeCommand(command);
+        endInputIfIdle();
     }
 }
 
-void MainWindow::onFunctionClicked() {
-    QPushButton *button = qobject_cast<QPushButton*>(sender());
-    if (button) {
-        QString text = button->text();
-
-        if (text == "C") {
-            m_engine->clearAll();
-        } else if (text == "CE") {
-            m_engine->clearEntry();
-        } else if (text == "⌫") {
-            m_engine->backspace();
-        }
-        m_displayPanel->setText(m_engine->getDisplayText());
+void MainWindow::endInputIfIdle() {
+    // 命令没有使显示失效时不会有刷新与重绘，输入区间在此结束
+    if (!m_displayUpdater->isDirty()) {
+        TraceRecorder::instance().endIdleInputs();
     }
 }
 
-void MainWindow::onEqualsClicked() {
-    m_engine->inputEquals();
-    m_displayPanel->setText(m_engine->getDisplayText());
+void MainWindow::executeCommand(int command) {
+    if (command < BUTTON_COUNT) {
+        onButtonClicked(command);
+        return;
+    }
+    switch (command) {
+    case KeyDispatchTable::ChangeSign:
+        m_engine->changeSign();
+        break;
+    case KeyDispatchTable::ToggleTheme:
+        cycleTheme();
+        break;
+    default:
+        break;
+    }
 }
 
-void MainWindow::onDecimalClicked() {
-    m_engine->inputDecimal();
-    m_displayPanel->setText(m_engine->getDisplayText());
+void MainWindow::cycleTheme() {
+    SettingsManager &settings = SettingsManager::instance();
+    const QStringList themes = settings.getAvailableThemes();
+    int index = themes.indexOf(settings.getStylePreference());
+    settings.setStylePreference(themes.value((index + 1) % themes.size()));
 }
 
-void MainWindow::onDisplayChanged(const QString &text) {
-    Q_UNUSED(text);
+void MainWindow::loadKeyBindings() {
+    const QMap<QString, QString> bindings = SettingsManager::instance().getKeyBindings();
+    m_keyDispatch.loadDefaults();
+    const int failures = m_keyDispatch.applyOverrides(bindings);
+    if (failures > 0) {
+        qDebug() << "忽略无法识别的键位设置:" << failures;
+    }
 }
 
-void MainWindow::onErrorOccurred(ErrorType errorType) {
-    Q_UNUSED(errorType);
-    // 可以在这里添加错误状态显示
-    m_displayPanel->setStyleSheet("color: red;");
+void MainWindow::onButtonClicked(int id) {
+    CALCULATOR_TRACE_SCOPE("ui", "MainWindow::onButtonClicked");
+    if (id < 0 || id >= BUTTON_COUNT) {
+        return;
+    }
+    const ButtonDescriptor &descriptor = BUTTON_TABLE[id];
+
+    switch (descriptor.action) {
+    case ButtonAction::Digit:
+        m_engine->inputDigit(descriptor.digit);
+        break;
+    case ButtonAction::Decimal:
+        m_engine->inputDecimal();
+        break;
+    case ButtonAction::Operator:
+        m_engine->inputOperator(descriptor.op);
+        break;
+    case ButtonAction::Equals:
+        m_engine->inputEquals();
+        break;
+    case ButtonAction::ClearEntry:
+        m_engine->clearEntry();
+        break;
+    case ButtonAction::ClearAll:
+        m_engine->clearAll();
+        break;
+    case ButtonAction::Backspace:
+        m_engine->backspace();
+        break;
+    }
 }
 
-void MainWindow::onEngineStateUpdated(const CalculatorState& state) {
-    m_displayPanel->setErrorState(state.error != ErrorType::NoError);
+void MainWindow::onDisplayChanged(const QString &text) {
+    Q_UNUSED(text);
 }
 
 } // namespace Calculator
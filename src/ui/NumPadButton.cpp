@@ -5,6 +5,7 @@
 
 #include "../../inc/ui/NumPadButton.h"
 #include "../../inc/utils/Constants.h"
+#include <QApplication>
 #include <QMouseEvent>
 #include <QPainter>
 
@@ -16,6 +17,7 @@ NumPadButton::NumPadButton(QWidget *parent)
     , m_isPressed(false)
     , m_isHovered(false)
     , m_shortcutKey(0)
+    , m_theme(nullptr)
 {
     setObjectName("numPadButton");
     setFocusPolicy(Qt::NoFocus);
@@ -39,6 +41,9 @@ NumPadButton::NumPadButton(const QString &text, QWidget *parent)
 void NumPadButton::setButtonType(ButtonType type) {
     if (m_buttonType != type) {
         m_buttonType = type;
+        if (m_theme) {
+            setTheme(m_theme);
+        }
         update();
         emit buttonTypeChanged(type);
     }
@@ -48,6 +53,18 @@ void NumPadButton::setShortcutKey(int key) {
     m_shortcutKey = key;
 }
 
+void NumPadButton::setTheme(const ThemeData *theme) {
+    m_theme = theme;
+    if (m_theme) {
+        const ThemeButtonStyle &style = Theme::buttonStyle(*m_theme, m_buttonType);
+        QFont font = this->font();
+        font.setPixelSize(style.fontPixelSize);
+        font.setWeight(Theme::fontWeight(style.fontWeight));
+        setFont(font);
+    }
+    update();
+}
+
 void NumPadButton::paintEvent(QPaintEvent *event) {
     Q_UNUSED(event);
     
@@ -56,6 +73,21 @@ void NumPadButton::paintEvent(QPaintEvent *event) {
     
     QRect rect = this->rect();
     
+    if (m_theme) {
+        // 主题颜色中的调色板角色按应用默认调色板解析
+        const QPalette base = QApplication::palette();
+        const ThemeButtonStyle &style = Theme::buttonStyle(*m_theme, m_buttonType);
+        const ThemeBoxStyle &box = (m_isPressed || isDown()) ? style.pressed
+                                 : m_isHovered ? style.hover : style.normal;
+        QRect frame = rect.adjusted(1, 1, -1, -1);
+        painter.setBrush(Theme::brush(box.background, base, frame));
+        painter.setPen(QPen(Theme::color(box.border, base), 1));
+        painter.drawRoundedRect(frame, style.borderRadius, style.borderRadius);
+        painter.setPen(Theme::color(box.text, base));
+        painter.drawText(rect, Qt::AlignCenter, text());
+        return;
+    }
+    
     // 根据按钮状态设置颜色
     QColor backgroundColor;
     QColor textColor = palette().color(QPalette::ButtonText);
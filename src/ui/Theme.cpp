@@ -0,0 +1,77 @@
+/**
+ * @file Theme.cpp
+ * @brief 编译期生成的界面主题实现
+ */
+
+#include "../../inc/ui/Theme.h"
+#include "GeneratedThemes.h"
+#include <QFileInfo>
+#include <QFont>
+#include <QLinearGradient>
+
+namespace Calculator {
+
+const ThemeData *Theme::find(const QString &nameOrPath) {
+    // 设置中保存的是样式表路径，按文件名匹配
+    const QString name = QFileInfo(nameOrPath).completeBaseName();
+    for (int i = 0; i < GeneratedThemes::THEME_COUNT; ++i) {
+        if (name == QLatin1String(GeneratedThemes::THEMES[i].name)) {
+            return &GeneratedThemes::THEMES[i];
+        }
+    }
+    return nullptr;
+}
+
+const ThemeData &Theme::defaultTheme() {
+    return GeneratedThemes::THEMES[0];
+}
+
+int Theme::count() {
+    return GeneratedThemes::THEME_COUNT;
+}
+
+const ThemeData &Theme::at(int index) {
+    return GeneratedThemes::THEMES[index];
+}
+
+const ThemeButtonStyle &Theme::buttonStyle(const ThemeData &theme, ButtonType type) {
+    return theme.buttons[static_cast<int>(type)];
+}
+
+QColor Theme::color(const ThemeColor &color, const QPalette &base) {
+    if (color.role != QPalette::NoRole) {
+        return base.color(static_cast<QPalette::ColorRole>(color.role));
+    }
+    return QColor::fromRgba(color.top);
+}
+
+QBrush Theme::brush(const ThemeColor &color, const QPalette &base, const QRect &rect) {
+    if (color.role != QPalette::NoRole || color.top == color.bottom) {
+        return QBrush(Theme::color(color, base));
+    }
+    QLinearGradient gradient(rect.topLeft(), rect.bottomLeft());
+    gradient.setColorAt(0.0, QColor::fromRgba(color.top));
+    gradient.setColorAt(1.0, QColor::fromRgba(color.bottom));
+    return QBrush(gradient);
+}
+
+QPalette Theme::palette(const ThemeData &theme, const QPalette &base) {
+    QPalette palette = base;
+    palette.setColor(QPalette::Window, color(theme.windowBackground, base));
+    palette.setColor(QPalette::WindowText, color(theme.windowText, base));
+    palette.setColor(QPalette::Base, color(theme.panel.background, base));
+    palette.setColor(QPalette::Text, color(theme.panel.text, base));
+    palette.setColor(QPalette::ButtonText, color(theme.windowText, base));
+    return palette;
+}
+
+int Theme::fontWeight(int cssWeight) {
+    if (cssWeight >= 800) return QFont::ExtraBold;
+    if (cssWeight >= 700) return QFont::Bold;
+    if (cssWeight >= 600) return QFont::DemiBold;
+    if (cssWeight >= 500) return QFont::Medium;
+    if (cssWeight >= 400) return QFont::Normal;
+    return QFont::Light;
+}
+
+} // namespace Calculator
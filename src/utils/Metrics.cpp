@@ -0,0 +1,371 @@
+/**
+ * @file Metrics.cpp
+ * @brief 引擎运行指标实现
+ */
+
+#include "../../inc/utils/Metrics.h"
+#include <QSaveFile>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Calculator {
+
+const int LatencyHistogram::SUB_BUCKET_BITS;
+const int LatencyHistogram::SUB_BUCKETS;
+const int LatencyHistogram::MAX_EXPONENT;
+const int LatencyHistogram::BUCKET_COUNT;
+const int MetricsSnapshot::OPERATION_COUNT;
+const int MetricsSnapshot::ERROR_TYPE_COUNT;
+
+namespace {
+
+const int OPERATION_COUNT = MetricsSnapshot::OPERATION_COUNT;
+const int ERROR_TYPE_COUNT = MetricsSnapshot::ERROR_TYPE_COUNT;
+const int BUCKET_COUNT = LatencyHistogram::BUCKET_COUNT;
+
+const char *const OPERATION_NAMES[OPERATION_COUNT] = {
+    "inputDigit", "inputOperator", "calculate", "formatNumber"
+};
+
+// 下标对应 ErrorType，NoError 不导出
+const char *const ERROR_NAMES[ERROR_TYPE_COUNT] = {
+    nullptr, "division_by_zero", "overflow", "invalid_input", "syntax_error"
+};
+
+// 导出到 Prometheus 的桶边界
+struct ExportBound {
+    const char *label;  // le 标签（秒）
+    quint64 ns;
+};
+
+const ExportBound EXPORT_BOUNDS[] = {
+    { "1e-07", 100 }, { "2.5e-07", 250 }, { "5e-07", 500 },
+    { "1e-06", 1000 }, { "2.5e-06", 2500 }, { "5e-06", 5000 },
+    { "1e-05", 10000 }, { "2.5e-05", 25000 }, { "5e-05", 50000 },
+    { "0.0001", 100000 }, { "0.001", 1000000 }, { "0.01", 10000000 },
+    { "0.1", 100000000 }, { "1", 1000000000 }
+};
+
+const double EXPORT_QUANTILES[] = { 0.5, 0.9, 0.99, 0.999 };
+
+static_assert(static_cast<int>(ErrorType::SyntaxError) + 1 == ERROR_TYPE_COUNT,
+              "ERROR_TYPE_COUNT must cover every ErrorType");
+static_assert(static_cast<int>(MetricOperation::FormatNumber) + 1 == OPERATION_COUNT,
+              "OPERATION_COUNT must cover every MetricOperation");
+
+// 只由所属线程写入：读改写不需要原子指令，原子类型只为让汇总线程的读取没有数据竞争
+inline void bump(std::atomic<quint64> &counter, quint64 delta) {
+    counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+}
+
+/**
+ * @brief 一个线程的计数块
+ */
+struct ThreadBlock {
+    std::atomic<quint64> counts[OPERATION_COUNT];
+    std::atomic<quint64> sums[OPERATION_COUNT];
+    std::atomic<quint64> buckets[OPERATION_COUNT][BUCKET_COUNT];
+    std::atomic<quint64> errors[ERROR_TYPE_COUNT];
+
+    ThreadBlock() { clear(); }
+
+    void clear() {
+        for (int op = 0; op < OPERATION_COUNT; ++op) {
+            counts[op].store(0, std::memory_order_relaxed);
+            sums[op].store(0, std::memory_order_relaxed);
+            for (int i = 0; i < BUCKET_COUNT; ++i) {
+                buckets[op][i].store(0, std::memory_order_relaxed);
+            }
+        }
+        for (int i = 0; i < ERROR_TYPE_COUNT; ++i) {
+            errors[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    void addTo(MetricsSnapshot &snapshot) const {
+        for (int op = 0; op < OPERATION_COUNT; ++op) {
+            LatencyHistogram &histogram = snapshot.operations[op];
+            histogram.count += counts[op].load(std::memory_order_relaxed);
+            histogram.sumNs += sums[op].load(std::memory_order_relaxed);
+            for (int i = 0; i < BUCKET_COUNT; ++i) {
+                histogram.buckets[i] += buckets[op][i].load(std::memory_order_relaxed);
+            }
+        }
+        for (int i = 0; i < ERROR_TYPE_COUNT; ++i) {
+            snapshot.errors[i] += errors[i].load(std::memory_order_relaxed);
+        }
+    }
+};
+
+/**
+ * @brief 所有线程计数块的登记表
+ */
+struct Registry {
+    std::mutex mutex;
+    std::vector<ThreadBlock*> blocks;   // 存活线程的计数块
+    MetricsSnapshot retired;            // 已退出线程的计数之和
+
+    Registry() { clearSnapshot(retired); }
+
+    static void clearSnapshot(MetricsSnapshot &snapshot) {
+        for (int op = 0; op < OPERATION_COUNT; ++op) {
+            snapshot.operations[op].clear();
+        }
+        std::memset(snapshot.errors, 0, sizeof(snapshot.errors));
+    }
+};
+
+// 有意不析构：其他静态对象与线程的析构可能晚于它
+Registry &registry() {
+    static Registry *instance = new Registry;
+    return *instance;
+}
+
+/**
+ * @brief 线程局部的计数块持有者，线程退出时把计数并入汇总值
+ */
+struct BlockHolder {
+    ThreadBlock *block;
+
+    BlockHolder() : block(new ThreadBlock) {
+        Registry &r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.blocks.push_back(block);
+    }
+
+    ~BlockHolder() {
+        Registry &r = registry();
+        {
+            std::lock_guard<std::mutex> lock(r.mutex);
+            block->addTo(r.retired);
+            r.blocks.erase(std::find(r.blocks.begin(), r.blocks.end(), block));
+        }
+        delete block;
+    }
+};
+
+ThreadBlock &localBlock() {
+    thread_local BlockHolder holder;
+    return *holder.block;
+}
+
+/**
+ * @brief 定时导出线程的状态
+ */
+struct Dumper {
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::thread thread;
+    QString path;
+    int intervalMs;
+    bool stopping;
+
+    Dumper() : intervalMs(0), stopping(false) {}
+};
+
+Dumper &dumper() {
+    static Dumper *instance = new Dumper;
+    return *instance;
+}
+
+void runDumper() {
+    Dumper &d = dumper();
+    std::unique_lock<std::mutex> lock(d.mutex);
+    for (;;) {
+        const bool stopping = d.wake.wait_for(lock, std::chrono::milliseconds(d.intervalMs),
+                                              [&d]() { return d.stopping; });
+        const QString path = d.path;
+        lock.unlock();
+        Metrics::writePrometheusFile(path);
+        lock.lock();
+        if (stopping) {
+            break;
+        }
+    }
+}
+
+} // namespace
+
+void LatencyHistogram::clear() {
+    count = 0;
+    sumNs = 0;
+    std::memset(buckets, 0, sizeof(buckets));
+}
+
+void LatencyHistogram::merge(const LatencyHistogram &other) {
+    count += other.count;
+    sumNs += other.sumNs;
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        buckets[i] += other.buckets[i];
+    }
+}
+
+int LatencyHistogram::bucketIndex(quint64 ns) {
+    if (ns < static_cast<quint64>(SUB_BUCKETS)) {
+        return static_cast<int>(ns);
+    }
+    int exponent = 63;
+    while (!(ns >> exponent)) {
+        --exponent;
+    }
+    if (exponent >= MAX_EXPONENT) {
+        return BUCKET_COUNT - 1;
+    }
+    // 最高位之后的 SUB_BUCKET_BITS 位决定区间内的子桶
+    const int sub = static_cast<int>(ns >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1);
+    return (exponent - SUB_BUCKET_BITS + 1) * SUB_BUCKETS + sub;
+}
+
+quint64 LatencyHistogram::bucketUpperBound(int index) {
+    if (index < SUB_BUCKETS) {
+        return static_cast<quint64>(index);
+    }
+    const int shift = index / SUB_BUCKETS - 1;
+    const quint64 lower = static_cast<quint64>(SUB_BUCKETS + index % SUB_BUCKETS) << shift;
+    return lower + (quint64(1) << shift) - 1;
+}
+
+quint64 LatencyHistogram::percentile(double q) const {
+    if (count == 0) {
+        return 0;
+    }
+    const quint64 rank = std::max<quint64>(1, static_cast<quint64>(q * count + 0.5));
+    quint64 seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            return bucketUpperBound(i);
+        }
+    }
+    return bucketUpperBound(BUCKET_COUNT - 1);
+}
+
+QByteArray MetricsSnapshot::toPrometheusText() const {
+    QByteArray text;
+    text.reserve(8192);
+
+    text += "# HELP calculator_operation_duration_seconds Latency of CalculatorEngine operations.\n"
+            "# TYPE calculator_operation_duration_seconds histogram\n";
+    for (int op = 0; op < OPERATION_COUNT; ++op) {
+        const LatencyHistogram &histogram = operations[op];
+        const QByteArray label = QByteArray("operation=\"") + OPERATION_NAMES[op] + '"';
+
+        // 桶上界不超过边界的样本计入该边界（累计）
+        quint64 cumulative = 0;
+        int bucket = 0;
+        for (const ExportBound &bound : EXPORT_BOUNDS) {
+            while (bucket < BUCKET_COUNT && LatencyHistogram::bucketUpperBound(bucket) <= bound.ns) {
+                cumulative += histogram.buckets[bucket++];
+            }
+            text += "calculator_operation_duration_seconds_bucket{" + label + ",le=\"" + bound.label
+                    + "\"} " + QByteArray::number(cumulative) + '\n';
+        }
+        text += "calculator_operation_duration_seconds_bucket{" + label + ",le=\"+Inf\"} "
+                + QByteArray::number(histogram.count) + '\n';
+        text += "calculator_operation_duration_seconds_sum{" + label + "} "
+                + QByteArray::number(histogram.sumNs / 1e9, 'g', 12) + '\n';
+        text += "calculator_operation_duration_seconds_count{" + label + "} "
+                + QByteArray::number(histogram.count) + '\n';
+    }
+
+    text += "# HELP calculator_operation_duration_quantile_seconds Latency quantiles from the in-process histogram.\n"
+            "# TYPE calculator_operation_duration_quantile_seconds gauge\n";
+    for (int op = 0; op < OPERATION_COUNT; ++op) {
+        for (double q : EXPORT_QUANTILES) {
+            text += QByteArray("calculator_operation_duration_quantile_seconds{operation=\"")
+                    + OPERATION_NAMES[op] + "\",quantile=\"" + QByteArray::number(q) + "\"} "
+                    + QByteArray::number(operations[op].percentile(q) / 1e9, 'g', 6) + '\n';
+        }
+    }
+
+    text += "# HELP calculator_errors_total Errors reported by CalculatorEngine, by type.\n"
+            "# TYPE calculator_errors_total counter\n";
+    for (int i = 1; i < ERROR_TYPE_COUNT; ++i) {
+        text += QByteArray("calculator_errors_total{type=\"") + ERROR_NAMES[i] + "\"} "
+                + QByteArray::number(errors[i]) + '\n';
+    }
+    return text;
+}
+
+bool Metrics::isEnabled() {
+#ifdef CALCULATOR_ENABLE_METRICS
+    return true;
+#else
+    return false;
+#endif
+}
+
+void Metrics::recordLatency(MetricOperation op, quint64 ns) {
+    ThreadBlock &block = localBlock();
+    const int index = static_cast<int>(op);
+    bump(block.counts[index], 1);
+    bump(block.sums[index], ns);
+    bump(block.buckets[index][LatencyHistogram::bucketIndex(ns)], 1);
+}
+
+void Metrics::recordError(ErrorType error) {
+    bump(localBlock().errors[static_cast<int>(error)], 1);
+}
+
+MetricsSnapshot Metrics::snapshot() {
+    MetricsSnapshot snapshot;
+    Registry &r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    snapshot = r.retired;
+    for (const ThreadBlock *block : r.blocks) {
+        block->addTo(snapshot);
+    }
+    return snapshot;
+}
+
+void Metrics::reset() {
+    Registry &r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    Registry::clearSnapshot(r.retired);
+    for (ThreadBlock *block : r.blocks) {
+        block->clear();
+    }
+}
+
+bool Metrics::writePrometheusFile(const QString &path) {
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    const QByteArray text = snapshot().toPrometheusText();
+    if (file.write(text) != text.size()) {
+        file.cancelWriting();
+        return false;
+    }
+    return file.commit();
+}
+
+void Metrics::startPeriodicDump(const QString &path, int intervalMs) {
+    stopPeriodicDump();
+    Dumper &d = dumper();
+    std::lock_guard<std::mutex> lock(d.mutex);
+    d.path = path;
+    d.intervalMs = std::max(intervalMs, 100);
+    d.stopping = false;
+    d.thread = std::thread(runDumper);
+}
+
+void Metrics::stopPeriodicDump() {
+    Dumper &d = dumper();
+    {
+        std::lock_guard<std::mutex> lock(d.mutex);
+        if (!d.thread.joinable()) {
+            return;
+        }
+        d.stopping = true;
+    }
+    d.wake.notify_all();
+    d.thread.join();
+}
+
+} // namespace Calculator
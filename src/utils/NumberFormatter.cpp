@@ -0,0 +1,325 @@
+/**
+ * @file NumberFormatter.cpp
+ * @brief 无堆分配的数字格式化实现
+ */
+
+#include "../../inc/utils/NumberFormatter.h"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SIZEOF_INT128__) && !defined(CALCULATOR_NO_INT128)
+#define CALCULATOR_HAS_INT128 1
+// __extension__ 避免 -Wpedantic 对非标准整数类型的警告
+__extension__ typedef unsigned __int128 UInt128;
+#endif
+
+namespace Calculator {
+
+constexpr int NumberFormatter::MAX_SIGNIFICANT_DIGITS;
+constexpr int NumberFormatter::BUFFER_SIZE;
+
+namespace {
+
+const std::uint64_t POWERS_OF_TEN[20] = {
+    1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull,
+    100000000ull, 1000000000ull, 10000000000ull, 100000000000ull, 1000000000000ull,
+    10000000000000ull, 100000000000000ull, 1000000000000000ull, 10000000000000000ull,
+    100000000000000000ull, 1000000000000000000ull, 10000000000000000000ull
+};
+
+/**
+ * @brief 栈上定长大整数
+ * 最坏情况为最小次正规数：m·10^340 与 2^1074，均不超过 1280 位。
+ */
+class FixedBigInt {
+public:
+    static const int CAPACITY = 40;
+
+    explicit FixedBigInt(std::uint64_t value)
+        : m_size(0) {
+        while (value != 0) {
+            m_limbs[m_size++] = static_cast<std::uint32_t>(value);
+            value >>= 32;
+        }
+    }
+
+    bool isZero() const { return m_size == 0; }
+
+    int bitLength() const {
+        if (m_size == 0) {
+            return 0;
+        }
+        int bits = (m_size - 1) * 32;
+        for (std::uint32_t top = m_limbs[m_size - 1]; top != 0; top >>= 1) {
+            ++bits;
+        }
+        return bits;
+    }
+
+    void multiply(std::uint32_t factor) {
+        std::uint64_t carry = 0;
+        for (int i = 0; i < m_size; ++i) {
+            carry += static_cast<std::uint64_t>(m_limbs[i]) * factor;
+            m_limbs[i] = static_cast<std::uint32_t>(carry);
+            carry >>= 32;
+        }
+        if (carry != 0) {
+            m_limbs[m_size++] = static_cast<std::uint32_t>(carry);
+        }
+    }
+
+    void multiplyPowerOfTen(int exponent) {
+        for (; exponent >= 9; exponent -= 9) {
+            multiply(1000000000u);
+        }
+        if (exponent > 0) {
+            multiply(static_cast<std::uint32_t>(POWERS_OF_TEN[exponent]));
+        }
+    }
+
+    void shiftLeft(int bits) {
+        if (m_size == 0 || bits == 0) {
+            return;
+        }
+        const int limbShift = bits / 32;
+        const int bitShift = bits % 32;
+        m_limbs[m_size + limbShift] = 0;
+        for (int i = m_size - 1; i >= 0; --i) {
+            std::uint64_t value = static_cast<std::uint64_t>(m_limbs[i]) << bitShift;
+            m_limbs[i + limbShift + 1] |= static_cast<std::uint32_t>(value >> 32);
+            m_limbs[i + limbShift] = static_cast<std::uint32_t>(value);
+        }
+        for (int i = 0; i < limbShift; ++i) {
+            m_limbs[i] = 0;
+        }
+        m_size += limbShift + 1;
+        trim();
+    }
+
+    void shiftRightOne() {
+        for (int i = 0; i < m_size; ++i) {
+            m_limbs[i] = (m_limbs[i] >> 1) | (i + 1 < m_size ? m_limbs[i + 1] << 31 : 0);
+        }
+        trim();
+    }
+
+    static int compare(const FixedBigInt &a, const FixedBigInt &b) {
+        if (a.m_size != b.m_size) {
+            return a.m_size < b.m_size ? -1 : 1;
+        }
+        for (int i = a.m_size - 1; i >= 0; --i) {
+            if (a.m_limbs[i] != b.m_limbs[i]) {
+                return a.m_limbs[i] < b.m_limbs[i] ? -1 : 1;
+            }
+        }
+        return 0;
+    }
+
+    // *this -= other（要求 *this >= other）
+    void subtract(const FixedBigInt &other) {
+        std::int64_t borrow = 0;
+        for (int i = 0; i < m_size; ++i) {
+            std::int64_t diff = static_cast<std::int64_t>(m_limbs[i]) - borrow -
+                                (i < other.m_size ? other.m_limbs[i] : 0);
+            borrow = diff < 0 ? 1 : 0;
+            m_limbs[i] = static_cast<std::uint32_t>(diff + (borrow << 32));
+        }
+        trim();
+    }
+
+private:
+    void trim() {
+        while (m_size > 0 && m_limbs[m_size - 1] == 0) {
+            --m_size;
+        }
+    }
+
+private:
+    std::uint32_t m_limbs[CAPACITY + 2];
+    int m_size;
+};
+
+/**
+ * @brief 计算 round(mantissa · 2^binaryExponent · 10^decimalExponent)，恰好一半时向上
+ * 调用方保证结果小于 2^63。
+ */
+std::uint64_t scaleAndRound(std::uint64_t mantissa, int binaryExponent, int decimalExponent) {
+#ifdef CALCULATOR_HAS_INT128
+    // 分子分母都能放进 128 位时直接用整数运算（10^k 不超过 3.33k + 1 位）
+    const int tenBits = (decimalExponent < 0 ? -decimalExponent : decimalExponent) * 3322 / 1000 + 1;
+    if (decimalExponent >= 0 && binaryExponent >= 0) {
+        if (53 + binaryExponent + tenBits <= 127) {
+            return static_cast<std::uint64_t>((static_cast<UInt128>(mantissa) << binaryExponent) *
+                                              POWERS_OF_TEN[decimalExponent]);
+        }
+    } else if (decimalExponent >= 0) {
+        const int shift = -binaryExponent;
+        if (decimalExponent <= 19 + 19 && 53 + tenBits <= 127 && shift <= 127) {
+            UInt128 numerator = mantissa;
+            for (int k = decimalExponent; k > 0; k -= 19) {
+                numerator *= POWERS_OF_TEN[k > 19 ? 19 : k];
+            }
+            UInt128 quotient = numerator >> shift;
+            UInt128 remainder = numerator - (quotient << shift);
+            UInt128 half = static_cast<UInt128>(1) << (shift - 1);
+            return static_cast<std::uint64_t>(quotient) + (remainder >= half ? 1 : 0);
+        }
+    } else {
+        const int shift = binaryExponent > 0 ? binaryExponent : 0;
+        const int denominatorShift = binaryExponent < 0 ? -binaryExponent : 0;
+        if (53 + shift <= 127 && tenBits + denominatorShift <= 126 && -decimalExponent <= 38) {
+            UInt128 numerator = static_cast<UInt128>(mantissa) << shift;
+            UInt128 denominator = 1;
+            for (int k = -decimalExponent; k > 0; k -= 19) {
+                denominator *= POWERS_OF_TEN[k > 19 ? 19 : k];
+            }
+            denominator <<= denominatorShift;
+            UInt128 quotient = numerator / denominator;
+            UInt128 remainder = numerator - quotient * denominator;
+            return static_cast<std::uint64_t>(quotient) + (remainder >= denominator - remainder ? 1 : 0);
+        }
+    }
+#endif
+
+    // 通用路径：定长大整数上的移位减法（商不超过 63 位）
+    FixedBigInt numerator(mantissa);
+    FixedBigInt denominator(1);
+    if (binaryExponent >= 0) {
+        numerator.shiftLeft(binaryExponent);
+    } else {
+        denominator.shiftLeft(-binaryExponent);
+    }
+    if (decimalExponent >= 0) {
+        numerator.multiplyPowerOfTen(decimalExponent);
+    } else {
+        denominator.multiplyPowerOfTen(-decimalExponent);
+    }
+
+    std::uint64_t quotient = 0;
+    int shift = numerator.bitLength() - denominator.bitLength();
+    if (shift >= 0) {
+        FixedBigInt divisor = denominator;
+        divisor.shiftLeft(shift);
+        for (; shift >= 0; --shift) {
+            quotient <<= 1;
+            if (FixedBigInt::compare(numerator, divisor) >= 0) {
+                numerator.subtract(divisor);
+                quotient |= 1;
+            }
+            divisor.shiftRightOne();
+        }
+    }
+
+    // 余数的两倍不小于除数时进位
+    numerator.shiftLeft(1);
+    return quotient + (FixedBigInt::compare(numerator, denominator) >= 0 ? 1 : 0);
+}
+
+// 写入十进制无符号整数，返回长度
+int writeInteger(std::uint64_t value, char *buffer) {
+    char digits[20];
+    int count = 0;
+    do {
+        digits[count++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+    for (int i = 0; i < count; ++i) {
+        buffer[i] = digits[count - 1 - i];
+    }
+    return count;
+}
+
+} // namespace
+
+int NumberFormatter::format(double value, char *buffer, int significantDigits) {
+    const int precision = significantDigits < 1 ? 1
+                        : (significantDigits > MAX_SIGNIFICANT_DIGITS ? MAX_SIGNIFICANT_DIGITS
+                                                                      : significantDigits);
+    int length = 0;
+    if (std::isnan(value)) {
+        std::memcpy(buffer, "nan", 3);
+        return 3;
+    }
+    if (std::signbit(value)) {
+        buffer[length++] = '-';
+        value = -value;
+    }
+    if (std::isinf(value)) {
+        std::memcpy(buffer + length, "inf", 3);
+        return length + 3;
+    }
+
+    // 整数快速路径：位数不超过有效位数时原样输出
+    if (value < static_cast<double>(POWERS_OF_TEN[precision]) && value == std::floor(value)) {
+        return length + writeInteger(static_cast<std::uint64_t>(value), buffer + length);
+    }
+
+    // value = mantissa · 2^binaryExponent
+    int exponent;
+    const double fraction = std::frexp(value, &exponent);
+    const std::uint64_t mantissa = static_cast<std::uint64_t>(std::ldexp(fraction, 53));
+    const int binaryExponent = exponent - 53;
+
+    // 十进制指数估计（可能偏小 1），按得到的位数修正
+    int decimalExponent = ((exponent - 1) * 78913) >> 18;
+    std::uint64_t digits = scaleAndRound(mantissa, binaryExponent, precision - 1 - decimalExponent);
+    if (digits >= POWERS_OF_TEN[precision]) {
+        ++decimalExponent;
+        digits = scaleAndRound(mantissa, binaryExponent, precision - 1 - decimalExponent);
+        if (digits >= POWERS_OF_TEN[precision]) {
+            // 舍入进位到下一个数量级（如 9.999…95 → 10）
+            digits /= 10;
+            ++decimalExponent;
+        }
+    }
+
+    // 去除尾随零
+    int digitCount = precision;
+    while (digitCount > 1 && digits % 10 == 0) {
+        digits /= 10;
+        --digitCount;
+    }
+    char text[MAX_SIGNIFICANT_DIGITS];
+    writeInteger(digits, text);
+
+    if (decimalExponent < -4 || decimalExponent >= precision) {
+        // 科学计数法：d[.ddd]e±XX
+        buffer[length++] = text[0];
+        if (digitCount > 1) {
+            buffer[length++] = '.';
+            std::memcpy(buffer + length, text + 1, static_cast<size_t>(digitCount - 1));
+            length += digitCount - 1;
+        }
+        buffer[length++] = 'e';
+        buffer[length++] = decimalExponent < 0 ? '-' : '+';
+        int magnitude = decimalExponent < 0 ? -decimalExponent : decimalExponent;
+        if (magnitude < 10) {
+            buffer[length++] = '0';
+        }
+        length += writeInteger(static_cast<std::uint64_t>(magnitude), buffer + length);
+    } else if (decimalExponent >= 0) {
+        // 定点：整数部分不足时补零
+        const int integerDigits = decimalExponent + 1;
+        for (int i = 0; i < integerDigits; ++i) {
+            buffer[length++] = i < digitCount ? text[i] : '0';
+        }
+        if (digitCount > integerDigits) {
+            buffer[length++] = '.';
+            std::memcpy(buffer + length, text + integerDigits, static_cast<size_t>(digitCount - integerDigits));
+            length += digitCount - integerDigits;
+        }
+    } else {
+        // 纯小数：0.000ddd
+        buffer[length++] = '0';
+        buffer[length++] = '.';
+        for (int i = -1; i > decimalExponent; --i) {
+            buffer[length++] = '0';
+        }
+        std::memcpy(buffer + length, text, static_cast<size_t>(digitCount));
+        length += digitCount;
+    }
+    return length;
+}
+
+} // namespace Calculator
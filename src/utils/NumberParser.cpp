@@ -0,0 +1,110 @@
+/**
+ * @file NumberParser.cpp
+ * @brief 与区域设置无关的十进制数字解析实现
+ */
+
+#include "../../inc/utils/NumberParser.h"
+#include <QByteArray>
+
+namespace Calculator {
+
+namespace {
+
+const unsigned long long MAX_EXACT_MANTISSA = 1ULL << 53;  // double 可精确表示的最大整数
+const int MAX_MANTISSA_DIGITS = 19;                       // uint64 可容纳的十进制位数
+
+inline bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+} // namespace
+
+constexpr int NumberParser::MAX_EXACT_POWER;
+constexpr double NumberParser::EXACT_POWERS_OF_TEN[];
+
+int NumberParser::parse(const char *text, int length, double &value) {
+    unsigned long long mantissa = 0;
+    int mantissaDigits = 0;     // 已计入尾数的有效数字位数
+    int exponent = 0;           // 十进制指数修正
+    bool truncated = false;     // 是否有有效数字未计入尾数
+    bool sawDigit = false;
+    int pos = 0;
+
+    // 整数部分
+    while (pos < length && isDigit(text[pos])) {
+        sawDigit = true;
+        int digit = text[pos] - '0';
+        if (mantissaDigits < MAX_MANTISSA_DIGITS) {
+            if (mantissa != 0 || digit != 0) {
+                mantissa = mantissa * 10 + digit;
+                ++mantissaDigits;
+            }
+        } else {
+            ++exponent;
+            truncated = truncated || digit != 0;
+        }
+        ++pos;
+    }
+
+    // 小数部分
+    if (pos < length && text[pos] == '.') {
+        ++pos;
+        while (pos < length && isDigit(text[pos])) {
+            sawDigit = true;
+            int digit = text[pos] - '0';
+            if (mantissaDigits < MAX_MANTISSA_DIGITS) {
+                if (mantissa != 0 || digit != 0) {
+                    mantissa = mantissa * 10 + digit;
+                    ++mantissaDigits;
+                }
+                --exponent;
+            } else {
+                truncated = truncated || digit != 0;
+            }
+            ++pos;
+        }
+    }
+
+    if (!sawDigit) {
+        return 0;
+    }
+
+    // 指数部分（只有后面跟着数字时才消耗 e）
+    if (pos < length && (text[pos] == 'e' || text[pos] == 'E')) {
+        int expPos = pos + 1;
+        bool negative = false;
+        if (expPos < length && (text[expPos] == '+' || text[expPos] == '-')) {
+            negative = text[expPos] == '-';
+            ++expPos;
+        }
+        if (expPos < length && isDigit(text[expPos])) {
+            int explicitExponent = 0;
+            while (expPos < length && isDigit(text[expPos])) {
+                if (explicitExponent < 100000) {
+                    explicitExponent = explicitExponent * 10 + (text[expPos] - '0');
+                }
+                ++expPos;
+            }
+            exponent += negative ? -explicitExponent : explicitExponent;
+            pos = expPos;
+        }
+    }
+
+    // 快速路径：尾数与10的幂都可精确表示时，一次乘除即得到正确舍入的结果
+    if (!truncated && mantissa <= MAX_EXACT_MANTISSA &&
+        exponent >= -MAX_EXACT_POWER && exponent <= MAX_EXACT_POWER) {
+        double m = static_cast<double>(mantissa);
+        value = exponent >= 0 ? m * EXACT_POWERS_OF_TEN[exponent]
+                              : m / EXACT_POWERS_OF_TEN[-exponent];
+        return pos;
+    }
+    if (mantissa == 0 && !truncated) {
+        value = 0.0;
+        return pos;
+    }
+
+    value = QByteArray::fromRawData(text, pos).toDouble();
+    return pos;
+}
+
+} // namespace Calculator
@@ -4,9 +4,30 @@
  */
 
 #include "../../inc/utils/SettingsManager.h"
+#include <QFileInfo>
+#include <QSettings>
 
 namespace Calculator {
 
+namespace {
+
+const char *const ORGANIZATION = "QtCalculator";
+const char *const APPLICATION = "Calculator";
+
+const char *const KEY_STYLE = "style/preference";
+const char *const KEY_GEOMETRY = "window/geometry";
+const char *const KEY_SOUND = "sound/enabled";
+const char *const KEY_LANGUAGE = "language/current";
+const char KEY_BINDING_GROUP[] = "keys/";
+const int KEY_BINDING_GROUP_LENGTH = sizeof(KEY_BINDING_GROUP) - 1;
+
+// 主题名（构建时由 styles/*.qss 生成，见 Theme::find()）
+const char *const DEFAULT_STYLE = "default";
+const char *const DARK_STYLE = "dark";
+const char *const DEFAULT_LANGUAGE = "zh_CN";
+
+} // namespace
+
 SettingsManager& SettingsManager::instance() {
     static SettingsManager instance;
     return instance;
@@ -14,63 +35,125 @@ SettingsManager& SettingsManager::instance() {
 
 SettingsManager::SettingsManager(QObject *parent)
     : QObject(parent)
-    , m_settings("QtCalculator", "Calculator")
+    , m_soundEnabled(false)
+    , m_writer(ORGANIZATION, APPLICATION)
 {
-    // 初始化默认设置
-    if (!m_settings.contains("style/preference")) {
-        m_settings.setValue("style/preference", ":/styles/default.qss");
-    }
-    if (!m_settings.contains("window/geometry")) {
-        // 不设置默认值，第一次运行时为空
+    // 只读取，不写入设置
+    load();
+}
+
+void SettingsManager::load() {
+    const QSettings settings(ORGANIZATION, APPLICATION);
+    // 旧版本保存的是样式表资源路径（如 ":/styles/dark.qss"），只取主题名
+    const QString style = settings.value(KEY_STYLE, DEFAULT_STYLE).toString();
+    m_stylePreference = QFileInfo(style).completeBaseName();
+    m_windowGeometry = settings.value(KEY_GEOMETRY).toByteArray();
+    m_soundEnabled = settings.value(KEY_SOUND, false).toBool();
+    m_language = settings.value(KEY_LANGUAGE, DEFAULT_LANGUAGE).toString();
+
+    const QStringList keys = settings.allKeys();
+    for (const QString &key : keys) {
+        if (key.startsWith(KEY_BINDING_GROUP)) {
+            m_keyBindings.insert(key.mid(KEY_BINDING_GROUP_LENGTH), settings.value(key).toString());
+        }
     }
-    if (!m_settings.contains("sound/enabled")) {
-        m_settings.setValue("sound/enabled", false);
+
+    // window/geometry 没有默认值，第一次运行时为空
+    const char *const defaults[] = { KEY_STYLE, KEY_SOUND, KEY_LANGUAGE };
+    for (const char *key : defaults) {
+        if (!keys.contains(key)) {
+            m_missingDefaults.append(key);
+        }
     }
-    if (!m_settings.contains("language/current")) {
-        m_settings.setValue("language/current", "zh_CN");
+}
+
+void SettingsManager::writeDefaults() {
+    for (const QString &key : m_missingDefaults) {
+        if (key == KEY_STYLE) {
+            m_writer.setValue(key, m_stylePreference);
+        } else if (key == KEY_SOUND) {
+            m_writer.setValue(key, m_soundEnabled);
+        } else if (key == KEY_LANGUAGE) {
+            m_writer.setValue(key, m_language);
+        }
     }
+    m_missingDefaults.clear();
+}
+
+void SettingsManager::waitForWrites() {
+    m_writer.waitForIdle();
 }
 
 QString SettingsManager::getStylePreference() const {
-    return m_settings.value("style/preference", ":/styles/default.qss").toString();
+    return m_stylePreference;
 }
 
 void SettingsManager::setStylePreference(const QString &style)
 {
-    if (getStylePreference() != style) {
-        m_settings.setValue("style/preference", style);
+    if (m_stylePreference != style) {
+        m_stylePreference = style;
+        m_writer.setValue(KEY_STYLE, style);
+        emit themeChanged(style);
     }
 }
 
 QStringList SettingsManager::getAvailableThemes() const {
-    return { ":/styles/default.qss", ":/styles/dark.qss" };
+    return { DEFAULT_STYLE, DARK_STYLE };
+}
+
+QMap<QString, QString> SettingsManager::getKeyBindings() const {
+    return m_keyBindings;
+}
+
+void SettingsManager::setKeyBinding(const QString &command, const QString &sequence) {
+    const QString key = KEY_BINDING_GROUP + command;
+    QMap<QString, QString>::iterator it = m_keyBindings.find(command);
+    if (sequence.isNull()) {
+        if (it == m_keyBindings.end()) {
+            return;
+        }
+        m_keyBindings.erase(it);
+        m_writer.remove(key);
+    } else {
+        if (it != m_keyBindings.end() && it.value() == sequence) {
+            return;
+        }
+        m_keyBindings.insert(command, sequence);
+        m_writer.setValue(key, sequence);
+    }
+    emit keyBindingsChanged();
 }
 
 QByteArray SettingsManager::getWindowGeometry() const {
-    return m_settings.value("window/geometry").toByteArray();
+    return m_windowGeometry;
 }
 
 void SettingsManager::setWindowGeometry(const QByteArray &geometry) {
-    m_settings.setValue("window/geometry", geometry);
+    if (m_windowGeometry != geometry) {
+        m_windowGeometry = geometry;
+        m_writer.setValue(KEY_GEOMETRY, geometry);
+    }
 }
 
 bool SettingsManager::getSoundEnabled() const {
-    return m_settings.value("sound/enabled", false).toBool();
+    return m_soundEnabled;
 }
 
 void SettingsManager::setSoundEnabled(bool enabled) {
-    if (getSoundEnabled() != enabled) {
-        m_settings.setValue("sound/enabled", enabled);
+    if (m_soundEnabled != enabled) {
+        m_soundEnabled = enabled;
+        m_writer.setValue(KEY_SOUND, enabled);
     }
 }
 
 QString SettingsManager::getLanguage() const {
-    return m_settings.value("language/current", "zh_CN").toString();
+    return m_language;
 }
 
 void SettingsManager::setLanguage(const QString &language) {
-    if (getLanguage() != language) {
-        m_settings.setValue("language/current", language);
+    if (m_language != language) {
+        m_language = language;
+        m_writer.setValue(KEY_LANGUAGE, language);
     }
 }
 
@@ -0,0 +1,113 @@
+/**
+ * @file SettingsWriter.cpp
+ * @brief 设置的后台写入线程实现
+ */
+
+#include "../../inc/utils/SettingsWriter.h"
+#include <QSettings>
+#include <chrono>
+
+namespace Calculator {
+
+const int SettingsWriter::COALESCE_MS;
+
+SettingsWriter::SettingsWriter(const QString &organization, const QString &application)
+    : m_organization(organization)
+    , m_application(application)
+    , m_flushRequested(false)
+    , m_writing(false)
+    , m_stopping(false)
+    , m_batches(0)
+{
+}
+
+SettingsWriter::~SettingsWriter() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wakeCondition.notify_all();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void SettingsWriter::setValue(const QString &key, const QVariant &value) {
+    enqueue(key, value);
+}
+
+void SettingsWriter::remove(const QString &key) {
+    enqueue(key, QVariant());
+}
+
+void SettingsWriter::enqueue(const QString &key, const QVariant &value) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending.insert(key, value);
+        if (!m_thread.joinable()) {
+            m_thread = std::thread(&SettingsWriter::run, this);
+        }
+    }
+    m_wakeCondition.notify_one();
+}
+
+void SettingsWriter::flush() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_pending.isEmpty()) {
+            return;
+        }
+        m_flushRequested = true;
+    }
+    m_wakeCondition.notify_one();
+}
+
+void SettingsWriter::waitForIdle() {
+    flush();
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idleCondition.wait(lock, [this]() { return m_pending.isEmpty() && !m_writing; });
+}
+
+quint64 SettingsWriter::batchCount() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_batches;
+}
+
+void SettingsWriter::run() {
+    // QSettings 对象只在本线程使用；同一文件的多个 QSettings 对象可以分属不同线程
+    QSettings settings(m_organization, m_application);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;) {
+        m_wakeCondition.wait(lock, [this]() { return !m_pending.isEmpty() || m_stopping; });
+        if (m_pending.isEmpty()) {
+            break;
+        }
+
+        // 合并窗口内的后续修改并入同一批
+        m_wakeCondition.wait_for(lock, std::chrono::milliseconds(COALESCE_MS),
+                                 [this]() { return m_flushRequested || m_stopping; });
+
+        QMap<QString, QVariant> batch;
+        batch.swap(m_pending);
+        m_flushRequested = false;
+        m_writing = true;
+        lock.unlock();
+
+        for (QMap<QString, QVariant>::const_iterator it = batch.constBegin(); it != batch.constEnd(); ++it) {
+            if (it.value().isValid()) {
+                settings.setValue(it.key(), it.value());
+            } else {
+                settings.remove(it.key());
+            }
+        }
+        settings.sync();
+
+        lock.lock();
+        m_writing = false;
+        ++m_batches;
+        m_idleCondition.notify_all();
+    }
+}
+
+} // namespace Calculator
@@ -0,0 +1,53 @@
+/**
+ * @file StartupProfiler.cpp
+ * @brief 启动阶段计时实现
+ */
+
+#include "../../inc/utils/StartupProfiler.h"
+#include <cstdio>
+
+namespace Calculator {
+
+StartupProfiler &StartupProfiler::instance() {
+    static StartupProfiler instance;
+    return instance;
+}
+
+StartupProfiler::StartupProfiler()
+    : m_count(0)
+    , m_enabled(false)
+    , m_reported(false)
+{
+}
+
+void StartupProfiler::start() {
+    m_timer.start();
+    m_count = 0;
+    mark("main");
+}
+
+void StartupProfiler::mark(const char *phase) {
+    if (!m_timer.isValid() || m_count == MAX_PHASES) {
+        return;
+    }
+    m_phases[m_count].name = phase;
+    m_phases[m_count].elapsedNs = m_timer.nsecsElapsed();
+    ++m_count;
+}
+
+void StartupProfiler::report() {
+    if (!m_enabled || m_reported) {
+        return;
+    }
+    m_reported = true;
+
+    qint64 previous = 0;
+    for (int i = 0; i < m_count; ++i) {
+        const Phase &phase = m_phases[i];
+        std::fprintf(stderr, "[startup] %9.3f ms  (+%8.3f ms)  %s\n",
+                     phase.elapsedNs / 1e6, (phase.elapsedNs - previous) / 1e6, phase.name);
+        previous = phase.elapsedNs;
+    }
+}
+
+} // namespace Calculator
@@ -0,0 +1,245 @@
+/**
+ * @file TraceRecorder.cpp
+ * @brief 事件追踪实现
+ */
+
+#include "../../inc/utils/TraceRecorder.h"
+#include <QSaveFile>
+#include <chrono>
+
+namespace Calculator {
+
+const int TraceRecorder::DEFAULT_CAPACITY;
+const int TraceRecorder::MAX_OPEN_INPUTS;
+
+std::atomic<bool> TraceRecorder::s_enabled(false);
+
+namespace {
+
+const char INPUT_EVENT_NAME[] = "input-to-paint";
+const char INPUT_CATEGORY[] = "input";
+
+qint64 steadyNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// 纳秒转为 Chrome trace 使用的微秒（保留三位小数）
+void appendMicroseconds(QByteArray &out, qint64 ns) {
+    out += QByteArray::number(ns / 1000);
+    out += '.';
+    const int fraction = static_cast<int>(ns % 1000);
+    out += static_cast<char>('0' + fraction / 100);
+    out += static_cast<char>('0' + fraction / 10 % 10);
+    out += static_cast<char>('0' + fraction % 10);
+}
+
+// 事件名来自源码中的常量，只需转义引号与反斜杠
+void appendJsonString(QByteArray &out, const char *text) {
+    out += '"';
+    for (const char *p = text; *p; ++p) {
+        if (*p == '"' || *p == '\\') {
+            out += '\\';
+        }
+        out += *p;
+    }
+    out += '"';
+}
+
+} // namespace
+
+TraceRecorder &TraceRecorder::instance() {
+    static TraceRecorder recorder;
+    return recorder;
+}
+
+TraceRecorder::TraceRecorder()
+    : m_mask(0)
+    , m_next(0)
+    , m_origin(0)
+    , m_nextInput(0)
+    , m_firstOpenInput(0)
+    , m_paintPending(false)
+{
+}
+
+void TraceRecorder::enable(int capacity) {
+    if (!m_events) {
+        quint64 size = 1;
+        while (size < static_cast<quint64>(capacity)) {
+            size <<= 1;
+        }
+        m_events.reset(new Event[size]);
+        for (quint64 i = 0; i < size; ++i) {
+            m_events[i].sequence.store(0, std::memory_order_relaxed);
+        }
+        m_mask = size - 1;
+        m_origin.store(steadyNs(), std::memory_order_relaxed);
+    }
+    s_enabled.store(true, std::memory_order_release);
+}
+
+void TraceRecorder::disable() {
+    s_enabled.store(false, std::memory_order_release);
+}
+
+qint64 TraceRecorder::now() const {
+    return steadyNs() - m_origin.load(std::memory_order_relaxed);
+}
+
+quint32 TraceRecorder::threadIndex() {
+    static std::atomic<quint32> nextThread(1);
+    thread_local quint32 index = nextThread.fetch_add(1, std::memory_order_relaxed);
+    return index;
+}
+
+void TraceRecorder::record(Phase phase, const char *category, const char *name,
+                           qint64 start, qint64 duration, quint64 id) {
+    if (!isEnabled()) {
+        return;
+    }
+    const quint64 index = m_next.fetch_add(1, std::memory_order_relaxed);
+    Event &event = m_events[index & m_mask];
+
+    // 序列号先置 0，导出时跳过正在写入的槽
+    event.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    event.category.store(category, std::memory_order_relaxed);
+    event.name.store(name, std::memory_order_relaxed);
+    event.start.store(start, std::memory_order_relaxed);
+    event.duration.store(duration, std::memory_order_relaxed);
+    event.id.store(id, std::memory_order_relaxed);
+    event.thread.store(threadIndex(), std::memory_order_relaxed);
+    event.phase.store(phase, std::memory_order_relaxed);
+    event.sequence.store(index + 1, std::memory_order_release);
+}
+
+void TraceRecorder::complete(const char *category, const char *name, qint64 startNs, qint64 durationNs) {
+    record(Complete, category, name, startNs, durationNs, 0);
+}
+
+void TraceRecorder::instant(const char *category, const char *name) {
+    if (isEnabled()) {
+        record(Instant, category, name, now(), 0, 0);
+    }
+}
+
+void TraceRecorder::beginInput(const char *name) {
+    if (isEnabled()) {
+        const quint64 id = m_nextInput.fetch_add(1, std::memory_order_relaxed);
+        record(AsyncBegin, INPUT_CATEGORY, name, now(), 0, id);
+    }
+}
+
+void TraceRecorder::endInputs() {
+    if (!isEnabled()) {
+        return;
+    }
+    m_paintPending.store(false, std::memory_order_relaxed);
+    const quint64 last = m_nextInput.load(std::memory_order_relaxed);
+    quint64 first = m_firstOpenInput.exchange(last, std::memory_order_relaxed);
+    if (first >= last) {
+        return;
+    }
+    // 长时间没有重绘时只结束最近的输入，其余的在时间线上保持未结束
+    if (last - first > static_cast<quint64>(MAX_OPEN_INPUTS)) {
+        first = last - MAX_OPEN_INPUTS;
+    }
+    const qint64 timestamp = now();
+    for (quint64 id = first; id < last; ++id) {
+        record(AsyncEnd, INPUT_CATEGORY, INPUT_EVENT_NAME, timestamp, 0, id);
+    }
+}
+
+void TraceRecorder::markPaintPending() {
+    if (isEnabled()) {
+        m_paintPending.store(true, std::memory_order_relaxed);
+    }
+}
+
+void TraceRecorder::endIdleInputs() {
+    if (isEnabled() && !m_paintPending.load(std::memory_order_relaxed)) {
+        endInputs();
+    }
+}
+
+QByteArray TraceRecorder::toChromeTraceJson() const {
+    QByteArray json;
+    json += "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+    if (!m_events) {
+        json += "]}\n";
+        return json;
+    }
+
+    const quint64 end = m_next.load(std::memory_order_acquire);
+    const quint64 capacity = m_mask + 1;
+    const quint64 begin = end > capacity ? end - capacity : 0;
+    json.reserve(static_cast<int>((end - begin) * 120));
+
+    bool first = true;
+    for (quint64 index = begin; index < end; ++index) {
+        const Event &event = m_events[index & m_mask];
+        const quint64 sequence = event.sequence.load(std::memory_order_acquire);
+        if (sequence != index + 1) {
+            continue;   // 正在写入或已被覆盖
+        }
+        const char phase = static_cast<char>(event.phase.load(std::memory_order_relaxed));
+        const char *category = event.category.load(std::memory_order_relaxed);
+        const char *name = event.name.load(std::memory_order_relaxed);
+        const qint64 start = event.start.load(std::memory_order_relaxed);
+        const qint64 duration = event.duration.load(std::memory_order_relaxed);
+        const quint64 id = event.id.load(std::memory_order_relaxed);
+        const quint32 thread = event.thread.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (event.sequence.load(std::memory_order_relaxed) != sequence) {
+            continue;
+        }
+
+        json += first ? "\n" : ",\n";
+        first = false;
+        json += "{\"ph\":\"";
+        json += phase;
+        json += "\",\"cat\":";
+        appendJsonString(json, category);
+        json += ",\"name\":";
+        // 异步输入事件统一命名以便首尾配对，输入来源放在 args 中
+        appendJsonString(json, phase == AsyncBegin || phase == AsyncEnd ? INPUT_EVENT_NAME : name);
+        json += ",\"pid\":1,\"tid\":";
+        json += QByteArray::number(thread);
+        json += ",\"ts\":";
+        appendMicroseconds(json, start);
+        if (phase == Complete) {
+            json += ",\"dur\":";
+            appendMicroseconds(json, duration);
+        } else if (phase == Instant) {
+            json += ",\"s\":\"t\"";
+        } else {
+            json += ",\"id\":\"0x";
+            json += QByteArray::number(id, 16);
+            json += '"';
+            if (phase == AsyncBegin) {
+                json += ",\"args\":{\"source\":";
+                appendJsonString(json, name);
+                json += '}';
+            }
+        }
+        json += '}';
+    }
+    json += "\n]}\n";
+    return json;
+}
+
+bool TraceRecorder::writeChromeTrace(const QString &path) const {
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    const QByteArray json = toChromeTraceJson();
+    if (file.write(json) != json.size()) {
+        file.cancelWriting();
+        return false;
+    }
+    return file.commit();
+}
+
+} // namespace Calculator
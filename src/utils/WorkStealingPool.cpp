@@ -0,0 +1,158 @@
+/**
+ * @file WorkStealingPool.cpp
+ * @brief 任务窃取线程池实现
+ */
+
+#include "../../inc/utils/WorkStealingPool.h"
+#include <chrono>
+
+namespace Calculator {
+
+namespace {
+
+int resolveThreadCount(int threadCount) {
+    if (threadCount > 0) {
+        return threadCount;
+    }
+    const int hardware = static_cast<int>(std::thread::hardware_concurrency());
+    return hardware > 0 ? hardware : 1;
+}
+
+} // namespace
+
+WorkStealingPool::WorkStealingPool(int threadCount)
+    : m_ranges(resolveThreadCount(threadCount))
+    , m_stats(m_ranges.size())
+    , m_function(nullptr)
+    , m_generation(0)
+    , m_activeWorkers(0)
+    , m_stopping(false)
+{
+    const int workers = static_cast<int>(m_ranges.size());
+    m_threads.reserve(workers);
+    for (int i = 0; i < workers; ++i) {
+        m_threads.push_back(std::thread(&WorkStealingPool::workerLoop, this, i));
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_startCondition.notify_all();
+    for (std::size_t i = 0; i < m_threads.size(); ++i) {
+        m_threads[i].join();
+    }
+}
+
+void WorkStealingPool::run(std::size_t taskCount, const TaskFunction &function) {
+    const std::size_t workers = m_threads.size();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    // 按区间平均分配任务
+    for (std::size_t i = 0; i < workers; ++i) {
+        std::lock_guard<std::mutex> rangeLock(m_ranges[i].mutex);
+        m_ranges[i].begin = taskCount * i / workers;
+        m_ranges[i].end = taskCount * (i + 1) / workers;
+        WorkerStats empty = { 0, 0, 0 };
+        m_stats[i] = empty;
+    }
+
+    m_function = &function;
+    m_activeWorkers = static_cast<int>(workers);
+    ++m_generation;
+    m_startCondition.notify_all();
+
+    m_doneCondition.wait(lock, [this] { return m_activeWorkers == 0; });
+    m_function = nullptr;
+}
+
+void WorkStealingPool::workerLoop(int worker) {
+    std::uint64_t seenGeneration = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_startCondition.wait(lock, [this, seenGeneration] {
+                return m_stopping || m_generation != seenGeneration;
+            });
+            if (m_stopping) {
+                return;
+            }
+            seenGeneration = m_generation;
+        }
+
+        execute(worker);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (--m_activeWorkers == 0) {
+            m_doneCondition.notify_all();
+        }
+    }
+}
+
+void WorkStealingPool::execute(int worker) {
+    const TaskFunction &function = *m_function;
+    WorkerStats &stats = m_stats[worker];
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    std::size_t task = 0;
+    for (;;) {
+        if (popLocal(worker, task)) {
+            function(worker, task);
+            ++stats.tasks;
+        } else if (steal(worker, task)) {
+            function(worker, task);
+            ++stats.tasks;
+            ++stats.steals;
+        } else {
+            break;  // 所有区间都已取空
+        }
+    }
+
+    stats.busyNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+bool WorkStealingPool::popLocal(int worker, std::size_t &task) {
+    TaskRange &range = m_ranges[worker];
+    std::lock_guard<std::mutex> lock(range.mutex);
+    if (range.begin >= range.end) {
+        return false;
+    }
+    task = range.begin++;
+    return true;
+}
+
+bool WorkStealingPool::steal(int worker, std::size_t &task) {
+    const int workers = static_cast<int>(m_ranges.size());
+    for (int offset = 1; offset < workers; ++offset) {
+        TaskRange &victim = m_ranges[(worker + offset) % workers];
+        std::size_t begin = 0;
+        std::size_t end = 0;
+        {
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (victim.begin >= victim.end) {
+                continue;
+            }
+            const std::size_t remaining = victim.end - victim.begin;
+            // 取走尾部一半（至少一个）
+            end = victim.end;
+            begin = victim.end - (remaining + 1) / 2;
+            victim.end = begin;
+        }
+
+        task = begin;
+        if (begin + 1 < end) {
+            TaskRange &own = m_ranges[worker];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            own.begin = begin + 1;
+            own.end = end;
+        }
+        return true;
+    }
+    return false;
+}
+
+} // namespace Calculator
@@ -0,0 +1,24 @@
+# 界面主题：构建时把 styles/*.qss 编译为 C++ 主题表（GeneratedThemes.h），运行时不解析样式表
+# 第一个样式表为默认主题；可用 qmake PYTHON=python 指定解释器
+
+THEME_STYLESHEETS = \
+    $$PWD/styles/default.qss \
+    $$PWD/styles/dark.qss
+
+isEmpty(PYTHON): PYTHON = python3
+
+qss2theme.name = qss2theme ${QMAKE_FILE_IN}
+qss2theme.input = THEME_STYLESHEETS
+qss2theme.output = $$OUT_PWD/generated/GeneratedThemes.h
+qss2theme.commands = $$PYTHON $$PWD/tools/qss2theme.py -o ${QMAKE_FILE_OUT} ${QMAKE_FILE_IN}
+qss2theme.depends = $$PWD/tools/qss2theme.py
+qss2theme.CONFIG += combine target_predeps no_link
+QMAKE_EXTRA_COMPILERS += qss2theme
+
+INCLUDEPATH += $$OUT_PWD/generated
+
+SOURCES += \
+    $$PWD/src/ui/Theme.cpp
+
+HEADERS += \
+    $$PWD/inc/ui/Theme.h
@@ -0,0 +1,344 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+把 styles/*.qss 编译为 C++ 主题表（ThemeData 数组）。
+
+构建时由 themes.pri 调用，运行时不再解析任何样式表：
+    qss2theme.py -o GeneratedThemes.h styles/default.qss styles/dark.qss
+
+只识别计算器界面用到的选择器与属性：
+    QMainWindow、#centralWidget、DisplayPanel / #displayPanel（:focus、[errorState="true"]）、
+    NumPadButton[buttonType="..."]、QPushButton 以及按文本区分的 QPushButton[text="..."]，
+    状态 :hover、:pressed；属性 background(-color)、border、border-color、border-radius、
+    color、font-size、font-weight。
+颜色可以是 #rgb/#rrggbb、颜色名、palette(角色) 或 qlineargradient（取首尾两个色标）。
+无法识别的选择器会输出警告并忽略，其余规则按出现顺序层叠。
+"""
+
+import argparse
+import os
+import re
+import sys
+
+BUTTON_TYPES = ["number", "operator", "equals", "function", "decimal"]
+
+BUTTON_TEXT_TYPES = {
+    "+": "operator", "-": "operator", "×": "operator", "÷": "operator",
+    "=": "equals",
+    "C": "function", "CE": "function", "⌫": "function",
+    ".": "decimal",
+}
+
+PALETTE_ROLES = {
+    "window": "Window",
+    "window-text": "WindowText",
+    "base": "Base",
+    "alternate-base": "AlternateBase",
+    "text": "Text",
+    "button": "Button",
+    "button-text": "ButtonText",
+    "bright-text": "BrightText",
+    "light": "Light",
+    "midlight": "Midlight",
+    "mid": "Mid",
+    "dark": "Dark",
+    "shadow": "Shadow",
+    "highlight": "Highlight",
+    "highlighted-text": "HighlightedText",
+}
+
+NAMED_COLORS = {
+    "white": 0xffffff,
+    "black": 0x000000,
+    "red": 0xff0000,
+    "transparent": None,
+}
+
+STATES = ["normal", "hover", "pressed"]
+
+
+class ThemeError(Exception):
+    pass
+
+
+def strip_comments(text):
+    return re.sub(r"/\*.*?\*/", "", text, flags=re.S)
+
+
+def parse_rules(text):
+    """返回 [(选择器列表, [(属性, 值)])]，保持出现顺序。"""
+    rules = []
+    for match in re.finditer(r"([^{}]+)\{([^{}]*)\}", strip_comments(text)):
+        selectors = [s.strip() for s in match.group(1).split(",") if s.strip()]
+        declarations = []
+        for item in match.group(2).split(";"):
+            if ":" not in item:
+                continue
+            name, value = item.split(":", 1)
+            declarations.append((name.strip().lower(), " ".join(value.split())))
+        rules.append((selectors, declarations))
+    return rules
+
+
+def parse_color(value):
+    """返回 (角色名或 None, 起点 rgb, 终点 rgb)；无法识别时返回 None。"""
+    value = value.strip()
+    match = re.match(r"palette\(\s*([a-z-]+)\s*\)$", value)
+    if match:
+        role = PALETTE_ROLES.get(match.group(1))
+        if role is None:
+            raise ThemeError("未知的调色板角色: %s" % match.group(1))
+        return (role, 0, 0)
+    if value.startswith("qlineargradient"):
+        stops = re.findall(r"stop\s*:\s*[0-9.]+\s+(#[0-9a-fA-F]{3,6})", value)
+        if not stops:
+            raise ThemeError("渐变缺少色标: %s" % value)
+        return (None, parse_hex(stops[0]), parse_hex(stops[-1]))
+    if value.startswith("#"):
+        rgb = parse_hex(value)
+        return (None, rgb, rgb)
+    if value.lower() in NAMED_COLORS:
+        rgb = NAMED_COLORS[value.lower()]
+        if rgb is None:
+            return None
+        return (None, rgb, rgb)
+    return None
+
+
+def parse_hex(value):
+    digits = value[1:]
+    if len(digits) == 3:
+        digits = "".join(c * 2 for c in digits)
+    if len(digits) != 6:
+        raise ThemeError("无法识别的颜色: %s" % value)
+    return int(digits, 16)
+
+
+def parse_pixels(value):
+    match = re.match(r"(\d+)\s*px$", value)
+    if not match:
+        raise ThemeError("只支持 px 单位: %s" % value)
+    return int(match.group(1))
+
+
+def parse_weight(value):
+    names = {"normal": 400, "bold": 700}
+    if value in names:
+        return names[value]
+    if not value.isdigit():
+        raise ThemeError("无法识别的字重: %s" % value)
+    return int(value)
+
+
+def classify(selector):
+    """把选择器映射为 [(目标, 状态)]，目标为 window/central/panel/按钮类型。"""
+    state = "normal"
+    for suffix, name in ((":hover", "hover"), (":pressed", "pressed"),
+                         (":focus", "focus"), ('[errorState="true"]', "error")):
+        if selector.endswith(suffix):
+            state = name
+            selector = selector[:-len(suffix)]
+            break
+    if selector.endswith(":disabled"):
+        return []
+
+    if selector == "QMainWindow":
+        return [("window", state)]
+    if selector.endswith("#centralWidget"):
+        return [("central", state)]
+    if selector in ("DisplayPanel", "#displayPanel"):
+        return [("panel", state)]
+
+    match = re.match(r'NumPadButton\[buttonType="(\w+)"\]$', selector)
+    if match and match.group(1) in BUTTON_TYPES:
+        return [(match.group(1), state)]
+    match = re.match(r'QPushButton\[text="(.+)"\]$', selector)
+    if match and match.group(1) in BUTTON_TEXT_TYPES:
+        return [(BUTTON_TEXT_TYPES[match.group(1)], state)]
+    if selector == "QPushButton":
+        return [(t, state) for t in BUTTON_TYPES]
+    if selector == "QPushButton:!operator:!equals:!function":
+        return [("number", state), ("decimal", state)]
+    return None
+
+
+def apply_declarations(target, declarations):
+    for name, value in declarations:
+        if name in ("background", "background-color"):
+            color = parse_color(value)
+            if color is not None:
+                target["background"] = color
+        elif name == "border":
+            for part in value.split():
+                color = parse_color(part)
+                if color is not None:
+                    target["border"] = color
+        elif name == "border-color":
+            target["border"] = parse_color(value)
+        elif name == "border-radius":
+            target["radius"] = parse_pixels(value)
+        elif name == "color":
+            target["text"] = parse_color(value)
+        elif name == "font-size":
+            target["font-size"] = parse_pixels(value)
+        elif name == "font-weight":
+            target["font-weight"] = parse_weight(value)
+
+
+def compile_theme(path):
+    with open(path, encoding="utf-8") as source:
+        rules = parse_rules(source.read())
+
+    styles = {}
+    for selectors, declarations in rules:
+        for selector in selectors:
+            targets = classify(selector)
+            if targets is None:
+                sys.stderr.write("%s: 忽略无法识别的选择器 %s\n" % (path, selector))
+                continue
+            for key in targets:
+                apply_declarations(styles.setdefault(key, {}), declarations)
+
+    def style(target, state):
+        # 状态样式在常态样式之上层叠
+        merged = dict(styles.get((target, "normal"), {}))
+        if state != "normal":
+            merged.update(styles.get((target, state), {}))
+        return merged
+
+    def require(values, key, context):
+        if key not in values:
+            raise ThemeError("%s: %s 缺少属性 %s" % (path, context, key))
+        return values[key]
+
+    window = style("window", "normal")
+    central = style("central", "normal")
+    panel = style("panel", "normal")
+    theme = {
+        "name": os.path.splitext(os.path.basename(path))[0],
+        "windowBackground": require(window, "background", "QMainWindow"),
+        "windowText": require(window, "text", "QMainWindow"),
+        "centralBackground": central.get("background", window["background"]),
+        "panel": [require(panel, key, "显示面板") for key in ("background", "border", "text")],
+        "panelFocusBorder": style("panel", "focus").get("border", panel["border"]),
+        "panelErrorText": require(style("panel", "error"), "text", "显示面板错误状态"),
+        "panelRadius": panel.get("radius", 0),
+        "panelFontSize": require(panel, "font-size", "显示面板"),
+        "buttons": [],
+    }
+    for button in BUTTON_TYPES:
+        # 未单独定义的小数点按钮沿用数字按钮样式
+        source = button if (button, "normal") in styles else "number"
+        states = []
+        for state in STATES:
+            values = style(source, state)
+            context = "%s 按钮 (%s)" % (source, state)
+            states.append([require(values, key, context) for key in ("background", "border", "text")])
+        normal = style(source, "normal")
+        theme["buttons"].append({
+            "type": button,
+            "states": states,
+            "radius": normal.get("radius", 0),
+            "font-size": require(normal, "font-size", "%s 按钮" % source),
+            "font-weight": normal.get("font-weight", 400),
+        })
+    return theme
+
+
+def color_literal(color):
+    role, top, bottom = color
+    if role is not None:
+        return "{ QPalette::%s, 0, 0 }" % role
+    return "{ QPalette::NoRole, 0xff%06xu, 0xff%06xu }" % (top, bottom)
+
+
+def box_literal(colors, indent):
+    return ("{\n" + ",\n".join(indent + "    " + color_literal(c) for c in colors)
+            + "\n" + indent + "}")
+
+
+def render(themes, sources):
+    lines = [
+        "/**",
+        " * @file GeneratedThemes.h",
+        " * @brief 由 tools/qss2theme.py 根据样式表生成的主题表，请勿手动修改",
+        " *",
+    ]
+    for source in sources:
+        lines.append(" * 来源: %s" % source.replace("\\", "/"))
+    lines += [
+        " */",
+        "",
+        "#ifndef GENERATEDTHEMES_H",
+        "#define GENERATEDTHEMES_H",
+        "",
+        '#include "ui/Theme.h"',
+        "",
+        "namespace Calculator {",
+        "namespace GeneratedThemes {",
+        "",
+        "const int THEME_COUNT = %d;" % len(themes),
+        "",
+        "const ThemeData THEMES[THEME_COUNT] = {",
+    ]
+    for theme in themes:
+        lines.append("    {")
+        lines.append('        "%s",' % theme["name"])
+        lines.append("        %s," % color_literal(theme["windowBackground"]))
+        lines.append("        %s," % color_literal(theme["windowText"]))
+        lines.append("        %s," % color_literal(theme["centralBackground"]))
+        lines.append("        %s," % box_literal(theme["panel"], "        "))
+        lines.append("        %s," % color_literal(theme["panelFocusBorder"]))
+        lines.append("        %s," % color_literal(theme["panelErrorText"]))
+        lines.append("        %d," % theme["panelRadius"])
+        lines.append("        %d," % theme["panelFontSize"])
+        lines.append("        {")
+        for button in theme["buttons"]:
+            lines.append("            // %s" % button["type"])
+            lines.append("            {")
+            for colors in button["states"]:
+                lines.append("                %s," % box_literal(colors, "                "))
+            lines.append("                %d, %d, %d" % (button["radius"], button["font-size"],
+                                                      button["font-weight"]))
+            lines.append("            },")
+        lines.append("        }")
+        lines.append("    },")
+    lines += [
+        "};",
+        "",
+        "} // namespace GeneratedThemes",
+        "} // namespace Calculator",
+        "",
+        "#endif // GENERATEDTHEMES_H",
+        "",
+    ]
+    return "\n".join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="把 qss 样式表编译为 C++ 主题表")
+    parser.add_argument("-o", "--output", required=True, help="输出的头文件")
+    parser.add_argument("sources", nargs="+", help="qss 样式表（第一个为默认主题）")
+    args = parser.parse_args()
+
+    try:
+        themes = [compile_theme(path) for path in args.sources]
+    except (ThemeError, OSError) as error:
+        sys.stderr.write("qss2theme: %s\n" % error)
+        return 1
+
+    sources = [os.path.relpath(path, os.path.dirname(os.path.abspath(__file__)) + "/..")
+               for path in args.sources]
+    text = render(themes, sources)
+    # 内容不变时不改写，避免触发无谓的重新编译
+    if os.path.exists(args.output):
+        with open(args.output, encoding="utf-8") as existing:
+            if existing.read() == text:
+                return 0
+    with open(args.output, "w", encoding="utf-8") as output:
+        output.write(text)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())